@@ -0,0 +1,38 @@
+#include "aleatorio.h"
+
+// splitmix64: sementes vizinhas viram estados sem relação aparente
+static uint64_t splitmix64(uint64_t *x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+void aleatorioSemear(aleatorio_t *g, uint32_t semente) {
+    uint64_t x = semente;
+    uint64_t a = splitmix64(&x);
+    uint64_t b = splitmix64(&x);
+    g->s[0] = (uint32_t)a;
+    g->s[1] = (uint32_t)(a >> 32);
+    g->s[2] = (uint32_t)b;
+    g->s[3] = (uint32_t)(b >> 32);
+    if ((g->s[0] | g->s[1] | g->s[2] | g->s[3]) == 0) // Estado proibido
+        g->s[0] = 1;
+}
+
+// Rejeição pela máscara da próxima potência de 2: no máximo 2 tentativas em média, sem divisão
+uint32_t aleatorioFaixa(aleatorio_t *g, uint32_t n) {
+    if (n <= 1)
+        return 0;
+    uint32_t mascara = UINT32_MAX >> __builtin_clz(n - 1);
+    uint32_t v;
+    do {
+        v = aleatorioProximo(g) & mascara;
+    } while (v >= n);
+    return v;
+}
+
+void aleatorioPreencher(aleatorio_t *g, uint32_t *destino, uint32_t n) {
+    for (uint32_t i = 0; i < n; ++i)
+        destino[i] = aleatorioProximo(g);
+}
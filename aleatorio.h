@@ -0,0 +1,36 @@
+#ifndef ALEATORIO_H
+#define ALEATORIO_H
+
+// Gerador pseudoaleatório xoshiro128** (Blackman e Vigna): 128 bits de estado, só operações de
+// 32 bits (o Cortex-M0+ não tem multiplicação de 64 bits) e período 2^128 - 1. A mesma semente
+// gera sempre a mesma sequência, no Pico e no simulador.
+
+#include <stdint.h>
+
+typedef struct {
+    uint32_t s[4]; // Estado; nunca todo zero
+} aleatorio_t;
+
+void aleatorioSemear(aleatorio_t *g, uint32_t semente); // Espalha a semente pelo estado (splitmix64)
+uint32_t aleatorioFaixa(aleatorio_t *g, uint32_t n);    // Inteiro uniforme em [0, n), sem viés de módulo
+void aleatorioPreencher(aleatorio_t *g, uint32_t *destino, uint32_t n); // n palavras de uma vez
+
+static inline uint32_t aleatorioRotacao(uint32_t x, int k) {
+    return (x << k) | (x >> (32 - k));
+}
+
+// Próximos 32 bits
+static inline uint32_t aleatorioProximo(aleatorio_t *g) {
+    uint32_t *s = g->s;
+    uint32_t resultado = aleatorioRotacao(s[1] * 5, 7) * 9;
+    uint32_t t = s[1] << 9;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = aleatorioRotacao(s[3], 11);
+    return resultado;
+}
+
+#endif
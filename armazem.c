@@ -0,0 +1,280 @@
+#include <string.h>
+#include "hal.h"
+#include "protocolo.h" // protocoloCrc
+#include "armazem.h"
+
+#define SETOR HAL_FLASH_SETOR
+#define PAGINA HAL_FLASH_PAGINA
+#define SETORES HAL_FLASH_SETORES
+#define MAGICA 0x4D41          // "AM": setor do armazém
+#define CABECALHO_SETOR 8      // setorCabecalho_t
+#define CABECALHO 4            // chave, tamanho e CRC de cada registro
+#define LIVRE 0xFF             // Byte apagado: não há registro aqui
+#define REGISTRO_MAX (CABECALHO + ((ARMAZEM_MAX_VALOR + 3) & ~3u))
+#define POR_PAGINA (PAGINA / REGISTRO_MAX)
+// Páginas para copiar todas as chaves, com a do cabeçalho do setor. Uma compactação interrompida
+// deixa a cópia pela metade no setor novo, e a seguinte copia tudo de novo no mesmo setor.
+#define PAGINAS_COMPACTACAO ((ARMAZEM_CHAVES + POR_PAGINA - 1) / POR_PAGINA + 1)
+
+_Static_assert(REGISTRO_MAX <= PAGINA, "um registro nunca atravessa uma página");
+_Static_assert(2 * PAGINAS_COMPACTACAO + 1 <= SETOR / PAGINA, "duas compactações cabem em um setor");
+_Static_assert(ARMAZEM_CHAVES <= 32, "uma máscara de 32 bits por chave");
+
+typedef struct {
+    uint16_t magica;
+    uint16_t crc;      // CRC de magica e geracao
+    uint32_t geracao;  // Ordem do setor no log (o maior é o que está sendo escrito)
+} setorCabecalho_t;
+
+_Static_assert(sizeof(setorCabecalho_t) == CABECALHO_SETOR, "cabeçalho do setor na flash");
+
+typedef enum {
+    SETOR_LIMPO, // Apagado, pronto para ser aberto
+    SETOR_SUJO,  // Sem cabeçalho válido e com lixo (apagamento interrompido): apagar antes de usar
+    SETOR_VIVO,  // Parte do log
+} estadoSetor_t;
+
+static struct {
+    uint8_t estado[SETORES];
+    uint32_t geracao[SETORES];
+    uint8_t valores[ARMAZEM_CHAVES][ARMAZEM_MAX_VALOR];
+    uint8_t tamanhos[ARMAZEM_CHAVES];
+    int8_t setor_de[ARMAZEM_CHAVES]; // Setor com o último registro da chave (-1 = nenhum)
+    uint32_t existentes;             // Bit = chave com valor
+    uint32_t pendentes;              // Bit = valor ainda não gravado
+    int cabeca;                      // Setor sendo escrito (-1 = log vazio)
+    uint32_t posicao;                // Próximo byte livre na cabeça
+    uint8_t pagina[PAGINA];          // Página da posição, com 0xFF onde nada muda
+    bool pagina_suja;
+    armazemEstatisticas_t estatisticas;
+} a;
+
+static uint16_t cabecalhoCrc(const setorCabecalho_t *c) {
+    uint16_t crc = protocoloCrc(0xFFFF, (const uint8_t *)&c->magica, sizeof(c->magica));
+    return protocoloCrc(crc, (const uint8_t *)&c->geracao, sizeof(c->geracao));
+}
+
+static uint16_t registroCrc(uint8_t chave, uint8_t tamanho, const uint8_t *valor) {
+    const uint8_t cabecalho[2] = { chave, tamanho };
+    return protocoloCrc(protocoloCrc(0xFFFF, cabecalho, 2), valor, tamanho);
+}
+
+static uint32_t registroTamanho(uint32_t tamanho) {
+    return CABECALHO + ((tamanho + 3) & ~3u);
+}
+
+static const uint8_t *setorDados(uint s) {
+    return halFlashDados() + s * SETOR;
+}
+
+static uint livres(void) {
+    uint n = 0;
+    for (uint s = 0; s < SETORES; ++s)
+        n += a.estado[s] != SETOR_VIVO;
+    return n;
+}
+
+// Montagem --------------------------------------------------------------------------------------
+
+// Registros válidos de um setor, na ordem; devolve onde termina o último
+static uint32_t lerSetor(uint s) {
+    const uint8_t *dados = setorDados(s);
+    uint32_t fim = CABECALHO_SETOR;
+    for (uint32_t pagina = 0; pagina < SETOR; pagina += PAGINA) {
+        uint32_t p = pagina ? pagina : CABECALHO_SETOR;
+        while (p + CABECALHO <= pagina + PAGINA && dados[p] != LIVRE) { // O resto da página está livre
+            uint8_t chave = dados[p], tamanho = dados[p + 1];
+            uint16_t crc = dados[p + 2] | (uint16_t)(dados[p + 3] << 8);
+            if (chave >= ARMAZEM_CHAVES || tamanho > ARMAZEM_MAX_VALOR || p + registroTamanho(tamanho) > pagina + PAGINA ||
+                registroCrc(chave, tamanho, dados + p + CABECALHO) != crc) {
+                a.estatisticas.invalidos++; // Gravação interrompida: o resto da página não vale
+                break;
+            }
+            memcpy(a.valores[chave], dados + p + CABECALHO, tamanho);
+            a.tamanhos[chave] = tamanho;
+            a.setor_de[chave] = (int8_t)s;
+            a.existentes |= 1u << chave;
+            p += registroTamanho(tamanho);
+            fim = p;
+        }
+    }
+    return fim;
+}
+
+void armazemInit() {
+    memset(&a, 0, sizeof(a));
+    memset(a.setor_de, -1, sizeof(a.setor_de));
+    memset(a.pagina, LIVRE, sizeof(a.pagina));
+    a.cabeca = -1;
+
+    uint ordem[SETORES], vivos = 0;
+    for (uint s = 0; s < SETORES; ++s) {
+        const uint8_t *dados = setorDados(s);
+        setorCabecalho_t c;
+        memcpy(&c, dados, sizeof(c));
+        if (c.magica == MAGICA && c.crc == cabecalhoCrc(&c)) {
+            a.estado[s] = SETOR_VIVO;
+            a.geracao[s] = c.geracao;
+            uint i = vivos++; // Inserção ordenada pela geração
+            for (; i > 0 && a.geracao[ordem[i - 1]] > c.geracao; --i)
+                ordem[i] = ordem[i - 1];
+            ordem[i] = s;
+            continue;
+        }
+        a.estado[s] = SETOR_LIMPO;
+        for (uint32_t i = 0; i < SETOR; ++i) {
+            if (dados[i] != LIVRE) {
+                a.estado[s] = SETOR_SUJO;
+                a.estatisticas.invalidos++;
+                break;
+            }
+        }
+    }
+
+    // Do mais antigo ao mais novo: o último registro de cada chave vence
+    uint32_t fim = 0;
+    for (uint i = 0; i < vivos; ++i)
+        fim = lerSetor(ordem[i]);
+    if (vivos == 0)
+        return;
+    a.cabeca = (int)ordem[vivos - 1];
+    // Nada é gravado sobre bytes já programados: depois de lixo no fim da cabeça, só na página seguinte
+    const uint8_t *dados = setorDados((uint)a.cabeca);
+    uint32_t ultimo = SETOR;
+    while (ultimo > fim && dados[ultimo - 1] == LIVRE)
+        --ultimo;
+    a.posicao = ultimo > fim ? (ultimo + PAGINA - 1) / PAGINA * PAGINA : fim;
+}
+
+// Escrita ---------------------------------------------------------------------------------------
+
+static void descarregarPagina(void) {
+    if (!a.pagina_suja)
+        return;
+    uint32_t inicio = (a.posicao - 1) / PAGINA * PAGINA; // A página do último byte escrito
+    halFlashGravar((uint32_t)a.cabeca * SETOR + inicio, a.pagina);
+    memset(a.pagina, LIVRE, sizeof(a.pagina));
+    a.pagina_suja = false;
+    a.estatisticas.paginas++;
+}
+
+static void anexar(uint8_t chave);
+
+// Esvazia o setor mais antigo: as chaves cujo último registro está nele são regravadas na cabeça
+// (pendentes ou não) e só depois ele é apagado
+static void compactar(void) {
+    int cauda = -1;
+    for (uint s = 0; s < SETORES; ++s)
+        if (a.estado[s] == SETOR_VIVO && (int)s != a.cabeca && (cauda < 0 || a.geracao[s] < a.geracao[cauda]))
+            cauda = (int)s;
+    if (cauda < 0)
+        return;
+    for (uint8_t k = 0; k < ARMAZEM_CHAVES; ++k) {
+        if (a.setor_de[k] == cauda) {
+            anexar(k);
+            a.pendentes &= ~(1u << k);
+        }
+    }
+    descarregarPagina();
+    halFlashApagar((uint)cauda);
+    a.estado[cauda] = SETOR_LIMPO;
+    a.estatisticas.apagamentos++;
+    a.estatisticas.compactacoes++;
+}
+
+// O próximo setor livre do anel vira a cabeça; se era o último livre, a cauda é compactada nele
+static void abrirSetor(void) {
+    uint32_t geracao = 0;
+    for (uint s = 0; s < SETORES; ++s)
+        if (a.estado[s] == SETOR_VIVO && a.geracao[s] >= geracao)
+            geracao = a.geracao[s] + 1;
+    uint s = a.cabeca < 0 ? 0 : ((uint)a.cabeca + 1) % SETORES;
+    while (a.estado[s] == SETOR_VIVO) // Há sempre um livre: a compactação roda antes de faltar
+        s = (s + 1) % SETORES;
+    if (a.estado[s] == SETOR_SUJO) {
+        halFlashApagar(s);
+        a.estatisticas.apagamentos++;
+    }
+    setorCabecalho_t c = { .magica = MAGICA, .geracao = geracao };
+    c.crc = cabecalhoCrc(&c);
+    a.cabeca = (int)s;
+    a.estado[s] = SETOR_VIVO;
+    a.geracao[s] = geracao;
+    memcpy(a.pagina, &c, sizeof(c)); // Vai junto com os primeiros registros
+    a.pagina_suja = true;
+    a.posicao = CABECALHO_SETOR;
+    if (livres() == 0)
+        compactar();
+}
+
+// Acrescenta o valor atual da chave ao log
+static void anexar(uint8_t chave) {
+    uint32_t tamanho = registroTamanho(a.tamanhos[chave]);
+    for (;;) {
+        if (a.cabeca >= 0 && a.posicao < SETOR && PAGINA - a.posicao % PAGINA >= tamanho)
+            break;
+        if (a.cabeca >= 0 && a.posicao < SETOR) { // Não cabe no resto da página: vai para a próxima
+            descarregarPagina();
+            a.posicao = (a.posicao / PAGINA + 1) * PAGINA;
+            continue;
+        }
+        descarregarPagina();
+        abrirSetor();
+    }
+    uint8_t *r = a.pagina + a.posicao % PAGINA;
+    uint16_t crc = registroCrc(chave, a.tamanhos[chave], a.valores[chave]);
+    r[0] = chave;
+    r[1] = a.tamanhos[chave];
+    r[2] = (uint8_t)crc;
+    r[3] = (uint8_t)(crc >> 8);
+    memcpy(r + CABECALHO, a.valores[chave], a.tamanhos[chave]);
+    a.pagina_suja = true;
+    a.posicao += tamanho;
+    a.setor_de[chave] = (int8_t)a.cabeca;
+    a.estatisticas.registros++;
+    if (a.posicao % PAGINA == 0) // Página completa
+        descarregarPagina();
+}
+
+// Interface ---------------------------------------------------------------------------------------
+
+bool armazemLer(uint8_t chave, void *valor, uint32_t tamanho) {
+    if (chave >= ARMAZEM_CHAVES || !(a.existentes & (1u << chave)) || a.tamanhos[chave] != tamanho)
+        return false;
+    memcpy(valor, a.valores[chave], tamanho);
+    return true;
+}
+
+bool armazemGravar(uint8_t chave, const void *valor, uint32_t tamanho) {
+    if (chave >= ARMAZEM_CHAVES || tamanho > ARMAZEM_MAX_VALOR)
+        return false;
+    if ((a.existentes & (1u << chave)) && a.tamanhos[chave] == tamanho && memcmp(a.valores[chave], valor, tamanho) == 0)
+        return true; // Nada mudou: nenhum registro
+    memcpy(a.valores[chave], valor, tamanho);
+    a.tamanhos[chave] = (uint8_t)tamanho;
+    a.existentes |= 1u << chave;
+    a.pendentes |= 1u << chave;
+    return true;
+}
+
+bool armazemPendente() {
+    return a.pendentes != 0;
+}
+
+void armazemDescarregar() {
+    if (a.pendentes == 0)
+        return;
+    if (a.cabeca >= 0 && livres() == 0) // Corte no meio de uma compactação: termina antes de tudo
+        compactar();
+    for (uint8_t k = 0; k < ARMAZEM_CHAVES; ++k) {
+        if (a.pendentes & (1u << k)) {
+            a.pendentes &= ~(1u << k);
+            anexar(k);
+        }
+    }
+    descarregarPagina(); // A última página, mesmo incompleta
+}
+
+armazemEstatisticas_t armazemEstatisticas() {
+    return a.estatisticas;
+}
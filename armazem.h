@@ -0,0 +1,40 @@
+#ifndef ARMAZEM_H
+#define ARMAZEM_H
+
+// Armazém chave/valor persistente na flash de dados (hal.h), em forma de log: cada gravação
+// acrescenta um registro [chave, tamanho, crc16, valor] no fim, sem apagar nada. Os setores são
+// usados em rodízio, cada um com um cabeçalho e uma geração crescente; quando só resta um livre,
+// os valores ainda vivos no setor mais antigo são copiados para o fim e ele é apagado. Assim
+// cada setor é apagado uma vez por volta do anel (desgaste nivelado).
+//
+// Um corte de energia no meio de uma gravação deixa, no pior caso, um registro ou uma página
+// inválidos, que o CRC denuncia ao montar: cada chave volta com o valor antigo ou o novo, nunca
+// com uma mistura. Um setor só é apagado depois de as cópias dele estarem gravadas.
+//
+// Os valores ficam todos na RAM: ler não toca a flash, e gravar só marca a chave como pendente.
+// A flash só é apagada e gravada em armazemDescarregar, que o jogo chama fora da partida, quando
+// parar o XIP (e o outro núcleo) por alguns milissegundos não atrasa nada.
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ARMAZEM_CHAVES 16    // Chaves de 0 a ARMAZEM_CHAVES - 1
+#define ARMAZEM_MAX_VALOR 60 // Maior valor em bytes (o registro inteiro cabe em 64)
+
+// Contadores desde armazemInit
+typedef struct {
+    uint32_t registros;    // Registros gravados
+    uint32_t paginas;      // Páginas gravadas
+    uint32_t apagamentos;  // Setores apagados
+    uint32_t compactacoes; // Setores antigos esvaziados
+    uint32_t invalidos;    // Registros ou cabeçalhos inválidos achados ao montar (gravação interrompida)
+} armazemEstatisticas_t;
+
+void armazemInit(void);  // Monta a partir da flash (só leitura): cada chave fica com o último valor válido
+bool armazemLer(uint8_t chave, void *valor, uint32_t tamanho);         // Copia o valor; FALSE se não existe ou tem outro tamanho
+bool armazemGravar(uint8_t chave, const void *valor, uint32_t tamanho); // Novo valor, gravado na flash na próxima descarga
+bool armazemPendente(void);    // Há valores que ainda não estão na flash
+void armazemDescarregar(void); // Leva os pendentes para a flash, página a página (bloqueia a flash)
+armazemEstatisticas_t armazemEstatisticas(void);
+
+#endif
@@ -0,0 +1,207 @@
+// Microbenchmarks dos caminhos quentes do jogo: índice de pixel, desenho de sprites, codificação
+// do quadro, passo do letreiro, geração da sequência e conferência de entradas roteirizadas. O mesmo código roda no
+// Linux (ns) e no Pico (ciclos do SysTick); no Pico, cada byte recebido pelo USB roda uma rodada.
+// Cada benchmark imprime uma linha 'chave=valor' para comparar versões (host/comparar_bench.sh).
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "hal.h"
+#include "neopixel.h"
+#include "sprites.h"
+#include "render.h"
+#include "texto.h"
+#include "sequencia.h"
+#include "aleatorio.h"
+
+#define BENCH_VERSAO 1     // Formato das linhas; muda quando um campo muda de sentido
+#define ITERACOES 20000    // Iterações por benchmark (arredondadas para um múltiplo do lote)
+#define LOTE 64            // Iterações por medida: curto o bastante para os 24 bits de halCiclos
+#define ROTEIRO 1024       // Entradas roteirizadas para a conferência (potência de 2)
+#define PARTIDA_PASSOS 9   // Passos de uma partida normal (MAX_SEQUENCIA do jogo)
+#define SEMENTE 0x4D4D3242 // Fixa: todas as versões medem as mesmas sequências
+#define LETREIRO "4096 R4096" // Placar mais longo do modo sem fim
+
+#ifdef MM_HOST
+#define ALVO "host"
+#define UNIDADE "ns"
+#else
+#define ALVO "pico"
+#define UNIDADE "ciclos"
+#endif
+
+typedef struct {
+    const char *nome;
+    const char *por;             // O que uma iteração faz
+    void (*rodar)(uint32_t i);   // Uma iteração; 'i' varia as entradas
+} bench_t;
+
+// Entrada do jogador roteirizada: acerta quase sempre, erra a cor e a direção de vez em quando
+typedef struct {
+    Direcao direcao;
+    bool cor1;
+} entrada_t;
+
+static volatile uint32_t sumidouro; // Impede que o compilador descarte o trabalho medido
+static aleatorio_t gerador;
+static sequencia_t sequencia;       // Sequência conferida pelo roteiro
+static sequencia_t partida;         // Regerada a cada iteração
+static entrada_t roteiro[ROTEIRO];
+static uint32_t quadro[LED_COUNT];  // Quadro codificado
+static texto_t letreiro;            // Rola sem parar, um passo por iteração
+
+static void benchVazio(uint32_t i) {
+    sumidouro += i; // Custo do laço e da chamada indireta, presente em todos os outros
+}
+
+static void benchIndice(uint32_t i) {
+    uint32_t soma = i;
+    for (int y = 0; y < 5; ++y)
+        for (int x = 0; x < 5; ++x)
+            soma += (uint32_t)getIndex(x, y);
+    sumidouro += soma;
+}
+
+static void benchSprite(uint32_t i) {
+    spriteDesenhar(spritesDigitos[i % 10], 32, 0, 0);
+    sumidouro += leds[i % LED_COUNT].R;
+}
+
+static void benchSpriteEsmaecido(uint32_t i) {
+    const npLED_t azul = { .G = 0, .R = 0, .B = 32 };
+    renderSprite(spritesSetas[i & 3], azul, (uint8_t)i);
+    sumidouro += leds[i % LED_COUNT].B;
+}
+
+static void benchCodificar(uint32_t i) {
+    leds[i % LED_COUNT].G = (uint8_t)i; // Um LED muda por quadro
+    npEncodeFrame(leds, quadro, LED_COUNT);
+    sumidouro += quadro[i % LED_COUNT];
+}
+
+// A mesma codificação na flash e na RAM (HAL_RAM), com o cache do XIP vazio a cada quadro: a
+// diferença é o que os caminhos quentes ganham por rodar da SRAM (no simulador, nenhuma)
+static void __attribute__((noinline)) codificarFlash(void) {
+    npEncodeFrame(leds, quadro, LED_COUNT);
+}
+
+static void __attribute__((noinline)) HAL_RAM(codificarRam)(void) {
+    npEncodeFrame(leds, quadro, LED_COUNT);
+}
+
+static void benchCodificarFrioFlash(uint32_t i) {
+    leds[i % LED_COUNT].G = (uint8_t)i;
+    halEsfriarCache();
+    codificarFlash();
+    sumidouro += quadro[i % LED_COUNT];
+}
+
+static void benchCodificarFrioRam(uint32_t i) {
+    leds[i % LED_COUNT].G = (uint8_t)i;
+    halEsfriarCache();
+    codificarRam();
+    sumidouro += quadro[i % LED_COUNT];
+}
+
+// Cena do letreiro a cada quadro (o desenho em leds[] é o do benchmark sprite): um passo deslocando
+// as colunas, contra redesenhar as 5 colunas visíveis a partir da fonte, pixel a pixel
+static void benchTextoPasso(uint32_t i) {
+    textoAtualizar(&letreiro, textoProximo(&letreiro));
+    sumidouro += textoMascara(&letreiro);
+}
+
+static void benchTextoRedesenho(uint32_t i) {
+    static const char texto[] = LETREIRO;
+    uint32_t mascara = 0, inicio = i % textoColunas(texto);
+    for (uint32_t x = 0; x < 5; ++x) {
+        uint32_t k = inicio + x, c = k / TEXTO_LARGURA, parte = k % TEXTO_LARGURA;
+        if (c >= sizeof(texto) - 1 || parte == 3)
+            continue;
+        uint32_t bits = (textoGlifo(texto[c]) >> (5 * parte)) & 0x1Fu;
+        for (uint32_t y = 0; y < 5; ++y)
+            if ((bits >> y) & 1u)
+                mascara |= 1u << getIndex((int)x, (int)y);
+    }
+    sumidouro += mascara;
+}
+
+static void benchGerar(uint32_t i) {
+    sequenciaLimpar(&partida);
+    sequenciaGerar(&partida, &gerador, PARTIDA_PASSOS);
+    sumidouro += partida.passos[i % (PARTIDA_PASSOS / 2)];
+}
+
+static void benchConferir(uint32_t i) {
+    uint32_t k = i & (ROTEIRO - 1);
+    sumidouro += sequenciaConferir(&sequencia, k, roteiro[k].direcao, roteiro[k].cor1);
+}
+
+static const bench_t benches[] = {
+    { "vazio", "iteracao", benchVazio },
+    { "getIndex", "quadro_5x5", benchIndice },
+    { "sprite", "quadro", benchSprite },
+    { "sprite_esmaecido", "quadro", benchSpriteEsmaecido },
+    { "codificar_quadro", "quadro", benchCodificar },
+    { "codificar_frio_flash", "quadro", benchCodificarFrioFlash },
+    { "codificar_frio_ram", "quadro", benchCodificarFrioRam },
+    { "texto_passo", "quadro", benchTextoPasso },
+    { "texto_redesenho", "quadro", benchTextoRedesenho },
+    { "gerar_sequencia", "partida", benchGerar },
+    { "conferir_passo", "entrada", benchConferir },
+};
+
+// Sequência e roteiro fixos; o gerador volta à semente para cada rodada medir o mesmo trabalho
+static void preparar(void) {
+    renderInit(RENDER_BRILHO_PADRAO);
+    textoIniciar(&letreiro, LETREIRO, 1, true, 0);
+    aleatorioSemear(&gerador, SEMENTE);
+    sequenciaLimpar(&sequencia);
+    sequenciaGerar(&sequencia, &gerador, ROTEIRO);
+    for (uint32_t k = 0; k < ROTEIRO; ++k) {
+        Direcao direcao = sequenciaDirecao(&sequencia, k);
+        roteiro[k].direcao = k % 13 == 12 ? (Direcao)((direcao + 1) & SEQUENCIA_BITS_DIRECAO) : direcao;
+        roteiro[k].cor1 = sequenciaCor(&sequencia, k) != (k % 8 == 7);
+    }
+    aleatorioSemear(&gerador, SEMENTE);
+}
+
+// Mede um benchmark em lotes e imprime a média e o melhor lote por iteração
+static void rodar(const bench_t *b, uint32_t iteracoes) {
+    uint64_t total = 0;
+    uint32_t melhor = UINT32_MAX, feitas = 0;
+    while (feitas < iteracoes) {
+        uint32_t inicio = halCiclos();
+        for (uint32_t i = 0; i < LOTE; ++i)
+            b->rodar(feitas + i);
+        uint32_t ciclos = (halCiclos() - inicio) & HAL_CICLOS_MASCARA;
+        total += ciclos;
+        if (ciclos < melhor)
+            melhor = ciclos;
+        feitas += LOTE;
+    }
+    printf("bench=%s por=%s alvo=%s unidade=%s versao=%d iteracoes=%u media=%.2f melhor=%.2f\n", b->nome, b->por,
+           ALVO, UNIDADE, BENCH_VERSAO, feitas, (double)total / feitas, (double)melhor / LOTE);
+}
+
+static void rodarTodos(uint32_t iteracoes) {
+    preparar();
+    for (uint32_t b = 0; b < sizeof(benches) / sizeof(benches[0]); ++b)
+        rodar(&benches[b], iteracoes);
+}
+
+#ifdef MM_HOST
+int main(int argc, char **argv) {
+    halInit();
+    rodarTodos(argc > 1 ? (uint32_t)atol(argv[1]) : ITERACOES);
+    return 0;
+}
+#else
+int main() {
+    halInit();
+    for (;;) { // Uma rodada para cada byte recebido pelo USB
+        uint8_t byte;
+        while (halUsbLer(&byte, 1) == 0)
+            halEsperaMs(10);
+        rodarTodos(ITERACOES);
+    }
+}
+#endif
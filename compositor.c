@@ -0,0 +1,66 @@
+#include <stddef.h>
+#include "hal.h"
+#include "compositor.h"
+
+static struct {
+    npLED_t pixels[LED_COUNT]; // Só valem os pixels com bit na máscara
+    uint32_t mascara;          // LEDs cobertos pela camada
+} camadas[CAMADAS];
+
+static uint32_t sujos[2]; // Por quadro codificado: pixels que mudaram desde a última composição dele
+static compositorEstatisticas_t estatisticas;
+
+void compositorInit() {
+    for (uint c = 0; c < CAMADAS; ++c)
+        camadas[c].mascara = 0;
+    sujos[0] = sujos[1] = COMPOSITOR_TODOS; // O conteúdo inicial dos quadros é desconhecido
+    estatisticas = (compositorEstatisticas_t){ 0 };
+}
+
+bool compositorCamada(camada_t camada, const npLED_t *pixels, uint32_t mascara) {
+    estatisticas.atualizacoes++;
+    mascara &= COMPOSITOR_TODOS;
+    uint32_t mudou = camadas[camada].mascara ^ mascara; // Pixels que entraram ou saíram da camada
+    for (uint32_t i = 0, m = mascara; m; ++i, m >>= 1) { // Só os pixels cobertos são copiados
+        if (!(m & 1u))
+            continue;
+        npLED_t *p = &camadas[camada].pixels[i];
+        if (p->R != pixels[i].R || p->G != pixels[i].G || p->B != pixels[i].B) {
+            *p = pixels[i];
+            mudou |= 1u << i;
+        }
+    }
+    camadas[camada].mascara = mascara;
+    for (uint c = camada + 1; c < CAMADAS; ++c) // Camadas de cima escondem a mudança
+        mudou &= ~camadas[c].mascara;
+    sujos[0] |= mudou;
+    sujos[1] |= mudou;
+    return mudou != 0;
+}
+
+void compositorSujar() {
+    sujos[0] = sujos[1] = COMPOSITOR_TODOS;
+}
+
+void HAL_RAM(compositorCompor)(uint32_t *quadro, uint32_t indice) {
+    uint32_t sujo = sujos[indice];
+    for (uint32_t i = 0; sujo; ++i, sujo >>= 1) { // Uma passada; os pixels limpos já estão no quadro
+        if (!(sujo & 1u))
+            continue;
+        uint32_t bit = 1u << i, palavra = 0; // Nenhuma camada: apagado
+        for (int c = CAMADAS - 1; c >= 0; --c) {
+            if (camadas[c].mascara & bit) {
+                palavra = npEncode(camadas[c].pixels[i]);
+                break;
+            }
+        }
+        quadro[i] = palavra;
+        estatisticas.pixels++;
+    }
+    sujos[indice] = 0;
+    estatisticas.composicoes++;
+}
+
+compositorEstatisticas_t compositorEstatisticas() {
+    return estatisticas;
+}
@@ -0,0 +1,38 @@
+#ifndef COMPOSITOR_H
+#define COMPOSITOR_H
+
+// Compositor de camadas da matriz. Cada camada tem os próprios pixels e uma máscara de 25 bits com
+// os LEDs que ela cobre; no pixel, vale a camada mais alta que o cobre (as de baixo aparecem onde a
+// de cima não tem bit). Quem troca uma camada só marca como sujos os pixels que mudaram e ficam
+// visíveis; a composição percorre os 25 LEDs uma vez e escreve direto no quadro codificado para o
+// fio, recalculando só os pixels sujos. Como o driver alterna dois quadros, cada um tem a sua máscara.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "neopixel.h"
+
+#define COMPOSITOR_TODOS ((1u << LED_COUNT) - 1) // Máscara com os 25 LEDs
+
+// Camadas, de baixo para cima
+typedef enum {
+    CAMADA_FUNDO,  // Cena de fundo (ex.: barra de tempo)
+    CAMADA_SPRITE, // Setas, algarismos e verificado
+    CAMADA_HUD,    // Sinais por cima de tudo (ex.: pausa)
+    CAMADAS
+} camada_t;
+
+// Contadores da composição
+typedef struct {
+    uint32_t atualizacoes; // Trocas de camada recebidas
+    uint32_t composicoes;  // Quadros compostos
+    uint32_t pixels;       // Pixels recalculados (25 por quadro sem o controle de sujos)
+} compositorEstatisticas_t;
+
+void compositorInit(void); // Esvazia as camadas e marca os dois quadros como sujos
+// Troca o conteúdo de uma camada ('pixels' pode ser NULL com 'mascara' 0); devolve TRUE se algo visível mudou
+bool compositorCamada(camada_t camada, const npLED_t *pixels, uint32_t mascara);
+void compositorSujar(void); // Os dois quadros foram escritos por outra origem: o próximo de cada um sai inteiro
+void compositorCompor(uint32_t *quadro, uint32_t indice); // Atualiza os pixels sujos do quadro codificado 'indice' (0 ou 1)
+compositorEstatisticas_t compositorEstatisticas(void); // Lê os contadores
+
+#endif
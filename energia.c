@@ -0,0 +1,122 @@
+#include <stddef.h>
+#include "entrada.h"
+#include "joystick.h"
+#include "medidas.h"
+#include "escalonador.h"
+#include "energia.h"
+
+static halCallback_t acordar;           // Avisa o jogo de uma borda de botão durante a pausa
+static bool pausado, esperando, reduzido;
+static volatile uint32_t borda_us;      // 32 bits baixos do instante da interrupção que acordou
+static volatile bool borda;             // Uma borda chegou desde a última redução
+static uint64_t pausa_inicio_us, espera_inicio_us, reducao_inicio_us;
+static uint32_t despertares_inicio;     // Despertares do escalonador no início da pausa
+static energiaEstatisticas_t estatisticas;
+
+// Interrupção do botão (via entrada.c): só marca o instante; a tarefa acordada volta o relógio
+static void HAL_RAM(energiaBorda)(void) {
+    if (!borda) {
+        borda_us = (uint32_t)halTempoUs();
+        borda = true;
+    }
+    acordar();
+}
+
+void energiaInit(halCallback_t acordar_jogo) {
+    acordar = acordar_jogo;
+    pausado = false;
+    esperando = false;
+    reduzido = false;
+    borda = false;
+    estatisticas = (energiaEstatisticas_t){ 0 };
+}
+
+// Joystick parado e botões acordando o jogo, na pausa e na espera
+static void pararJoystick(void) {
+    joystickPausar(true);
+    entradaAviso(energiaBorda);
+}
+
+// Fecha a conta da espera; o joystick continua parado
+static void encerrarEspera(void) {
+    energiaAcordar();
+    esperando = false;
+    estatisticas.espera_us += halTempoUs() - espera_inicio_us;
+}
+
+void energiaPausar() {
+    if (pausado)
+        return;
+    if (esperando) // Pausa no meio da espera da cor: o joystick já está parado
+        encerrarEspera();
+    else
+        pararJoystick();
+    pausado = true;
+    pausa_inicio_us = halTempoUs();
+    despertares_inicio = escalonadorEstatisticas().despertares;
+    estatisticas.pausas++;
+}
+
+void energiaEsperar() {
+    if (pausado || esperando)
+        return;
+    esperando = true;
+    espera_inicio_us = halTempoUs();
+    estatisticas.esperas++;
+    pararJoystick();
+}
+
+void energiaDormir() {
+    if (!(pausado || esperando) || reduzido)
+        return;
+    borda = false;
+    halRelogio(ENERGIA_RELOGIO_KHZ);
+    reduzido = true;
+    reducao_inicio_us = halTempoUs();
+    estatisticas.reducoes++;
+}
+
+void energiaAcordar() {
+    if (!reduzido)
+        return;
+    halRelogio(0);
+    reduzido = false;
+    uint64_t agora = halTempoUs();
+    if (pausado)
+        estatisticas.reduzido_us += agora - reducao_inicio_us;
+    else
+        estatisticas.espera_reduzido_us += agora - reducao_inicio_us;
+    if (borda) { // Acordado por um botão (e não pelo fim da pausa vindo do USB)
+        medir(MEDIDA_DESPERTAR, (uint32_t)agora - borda_us);
+        if (pausado)
+            estatisticas.despertares++;
+        borda = false;
+    }
+}
+
+void energiaRetomar() {
+    if (esperando) {
+        encerrarEspera();
+    } else if (pausado) {
+        energiaAcordar();
+        pausado = false;
+        estatisticas.pausa_us += halTempoUs() - pausa_inicio_us;
+        estatisticas.acordadas += escalonadorEstatisticas().despertares - despertares_inicio;
+    } else {
+        return;
+    }
+    entradaAviso(NULL);
+    joystickPausar(false);
+}
+
+bool energiaPausado() {
+    return pausado;
+}
+
+bool energiaEconomizando() {
+    return pausado || esperando;
+}
+
+energiaEstatisticas_t energiaEstatisticas() {
+    return estatisticas;
+}
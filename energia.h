@@ -0,0 +1,42 @@
+#ifndef ENERGIA_H
+#define ENERGIA_H
+
+// Economia de energia na pausa: o joystick para de amostrar (sem ADC nem temporizador), a tarefa
+// de entrada deixa de ser periódica e o núcleo só acorda por um botão, pelo USB ou por um som em
+// curso. Enquanto dorme, o clk_sys cai para ENERGIA_RELOGIO_KHZ e o PLL do sistema é desligado;
+// cada despertar por botão volta ao relógio cheio antes de tratar a borda, e o tempo da interrupção
+// até aí vai para MEDIDA_DESPERTAR. O estado dormente do RP2040 ficou de fora: ele para o
+// temporizador (o relógio do jogo) e derruba o USB.
+// A mesma economia vale na vez da cor, quando o jogo só espera um botão (energiaEsperar); na vez da
+// direção o joystick precisa continuar amostrando e nada muda.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hal.h"
+
+#define ENERGIA_RELOGIO_KHZ 12000 // clk_sys dormindo na pausa (PLL do USB / 4)
+
+// Contadores das pausas e das esperas (a atual entra em energiaRetomar)
+typedef struct {
+    uint32_t pausas;             // Pausas com economia
+    uint32_t despertares;        // Despertares por botão durante as pausas
+    uint32_t reducoes;           // Vezes que o relógio foi reduzido
+    uint32_t acordadas;          // Retornos do núcleo 0 de halOcioso durante as pausas (botões, USB, sons)
+    uint64_t pausa_us;           // Tempo total em pausa
+    uint64_t reduzido_us;        // Parte dele com o relógio reduzido
+    uint32_t esperas;            // Esperas da cor com economia
+    uint64_t espera_us;          // Tempo total nelas
+    uint64_t espera_reduzido_us; // Parte dele com o relógio reduzido
+} energiaEstatisticas_t;
+
+void energiaInit(halCallback_t acordar); // 'acordar' é chamada (em interrupção) por uma borda de botão na pausa ou na espera
+void energiaPausar(void);                // Para o joystick e passa a acordar pelos botões (o relógio só cai em energiaDormir)
+void energiaEsperar(void);               // O mesmo fora da pausa, enquanto só um botão interessa
+void energiaDormir(void);                // Na pausa ou na espera: reduz o relógio até o próximo despertar
+void energiaAcordar(void);               // Na pausa ou na espera: relógio cheio de novo; mede a latência do despertar
+void energiaRetomar(void);               // Fim da pausa ou da espera: relógio cheio e joystick de volta
+bool energiaPausado(void);
+bool energiaEconomizando(void);          // Na pausa ou na espera
+energiaEstatisticas_t energiaEstatisticas(void);
+
+#endif
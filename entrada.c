@@ -0,0 +1,89 @@
+#include "hal.h"
+#include "pinos.h"
+#include "fila.h"
+#include "mosaico.h"
+#include "entrada.h"
+
+static const uint pinos_botoes[NUM_BOTOES] = { BUTTON_COR_1, BUTTON_COR_2, JOYSTICK_SW }; // Pino de cada botão
+
+static entradaEvento_t eventos[ENTRADA_FILA]; // Armazenamento da fila
+static fila_t fila;                           // Interrupção -> jogo
+static volatile uint64_t ultima_borda[NUM_BOTOES]; // Instante da última borda aceita
+static volatile bool pressionado[NUM_BOTOES];      // Estado filtrado
+static volatile uint32_t descartados;              // Eventos perdidos por fila cheia
+static bool pio;                                   // Bordas já filtradas pelo PIO
+static void (*volatile aviso)(void);               // Quem dorme esperando um botão
+
+// Interrupção de GPIO ou do PIO (produtor único da fila)
+static void HAL_RAM(entradaBorda)(uint pino, bool nivel) {
+    uint64_t agora = halTempoUs(); // Carimbo o mais cedo possível
+    if (pio)
+        agora -= ENTRADA_DEBOUNCE_US; // A borda do PIO chega uma janela depois da última mudança do pino
+    for (uint b = 0; b < NUM_BOTOES; ++b) {
+        if (pinos_botoes[b] != pino)
+            continue;
+        bool novo = !nivel;                        // Botões ativos em nível baixo
+        if (novo == pressionado[b] || (!pio && agora - ultima_borda[b] < ENTRADA_DEBOUNCE_US))
+            return;                                // Repique ou borda sem mudança de estado
+        ultima_borda[b] = agora;
+        pressionado[b] = novo;
+        entradaEvento_t evento = { agora, (uint8_t)b, novo };
+        if (!filaPublicar(&fila, &evento))
+            descartados++;
+        else if (aviso)
+            aviso();
+        return;
+    }
+}
+
+// Liga o filtro dos botões (os pinos já devem estar configurados com pull-up). O PIO só fica com
+// os botões se sobrarem máquinas de estado para as cadeias de LEDs, que são iniciadas depois
+void entradaInit() {
+    filaInit(&fila, eventos, ENTRADA_FILA, sizeof(entradaEvento_t));
+    descartados = 0;
+    aviso = NULL;
+    for (uint b = 0; b < NUM_BOTOES; ++b) {
+        pressionado[b] = !halGpioLer(pinos_botoes[b]);
+        ultima_borda[b] = halTempoUs() - ENTRADA_DEBOUNCE_US; // Aceita já a primeira borda (aritmética modular)
+    }
+    pio = MOSAICO_CADEIAS + NUM_BOTOES <= HAL_MAX_CADEIAS &&
+          halBotoesInit(pinos_botoes, NUM_BOTOES, ENTRADA_DEBOUNCE_US, entradaBorda);
+    for (uint b = 0; !pio && b < NUM_BOTOES; ++b)
+        halGpioIrq(pinos_botoes[b], entradaBorda);
+}
+
+// Retira o próximo evento, se houver
+bool entradaProximo(entradaEvento_t *evento) {
+    return filaConsumir(&fila, evento);
+}
+
+// Espera um evento por até 'espera_ms'; retorna FALSE se o tempo acabou
+bool entradaAguardar(entradaEvento_t *evento, uint32_t espera_ms) {
+    uint64_t limite = halTempoUs() + (uint64_t)espera_ms * 1000;
+    while (!filaConsumir(&fila, evento)) {
+        if (halTempoUs() >= limite)
+            return false;
+        halOcioso(limite); // Acorda na próxima interrupção ou no fim do prazo
+    }
+    return true;
+}
+
+// Estado filtrado do botão
+bool entradaPressionado(Botao botao) {
+    return botao < NUM_BOTOES && pressionado[botao];
+}
+
+// Eventos perdidos por fila cheia
+uint32_t entradaDescartados() {
+    return descartados;
+}
+
+// O debounce está no PIO
+bool entradaPio() {
+    return pio;
+}
+
+// Chamada (em interrupção) a cada evento novo na fila; NULL desliga
+void entradaAviso(void (*novo)(void)) {
+    aviso = novo;
+}
@@ -0,0 +1,37 @@
+#ifndef ENTRADA_H
+#define ENTRADA_H
+
+// Botões por interrupção: cada borda limpa vira um evento na fila SPSC, consumido pelo jogo. O
+// debounce é feito no PIO (botoes.pio): a borda só chega depois de ENTRADA_DEBOUNCE_US de nível
+// estável, e os repiques não custam nada à CPU. Se as máquinas de estado forem todas para os LEDs
+// (mosaico com muitas cadeias), a interrupção de GPIO filtra por carimbo de tempo. O carimbo em
+// microssegundos é o instante da borda, não o da leitura.
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ENTRADA_DEBOUNCE_US 5000 // Janela do PIO: nível estável por este tempo; sem o PIO, bordas mais próximas que isto da última aceita são repique
+#define ENTRADA_FILA 32          // Capacidade da fila de eventos (potência de 2)
+
+typedef enum {
+    BOTAO_COR_1,       // Botão A (vermelho)
+    BOTAO_COR_2,       // Botão B (verde)
+    BOTAO_JOYSTICK_SW, // Botão do joystick (pausa)
+    NUM_BOTOES
+} Botao;
+
+typedef struct {
+    uint64_t tempo_us; // Instante da borda
+    uint8_t botao;     // Botao
+    bool pressionado;  // TRUE na borda de descida (botões ativos em nível baixo)
+} entradaEvento_t;
+
+void entradaInit(void);                                        // Liga o filtro do PIO (ou as interrupções de GPIO) dos botões
+bool entradaProximo(entradaEvento_t *evento);                  // Retira o próximo evento, se houver
+bool entradaAguardar(entradaEvento_t *evento, uint32_t espera_ms); // Espera um evento por até 'espera_ms'
+bool entradaPressionado(Botao botao);                          // Estado filtrado do botão
+uint32_t entradaDescartados(void);                             // Eventos perdidos por fila cheia
+bool entradaPio(void);                                         // O debounce está no PIO
+void entradaAviso(void (*aviso)(void));                        // Chamada (em interrupção) a cada evento novo na fila; NULL desliga
+
+#endif
@@ -0,0 +1,126 @@
+#include <stddef.h>
+#include "hal.h"
+#include "escalonador.h"
+
+typedef struct {
+    tarefa_t funcao;
+    uint32_t periodo_us;    // 0 = sob demanda
+    uint32_t prazo_us;      // Prazo relativo à liberação
+    uint64_t liberacao_us;  // Próxima liberação (ESCALONADOR_NUNCA = nenhuma)
+    tarefaEstatisticas_t estatisticas;
+} tarefaInterna_t;
+
+static tarefaInterna_t tarefas[ESCALONADOR_MAX_TAREFAS];
+static volatile bool acordadas[ESCALONADOR_MAX_TAREFAS]; // Pedidos de interrupções, aplicados pelo laço
+static int num_tarefas;
+static uint64_t inicio_us;    // Instante de escalonadorInit
+static uint64_t ocioso_us;    // Tempo dormindo
+static uint32_t despertares;  // Retornos de halOcioso
+static uint64_t liberacao_atual; // Liberação da tarefa em execução
+static trabalhoOcioso_t trabalho_ocioso; // Trabalho de fundo (ex.: esvaziar o registro)
+
+void escalonadorInit() {
+    num_tarefas = 0;
+    inicio_us = halTempoUs();
+    ocioso_us = 0;
+    despertares = 0;
+    trabalho_ocioso = NULL;
+}
+
+// Tarefas periódicas começam liberadas; as sob demanda esperam o primeiro acordar
+int escalonadorTarefa(const char *nome, tarefa_t funcao, uint32_t periodo_us, uint32_t prazo_us) {
+    if (num_tarefas >= ESCALONADOR_MAX_TAREFAS)
+        return -1;
+    tarefaInterna_t *t = &tarefas[num_tarefas];
+    t->funcao = funcao;
+    t->periodo_us = periodo_us;
+    t->prazo_us = prazo_us ? prazo_us : periodo_us;
+    t->liberacao_us = periodo_us ? halTempoUs() : ESCALONADOR_NUNCA;
+    t->estatisticas = (tarefaEstatisticas_t){ nome, 0, 0, 0, 0 };
+    acordadas[num_tarefas] = false;
+    return num_tarefas++;
+}
+
+void escalonadorAcordar(int tarefa) {
+    uint64_t agora = halTempoUs();
+    if (tarefas[tarefa].liberacao_us > agora)
+        tarefas[tarefa].liberacao_us = agora;
+}
+
+// Só um flag: a liberação (64 bits) é escrita pelo laço, que pode ter sido interrompido no meio dela
+void HAL_RAM(escalonadorAcordarIrq)(int tarefa) {
+    acordadas[tarefa] = true;
+}
+
+void escalonadorAgendar(int tarefa, uint64_t tempo_us) {
+    tarefas[tarefa].liberacao_us = tempo_us;
+}
+
+// Roda uma tarefa liberada e calcula a próxima liberação
+static void escalonadorRodar(tarefaInterna_t *t, uint64_t agora) {
+    uint64_t liberacao = t->liberacao_us;
+    uint64_t prazo = liberacao + t->prazo_us;
+    // Periódica: próxima liberação sem deriva; se atrasou mais de um período, recomeça de agora.
+    // Sob demanda: nenhuma, a não ser que a própria tarefa (ou outra) agende durante a execução.
+    if (t->periodo_us)
+        t->liberacao_us = liberacao + t->periodo_us > agora ? liberacao + t->periodo_us : agora + t->periodo_us;
+    else
+        t->liberacao_us = ESCALONADOR_NUNCA;
+    liberacao_atual = liberacao;
+    t->funcao();
+    uint64_t fim = halTempoUs();
+    uint32_t duracao = (uint32_t)(fim - agora);
+    t->estatisticas.execucoes++;
+    t->estatisticas.ocupado_us += duracao;
+    if (duracao > t->estatisticas.pior_us)
+        t->estatisticas.pior_us = duracao;
+    if (t->prazo_us && fim > prazo)
+        t->estatisticas.perdas++;
+}
+
+uint64_t escalonadorLiberacao() {
+    return liberacao_atual;
+}
+
+void escalonadorOcioso(trabalhoOcioso_t trabalho) {
+    trabalho_ocioso = trabalho;
+}
+
+void escalonadorExecutar() {
+    while (halAtivo()) {
+        uint64_t agora = halTempoUs();
+        tarefaInterna_t *escolhida = NULL;
+        uint64_t proxima = HAL_SEM_LIMITE;
+        for (int i = 0; i < num_tarefas; ++i) { // Prazo mais próximo entre as liberadas
+            tarefaInterna_t *t = &tarefas[i];
+            if (acordadas[i]) {
+                acordadas[i] = false;
+                if (t->liberacao_us > agora)
+                    t->liberacao_us = agora;
+            }
+            if (t->liberacao_us > agora) {
+                if (t->liberacao_us < proxima)
+                    proxima = t->liberacao_us;
+            } else if (!escolhida || t->liberacao_us + t->prazo_us < escolhida->liberacao_us + escolhida->prazo_us) {
+                escolhida = t;
+            }
+        }
+        if (escolhida) {
+            escalonadorRodar(escolhida, agora);
+        } else if (trabalho_ocioso && trabalho_ocioso()) {
+            continue; // Um pedaço de trabalho de fundo; as liberações são reavaliadas antes do próximo
+        } else {
+            halOcioso(proxima); // Interrupções também acordam: o laço reavalia as liberações
+            ocioso_us += halTempoUs() - agora;
+            despertares++;
+        }
+    }
+}
+
+const tarefaEstatisticas_t *escalonadorTarefaEstatisticas(int tarefa) {
+    return &tarefas[tarefa].estatisticas;
+}
+
+escalonadorEstatisticas_t escalonadorEstatisticas() {
+    return (escalonadorEstatisticas_t){ halTempoUs() - inicio_us, ocioso_us, despertares };
+}
@@ -0,0 +1,46 @@
+#ifndef ESCALONADOR_H
+#define ESCALONADOR_H
+
+// Escalonador cooperativo: cada tarefa roda até o fim e devolve o núcleo. Tarefas periódicas são
+// liberadas a cada período; as demais só quando alguém as acorda ou agenda. Entre as liberadas,
+// roda a de prazo mais próximo. Sem nada liberado, o núcleo dorme em halOcioso até a próxima
+// liberação (no Pico, um alarme do temporizador de hardware acorda o núcleo) e o tempo dormido
+// é contabilizado como ocioso.
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ESCALONADOR_MAX_TAREFAS 8    // Tarefas registradas ao mesmo tempo
+#define ESCALONADOR_NUNCA UINT64_MAX // Tarefa sem liberação agendada
+
+typedef void (*tarefa_t)(void); // Corpo da tarefa: não pode bloquear
+typedef bool (*trabalhoOcioso_t)(void); // Trabalho de fundo curto; TRUE se ainda pode haver mais
+
+// Contadores de uma tarefa
+typedef struct {
+    const char *nome;
+    uint32_t execucoes;  // Vezes que a tarefa rodou
+    uint32_t perdas;     // Execuções que terminaram depois do prazo
+    uint32_t pior_us;    // Execução mais longa
+    uint64_t ocupado_us; // Tempo total rodando
+} tarefaEstatisticas_t;
+
+// Contadores do núcleo
+typedef struct {
+    uint64_t total_us;    // Tempo desde escalonadorInit
+    uint64_t ocioso_us;   // Tempo dormindo em halOcioso
+    uint32_t despertares; // Vezes que o núcleo acordou
+} escalonadorEstatisticas_t;
+
+void escalonadorInit(void);                                   // Remove as tarefas e zera os contadores
+int escalonadorTarefa(const char *nome, tarefa_t funcao, uint32_t periodo_us, uint32_t prazo_us); // Registra; período 0 = sob demanda
+void escalonadorAcordar(int tarefa);                          // Libera a tarefa agora
+void escalonadorAcordarIrq(int tarefa);                       // Idem, seguro em interrupção (vale no próximo giro do laço)
+void escalonadorAgendar(int tarefa, uint64_t tempo_us);       // Próxima liberação (tempo absoluto, ou ESCALONADOR_NUNCA)
+void escalonadorOcioso(trabalhoOcioso_t trabalho);           // Roda 'trabalho' antes de dormir, só sem tarefas liberadas
+uint64_t escalonadorLiberacao(void);                          // Liberação da tarefa em execução (o atraso dela é agora menos isto)
+void escalonadorExecutar(void);                               // Laço principal; retorna quando halAtivo() for FALSE
+const tarefaEstatisticas_t *escalonadorTarefaEstatisticas(int tarefa); // Contadores de uma tarefa
+escalonadorEstatisticas_t escalonadorEstatisticas(void);     // Contadores do núcleo
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef FILA_H
+#define FILA_H
+
+// Fila circular sem trava para um produtor e um consumidor (ex.: interrupção -> laço principal).
+// A capacidade é uma potência de 2; cabeça e cauda crescem livremente e só são mascaradas no acesso,
+// então cada índice é escrito por um único lado e basta load/store atômico (sem LDREX no Cortex-M0+).
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+typedef struct {
+    _Atomic uint32_t cabeca; // Próxima escrita (só o produtor altera)
+    _Atomic uint32_t cauda;  // Próxima leitura (só o consumidor altera)
+    uint32_t mascara;        // Capacidade - 1
+    uint32_t tamanho;        // Bytes por elemento
+    uint8_t *dados;          // capacidade * tamanho bytes
+} fila_t;
+
+// Prepara a fila sobre um buffer do chamador; 'capacidade' deve ser potência de 2
+static inline void filaInit(fila_t *f, void *dados, uint32_t capacidade, uint32_t tamanho) {
+    atomic_store_explicit(&f->cabeca, 0, memory_order_relaxed);
+    atomic_store_explicit(&f->cauda, 0, memory_order_relaxed);
+    f->mascara = capacidade - 1;
+    f->tamanho = tamanho;
+    f->dados = (uint8_t *)dados;
+}
+
+// Produtor: copia um elemento para a fila; FALSE se estiver cheia
+static inline bool filaPublicar(fila_t *f, const void *elemento) {
+    uint32_t cabeca = atomic_load_explicit(&f->cabeca, memory_order_relaxed);
+    uint32_t cauda = atomic_load_explicit(&f->cauda, memory_order_acquire);
+    if (cabeca - cauda > f->mascara) // Cheia
+        return false;
+    memcpy(f->dados + (cabeca & f->mascara) * f->tamanho, elemento, f->tamanho);
+    atomic_store_explicit(&f->cabeca, cabeca + 1, memory_order_release); // Publica depois da cópia
+    return true;
+}
+
+// Consumidor: retira o elemento mais antigo; FALSE se estiver vazia
+static inline bool filaConsumir(fila_t *f, void *elemento) {
+    uint32_t cauda = atomic_load_explicit(&f->cauda, memory_order_relaxed);
+    uint32_t cabeca = atomic_load_explicit(&f->cabeca, memory_order_acquire);
+    if (cabeca == cauda) // Vazia
+        return false;
+    memcpy(elemento, f->dados + (cauda & f->mascara) * f->tamanho, f->tamanho);
+    atomic_store_explicit(&f->cauda, cauda + 1, memory_order_release); // Libera o slot depois da cópia
+    return true;
+}
+
+// Produtor: slot livre para ser preenchido no lugar (sem cópia), ou NULL se a fila estiver cheia.
+// Chamar de novo antes de filaConfirmar devolve o mesmo slot
+static inline void *filaReservar(fila_t *f) {
+    uint32_t cabeca = atomic_load_explicit(&f->cabeca, memory_order_relaxed);
+    uint32_t cauda = atomic_load_explicit(&f->cauda, memory_order_acquire);
+    if (cabeca - cauda > f->mascara) // Cheia
+        return NULL;
+    return f->dados + (cabeca & f->mascara) * f->tamanho;
+}
+
+// Produtor: publica o slot de filaReservar
+static inline void filaConfirmar(fila_t *f) {
+    uint32_t cabeca = atomic_load_explicit(&f->cabeca, memory_order_relaxed);
+    atomic_store_explicit(&f->cabeca, cabeca + 1, memory_order_release); // Publica depois do preenchimento
+}
+
+// Consumidor: elemento mais antigo, lido no lugar (sem cópia), ou NULL se a fila estiver vazia
+static inline void *filaEspiar(fila_t *f) {
+    uint32_t cauda = atomic_load_explicit(&f->cauda, memory_order_relaxed);
+    uint32_t cabeca = atomic_load_explicit(&f->cabeca, memory_order_acquire);
+    if (cabeca == cauda) // Vazia
+        return NULL;
+    return f->dados + (cauda & f->mascara) * f->tamanho;
+}
+
+// Consumidor: devolve ao produtor o slot de filaEspiar
+static inline void filaLiberar(fila_t *f) {
+    uint32_t cauda = atomic_load_explicit(&f->cauda, memory_order_relaxed);
+    atomic_store_explicit(&f->cauda, cauda + 1, memory_order_release); // Libera o slot depois da leitura
+}
+
+// Número de elementos na fila (aproximado se chamado fora do produtor/consumidor)
+static inline uint32_t filaOcupacao(fila_t *f) {
+    return atomic_load_explicit(&f->cabeca, memory_order_acquire) - atomic_load_explicit(&f->cauda, memory_order_acquire);
+}
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef HAL_H
+#define HAL_H
+
+// Camada fina de acesso ao hardware. O firmware usa hal_pico.c (Pico SDK);
+// o simulador para Linux usa host/hal_host.c, com relógio e entradas virtuais.
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef MM_HOST
+typedef unsigned int uint; // No Pico este tipo vem do SDK
+#define HAL_RAM(funcao) funcao
+#else
+#include "pico/types.h"
+#include "pico/platform.h"
+// Função copiada para a SRAM no boot: roda sem depender do cache do XIP. Para os caminhos de
+// cada quadro e as interrupções; o resto do código continua na flash.
+#define HAL_RAM(funcao) __not_in_flash_func(funcao)
+#endif
+
+#define HAL_ENTRADA false // Direção de pino: entrada
+#define HAL_SAIDA true    // Direção de pino: saída
+#define HAL_SEM_LIMITE UINT64_MAX // Espera sem prazo em halOcioso
+#define HAL_CICLOS_MASCARA 0xFFFFFFu // halCiclos tem 24 bits úteis (SysTick no Pico)
+#define HAL_MAX_CADEIAS 8 // Cadeias de LEDs em paralelo: 4 máquinas de estado em cada PIO
+
+typedef void (*halCallback_t)(void); // Função chamada pela HAL (pode ser em contexto de interrupção)
+typedef void (*halGpioCallback_t)(uint pino, bool nivel); // Interrupção de GPIO, com o nível após a borda
+typedef uint64_t (*halPasso_t)(void); // Laço de trabalho do núcleo 1: devolve até quando pode dormir
+
+// Sistema
+void halInit(void);  // Inicializa a E/S padrão
+bool halAtivo(void); // FALSE encerra o laço principal (só acontece no simulador)
+uint32_t halEntropia(void); // Bits imprevisíveis para semear o gerador (ROSC no Pico; fixos no simulador)
+
+// Relógio
+uint32_t halTempoMs(void);     // Milissegundos desde o boot
+uint64_t halTempoUs(void);     // Microssegundos desde o boot
+void halEsperaMs(uint32_t ms); // Aguarda em milissegundos
+void halEsperaUs(uint32_t us); // Aguarda em microssegundos
+void halOcioso(uint64_t limite_us); // Espera a próxima interrupção, no máximo até 'limite_us' (tempo absoluto)
+void halEsfriarCache(void);    // Esvazia o cache do XIP, para medir o pior caso (nada no simulador)
+uint32_t halCiclos(void);      // Contador livre para medir trechos curtos: ciclos no Pico, ns no simulador (use HAL_CICLOS_MASCARA na diferença)
+bool halTimerPeriodico(uint32_t periodo_us, halCallback_t callback); // Chama 'callback' a cada período (contexto de interrupção)
+void halTimerPausar(halCallback_t callback, bool pausado); // Para o temporizador de 'callback' (nenhuma interrupção) ou o religa, um período depois
+// Relógio do sistema em 'khz' (0 volta ao do boot). Os divisores do PIO (LEDs e botões) e os tons em curso
+// dos buzzers são refeitos para a nova frequência; o temporizador, o ADC e o USB têm relógios próprios.
+// Com o núcleo 1 rodando, quem troca é ele, entre dois passos; o chamador espera a troca terminar
+void halRelogio(uint32_t khz);
+
+// GPIO
+void halGpioInit(uint pino, bool saida);     // Inicializa um pino como entrada ou saída
+void halGpioPullUp(uint pino);               // Ativa o resistor pull-up interno
+bool halGpioLer(uint pino);                  // Lê o nível de um pino
+void halGpioEscrever(uint pino, bool valor); // Define o nível de um pino
+void halGpioIrq(uint pino, halGpioCallback_t callback); // Interrupção nas duas bordas do pino
+// Botões filtrados no PIO (botoes.pio): uma máquina de estado por pino só aceita uma borda depois
+// de 'janela_us' de nível estável, e 'callback' recebe o novo nível uma janela depois da última
+// mudança do pino (contexto de interrupção). FALSE se faltar máquina de estado ou memória de programa
+bool halBotoesInit(const uint *pinos, uint n, uint32_t janela_us, halGpioCallback_t callback);
+
+// ADC
+void halAdcInit(void);           // Inicializa o ADC
+void halAdcGpioInit(uint pino);  // Prepara um pino para leitura analógica
+uint16_t halAdcLer(uint canal);  // Seleciona o canal e faz uma conversão
+// Conversões contínuas em rodízio pelos canais de 'mascara_canais', gravadas por DMA em 'anel'
+// (tamanho em amostras, potência de 2, alinhado ao próprio tamanho em bytes). O índice da amostra
+// no anel segue o rodízio: com dois canais, posições pares são do menor canal e ímpares do maior.
+void halAdcContinuo(uint mascara_canais, uint32_t taxa_hz, volatile uint16_t *anel, uint tamanho);
+uint halAdcPosicao(void);        // Índice no anel da próxima amostra a ser gravada
+void halAdcPausar(bool pausado); // Para as conversões contínuas, ou as recomeça do início do anel
+
+// PWM (buzzers)
+void halPwmInit(uint pino);                                   // Liga o pino a uma fatia de PWM, em silêncio
+void halPwmTom(uint pino, uint32_t freq_hz, uint8_t volume); // Onda quadrada em 'freq_hz' (0 = silêncio); o volume (0-255) vira o ciclo de trabalho, até 50%
+
+// Núcleo 1
+void halNucleo1Iniciar(halPasso_t passo); // Roda 'passo' no núcleo 1, dormindo entre as chamadas
+void halNucleo1Acordar(void);             // Acorda o núcleo 1 antes do prazo (seguro em interrupção)
+
+// USB (CDC): bytes crus, sem a tradução de fim de linha do stdio
+void halUsbEntrada(halCallback_t chegou);            // 'chegou' avisa que há bytes para ler (contexto de interrupção)
+uint halUsbLer(uint8_t *dados, uint max);            // Lê o que já chegou, sem esperar; devolve quantos bytes
+uint halUsbLivre(void);                             // Bytes que halUsbEscrever aceita agora, sem esperar
+uint halConsoleLivre(void);                         // Bytes que o printf aceita agora, sem esperar
+uint halUsbEscrever(const uint8_t *dados, uint n);  // Escreve sem esperar; devolve quantos bytes couberam
+
+// Flash de dados: os últimos HAL_FLASH_SETORES setores da flash, longe do programa. Lida direto
+// pela memória; apagar e gravar param a flash inteira (e o outro núcleo), então só fora da partida.
+#define HAL_FLASH_SETOR 4096 // Menor área apagável
+#define HAL_FLASH_PAGINA 256 // Menor área gravável
+#define HAL_FLASH_SETORES 4  // 16 KiB no fim da flash
+const uint8_t *halFlashDados(void);                              // Início da área (HAL_FLASH_SETORES * HAL_FLASH_SETOR bytes)
+void halFlashApagar(uint setor);                                 // Todos os bytes do setor voltam a 0xFF
+void halFlashGravar(uint32_t deslocamento, const uint8_t *pagina); // Uma página alinhada; só bits 1 viram 0 (0xFF não muda nada)
+
+// LEDs NeoPixel
+void halLedsInit(const uint *pinos, uint cadeias, halCallback_t concluido); // Uma cadeia por pino; 'concluido' avisa o fim de cada quadro
+// Inicia a transmissão sem bloquear: n palavras GRB por cadeia (as da cadeia c a partir de palavras + c * n),
+// todas as cadeias ao mesmo tempo
+void halLedsEnviar(const uint32_t *palavras, uint n);
+
+#endif
@@ -0,0 +1,507 @@
+#include <stdio.h>
+#include "pico/stdlib.h" // Biblioteca padrão do Pico SDK
+#include "hardware/gpio.h" // Biblioteca para controlar os GPIOs (General Purpose I/O)
+#include "hardware/adc.h"  // Biblioteca para usar o ADC (Analog-to-Digital Converter)
+#include "hardware/pio.h"  // Biblioteca para usar o PIO (Programmable I/O)
+#include "hardware/dma.h"  // Biblioteca para usar o DMA
+#include "hardware/irq.h"  // Biblioteca para registrar as interrupções do DMA
+#include "hardware/pwm.h"  // Biblioteca para gerar os tons dos buzzers
+#include "hardware/clocks.h" // Biblioteca para ler e mudar o relógio do sistema
+#include "hardware/pll.h"    // Desligar o PLL do sistema com o relógio reduzido
+#include "pico/multicore.h" // Biblioteca para iniciar o núcleo 1
+#include "tusb.h"           // Espaço livre no buffer de envio do CDC
+#include "hardware/structs/rosc.h" // Bit aleatório do oscilador em anel
+#include "hardware/structs/systick.h" // Contador de ciclos do núcleo
+#include "hardware/structs/xip_ctrl.h" // Cache da flash
+#include "hardware/flash.h" // Apagar e gravar a flash
+#include "hardware/sync.h"  // Desligar as interrupções durante a gravação
+#include "ws2818b.pio.h" // Biblioteca para controlar os LEDs WS2812B (NeoPixel) usando PIO
+#include "botoes.pio.h"  // Debounce dos botões no PIO
+#include "hal.h"
+
+#define NP_FREQ 800000.f                      // Frequência dos bits no fio
+#define NP_DRENAGEM_US ((8 + 1) * 24 * 5 / 4) // Tempo para esvaziar a FIFO (8 palavras) e o registrador de saída
+#define NP_RESET_US 100                       // Tempo em nível baixo para os LEDs travarem o quadro
+#define ADC_CLOCK_HZ 48000000.f               // Relógio do ADC (uma conversão a cada 1 + div ciclos)
+#define HAL_MAX_TIMERS 4                      // Temporizadores periódicos simultâneos
+#define ROSC_AMOSTRAS_POR_BIT 16              // Leituras do ROSC combinadas em cada bit de entropia
+#define BT_AMOSTRAS_HZ 10000.f                // Amostras por segundo de cada botão: janela em passos de 100 us
+#define BT_MAX 4                              // Botões filtrados: as máquinas de estado de um PIO
+
+static PIO np_pio[HAL_MAX_CADEIAS]; // PIO de cada cadeia de LEDs
+static uint np_sm[HAL_MAX_CADEIAS];  // State Machine de cada cadeia
+static uint np_dma[HAL_MAX_CADEIAS]; // Canal de DMA que alimenta cada State Machine
+static uint np_cadeias;              // Cadeias em uso
+static uint32_t np_dma_mascara;      // Canais de DMA dos LEDs, para dispará-los juntos
+static volatile uint np_pendentes;   // Cadeias com palavras ainda por entrar na FIFO
+static volatile bool np_no_fio;      // Quadro saindo: do disparo até o reset dos LEDs
+static halCallback_t np_concluido = NULL; // Aviso de quadro travado
+static halGpioCallback_t gpio_callbacks[NUM_BANK0_GPIOS]; // Callback de interrupção de cada pino
+static repeating_timer_t timers[HAL_MAX_TIMERS]; // Temporizadores periódicos em uso
+static uint32_t timer_periodos[HAL_MAX_TIMERS];   // Período de cada um, para religar
+static bool timer_parados[HAL_MAX_TIMERS];        // Cancelados por halTimerPausar
+static uint num_timers = 0;
+static uint32_t pwm_freq[NUM_BANK0_GPIOS];        // Tom em curso de cada pino (0 = silêncio), refeito quando o relógio muda
+static uint8_t pwm_volume[NUM_BANK0_GPIOS];
+static int adc_dma = -1;                  // Canal de DMA que esvazia a FIFO do ADC
+static volatile uint16_t *adc_anel;       // Anel de amostras
+static uint adc_tamanho;                  // Tamanho do anel em amostras
+static uint adc_primeiro;                 // Primeiro canal do rodízio
+static halPasso_t nucleo1_passo;          // Trabalho do núcleo 1 (NULL antes de iniciar)
+static volatile bool relogio_pedido;      // halRelogio esperando o núcleo 1 trocar o relógio
+static uint32_t relogio_khz;              // Relógio pedido (0 = o do boot)
+static halCallback_t usb_chegou;          // Aviso de bytes no USB
+static PIO bt_pio;                        // PIO dos botões filtrados
+static uint bt_sm[BT_MAX];                // State Machine de cada botão
+static uint bt_pinos[BT_MAX];             // Pino de cada botão
+static uint bt_n;                         // Botões filtrados
+static halGpioCallback_t bt_callback;     // Aviso de borda limpa
+
+// Sistema
+void halInit() {
+    stdio_init_all(); // Inicializa a E/S padrão (stdio)
+    systick_hw->rvr = HAL_CICLOS_MASCARA; // SysTick livre no relógio do núcleo, sem interrupção
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5;                // ENABLE | CLKSOURCE (processador)
+}
+
+bool halAtivo() {
+    return true; // O firmware nunca sai do laço principal
+}
+
+// O bit do ROSC tem viés e leituras seguidas são correlacionadas: cada bit de saída é o XOR de
+// várias leituras espaçadas, e o instante do boot (que varia com a enumeração USB) entra no fim
+uint32_t halEntropia() {
+    uint32_t bits = 0;
+    for (int i = 0; i < 32; ++i) {
+        uint32_t bit = 0;
+        for (int k = 0; k < ROSC_AMOSTRAS_POR_BIT; ++k) {
+            bit ^= rosc_hw->randombit & 1;
+            busy_wait_us_32(1);
+        }
+        bits = (bits << 1) | bit;
+    }
+    return bits ^ time_us_32();
+}
+
+// Relógio
+uint32_t halTempoMs() {
+    return to_ms_since_boot(get_absolute_time());
+}
+
+uint64_t HAL_RAM(halTempoUs)() {
+    return to_us_since_boot(get_absolute_time());
+}
+
+void halEsperaMs(uint32_t ms) {
+    sleep_ms(ms);
+}
+
+void halEsperaUs(uint32_t us) {
+    sleep_us(us);
+}
+
+void halOcioso(uint64_t limite_us) {
+    if (limite_us == HAL_SEM_LIMITE) {
+        __wfe(); // Qualquer interrupção acorda o núcleo
+    } else {
+        best_effort_wfe_or_timeout(from_us_since_boot(limite_us));
+    }
+}
+
+void HAL_RAM(halEsfriarCache)() {
+    xip_ctrl_hw->flush = 1;
+    (void)xip_ctrl_hw->flush; // A leitura espera o esvaziamento terminar
+}
+
+uint32_t HAL_RAM(halCiclos)() {
+    return HAL_CICLOS_MASCARA - systick_hw->cvr; // O SysTick conta para baixo
+}
+
+static bool HAL_RAM(halTimerDespacho)(repeating_timer_t *rt) {
+    ((halCallback_t)rt->user_data)();
+    return true; // Continua repetindo
+}
+
+bool halTimerPeriodico(uint32_t periodo_us, halCallback_t callback) {
+    if (num_timers >= HAL_MAX_TIMERS)
+        return false;
+    timer_periodos[num_timers] = periodo_us;
+    timer_parados[num_timers] = false;
+    // Atraso negativo: o período conta do início de uma chamada ao início da próxima
+    return add_repeating_timer_us(-(int64_t)periodo_us, halTimerDespacho, (void *)callback, &timers[num_timers++]);
+}
+
+void halTimerPausar(halCallback_t callback, bool pausado) {
+    for (uint i = 0; i < num_timers; ++i) {
+        if ((halCallback_t)timers[i].user_data != callback || timer_parados[i] == pausado)
+            continue;
+        timer_parados[i] = pausado;
+        if (pausado)
+            cancel_repeating_timer(&timers[i]);
+        else
+            add_repeating_timer_us(-(int64_t)timer_periodos[i], halTimerDespacho, (void *)callback, &timers[i]);
+    }
+}
+
+// O relógio reduzido vem do PLL do USB (que continua ligado para o USB) dividido; o do sistema é
+// desligado. Na volta, set_sys_clock_khz religa o PLL do sistema e espera ele travar. Roda no dono
+// dos LEDs e dos buzzers, entre dois passos dele: nenhum quadro começa e nenhum tom muda no meio
+static void relogioAplicar(uint32_t khz) {
+    while (np_no_fio) // O ritmo do PIO não muda no meio de um quadro
+        tight_loop_contents();
+    if (khz == 0) {
+        set_sys_clock_khz(SYS_CLK_KHZ, true);
+    } else {
+        clock_configure(clk_sys, CLOCKS_CLK_SYS_CTRL_SRC_VALUE_CLKSRC_CLK_SYS_AUX,
+                        CLOCKS_CLK_SYS_CTRL_AUXSRC_VALUE_CLKSRC_PLL_USB, USB_CLK_KHZ * KHZ, khz * KHZ);
+        pll_deinit(pll_sys);
+    }
+    for (uint c = 0; c < np_cadeias; ++c) // Os mesmos divisores de ws2818b_program_init e botoes_program_init
+        pio_sm_set_clkdiv(np_pio[c], np_sm[c], ws2818b_clkdiv(NP_FREQ));
+    for (uint b = 0; b < bt_n; ++b)
+        pio_sm_set_clkdiv(bt_pio, bt_sm[b], botoes_clkdiv(BT_AMOSTRAS_HZ));
+    for (uint pino = 0; pino < NUM_BANK0_GPIOS; ++pino) // O divisor do PWM também depende do clk_sys
+        if (pwm_freq[pino])
+            halPwmTom(pino, pwm_freq[pino], pwm_volume[pino]);
+}
+
+// Com o núcleo 1 rodando, a troca vai para ele e o núcleo 0 espera: o quadro em curso termina e o
+// passo dele acaba antes. Num núcleo só, a saída é uma tarefa como esta: nada roda no meio
+void halRelogio(uint32_t khz) {
+    if (!nucleo1_passo) {
+        relogioAplicar(khz);
+        return;
+    }
+    relogio_khz = khz;
+    __dmb();
+    relogio_pedido = true;
+    __sev(); // Acorda o núcleo 1 se ele estiver dormindo
+    while (relogio_pedido)
+        tight_loop_contents();
+}
+
+// GPIO
+void halGpioInit(uint pino, bool saida) {
+    gpio_init(pino);
+    gpio_set_dir(pino, saida ? GPIO_OUT : GPIO_IN);
+}
+
+void halGpioPullUp(uint pino) {
+    gpio_pull_up(pino);
+}
+
+bool halGpioLer(uint pino) {
+    return gpio_get(pino);
+}
+
+void halGpioEscrever(uint pino, bool valor) {
+    gpio_put(pino, valor);
+}
+
+// O SDK tem um único callback de GPIO por núcleo; despacha para o callback do pino
+static void HAL_RAM(halGpioDespacho)(uint gpio, uint32_t eventos) {
+    if (gpio < NUM_BANK0_GPIOS && gpio_callbacks[gpio]) {
+        gpio_callbacks[gpio](gpio, gpio_get(gpio)); // Nível atual: subida e descida podem chegar juntas
+    }
+}
+
+void halGpioIrq(uint pino, halGpioCallback_t callback) {
+    gpio_callbacks[pino] = callback;
+    gpio_set_irq_enabled_with_callback(pino, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true, halGpioDespacho);
+}
+
+// Interrupção do PIO dos botões: uma por borda limpa (os repiques ficam na máquina de estado)
+static void HAL_RAM(btPioIrq)(void) {
+    for (uint b = 0; b < bt_n; ++b) {
+        while (!pio_sm_is_rx_fifo_empty(bt_pio, bt_sm[b]))
+            bt_callback(bt_pinos[b], pio_sm_get(bt_pio, bt_sm[b]) != 0);
+    }
+}
+
+bool halBotoesInit(const uint *pinos, uint n, uint32_t janela_us, halGpioCallback_t callback) {
+    PIO pio = pio1; // Os LEDs começam pelo PIO0
+    int sm[BT_MAX];
+    if (n > BT_MAX || !pio_can_add_program(pio, &botoes_program))
+        return false;
+    for (uint b = 0; b < n; ++b) {
+        sm[b] = pio_claim_unused_sm(pio, false);
+        if (sm[b] < 0) { // Devolve as que já pegou: os LEDs podem precisar delas
+            while (b-- > 0)
+                pio_sm_unclaim(pio, (uint)sm[b]);
+            return false;
+        }
+    }
+    uint offset = pio_add_program(pio, &botoes_program);
+    uint32_t janela = (uint32_t)(janela_us * BT_AMOSTRAS_HZ / 1000000.f);
+    bt_pio = pio;
+    bt_callback = callback;
+    bt_n = n;
+    for (uint b = 0; b < n; ++b) {
+        bt_sm[b] = (uint)sm[b];
+        bt_pinos[b] = pinos[b];
+        botoes_program_init(pio, bt_sm[b], offset, pinos[b], BT_AMOSTRAS_HZ, janela > 0 ? janela : 1);
+        pio_set_irq0_source_enabled(pio, (enum pio_interrupt_source)(pis_sm0_rx_fifo_not_empty + bt_sm[b]), true);
+    }
+    irq_set_exclusive_handler(PIO1_IRQ_0, btPioIrq);
+    irq_set_enabled(PIO1_IRQ_0, true);
+    return true;
+}
+
+// ADC
+void halAdcInit() {
+    adc_init();
+}
+
+void halAdcGpioInit(uint pino) {
+    adc_gpio_init(pino);
+}
+
+uint16_t halAdcLer(uint canal) {
+    adc_select_input(canal); // Seleciona o canal antes da conversão
+    return adc_read();
+}
+
+// (Re)inicia o rodízio do ADC do primeiro canal, com o DMA no início do anel, para a paridade
+// dos índices continuar valendo
+static void adcDmaIniciar(void) {
+    adc_run(false);
+    adc_select_input(adc_primeiro);
+    adc_fifo_drain();
+    dma_channel_set_write_addr(adc_dma, adc_anel, false);
+    dma_channel_set_trans_count(adc_dma, UINT32_MAX, true); // Dias de amostras sem intervenção
+    adc_run(true);
+}
+
+void halAdcContinuo(uint mascara_canais, uint32_t taxa_hz, volatile uint16_t *anel, uint tamanho) {
+    adc_anel = anel;
+    adc_tamanho = tamanho;
+    adc_primeiro = __builtin_ctz(mascara_canais);
+    adc_fifo_setup(true, true, 1, false, false);        // FIFO com DREQ a cada amostra, 12 bits
+    adc_set_clkdiv(ADC_CLOCK_HZ / taxa_hz - 1);         // Taxa total (somando todos os canais)
+    adc_set_round_robin(mascara_canais);
+
+    // DMA da FIFO para o anel: o endereço de escrita dá a volta sozinho (ring)
+    adc_dma = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(adc_dma);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, false);     // Sempre a FIFO
+    channel_config_set_write_increment(&c, true);     // Percorre o anel
+    channel_config_set_ring(&c, true, __builtin_ctz(tamanho * sizeof(uint16_t)));
+    channel_config_set_dreq(&c, DREQ_ADC);            // Avança a cada conversão
+    dma_channel_configure(adc_dma, &c, anel, &adc_hw->fifo, 0, false);
+    adcDmaIniciar();
+}
+
+void halAdcPausar(bool pausado) {
+    if (!pausado) {
+        adcDmaIniciar();
+        return;
+    }
+    adc_run(false);
+    dma_channel_abort(adc_dma);
+    adc_fifo_drain();
+}
+
+uint HAL_RAM(halAdcPosicao)() {
+    if (!dma_channel_is_busy(adc_dma)) // Contagem esgotada (após ~24 dias a 2 kHz): recomeça
+        adcDmaIniciar();
+    uintptr_t escrita = (uintptr_t)dma_channel_hw_addr(adc_dma)->write_addr;
+    return ((escrita - (uintptr_t)adc_anel) / sizeof(uint16_t)) & (adc_tamanho - 1);
+}
+
+// PWM
+void halPwmInit(uint pino) {
+    gpio_set_function(pino, GPIO_FUNC_PWM);
+    uint fatia = pwm_gpio_to_slice_num(pino);
+    pwm_config c = pwm_get_default_config();
+    pwm_init(fatia, &c, false);
+    pwm_set_gpio_level(pino, 0); // Nível 0: pino parado em baixo
+    pwm_set_enabled(fatia, true);
+}
+
+void halPwmTom(uint pino, uint32_t freq_hz, uint8_t volume) {
+    pwm_freq[pino] = volume ? freq_hz : 0;
+    pwm_volume[pino] = volume;
+    if (freq_hz == 0 || volume == 0) {
+        pwm_set_gpio_level(pino, 0);
+        return;
+    }
+    // Menor divisor (em 1/16) que deixa o período caber nos 16 bits do contador: mais resolução de volume
+    uint64_t relogio16 = (uint64_t)clock_get_hz(clk_sys) * 16;
+    uint32_t div16 = (relogio16 + (uint64_t)freq_hz * 65536 - 1) / ((uint64_t)freq_hz * 65536);
+    if (div16 < 16) div16 = 16;
+    if (div16 > 255 * 16 + 15) div16 = 255 * 16 + 15;
+    uint32_t periodo = relogio16 / ((uint64_t)div16 * freq_hz);
+    if (periodo > 65536) periodo = 65536;
+    uint fatia = pwm_gpio_to_slice_num(pino);
+    pwm_set_clkdiv_int_frac(fatia, div16 / 16, div16 % 16);
+    pwm_set_wrap(fatia, periodo - 1);
+    pwm_set_gpio_level(pino, periodo * volume / 510); // Volume 255 = 50% do período
+}
+
+// Núcleo 1: dorme até o prazo devolvido ou até um __sev() do núcleo 0
+static void nucleo1Principal(void) {
+    multicore_lockout_victim_init(); // O núcleo 0 pode pará-lo (numa função da RAM) enquanto grava a flash
+    for (;;) {
+        if (relogio_pedido) { // Entre dois passos: o relógio pedido pelo núcleo 0 (halRelogio)
+            relogioAplicar(relogio_khz);
+            __dmb();
+            relogio_pedido = false;
+        }
+        halOcioso(nucleo1_passo());
+    }
+}
+
+void halNucleo1Iniciar(halPasso_t passo) {
+    nucleo1_passo = passo;
+    multicore_launch_core1(nucleo1Principal);
+}
+
+void HAL_RAM(halNucleo1Acordar)() {
+    __sev(); // Evento visto pelo WFE do outro núcleo
+}
+
+// USB: o stdio do SDK já é o CDC; putchar_raw e getchar_timeout_us não traduzem '\n'
+static void halUsbDisponivel(void *contexto) {
+    if (usb_chegou)
+        usb_chegou();
+}
+
+void halUsbEntrada(halCallback_t chegou) {
+    usb_chegou = chegou;
+    stdio_set_chars_available_callback(chegou ? halUsbDisponivel : NULL, NULL);
+}
+
+uint halUsbLer(uint8_t *dados, uint max) {
+    uint n = 0;
+    while (n < max) {
+        int c = getchar_timeout_us(0);
+        if (c == PICO_ERROR_TIMEOUT)
+            break;
+        dados[n++] = (uint8_t)c;
+    }
+    return n;
+}
+
+// Sem computador conectado, o stdio descarta na hora o que recebe: tudo cabe
+uint halUsbLivre() {
+    return tud_cdc_connected() ? tud_cdc_write_available() : UINT32_MAX;
+}
+
+// O console (stdio) é o próprio USB
+uint halConsoleLivre() {
+    return halUsbLivre();
+}
+
+// Só os bytes que cabem no buffer do CDC: o putchar_raw nunca espera pelo computador
+uint halUsbEscrever(const uint8_t *dados, uint n) {
+    uint livre = halUsbLivre();
+    n = n < livre ? n : livre;
+    for (uint i = 0; i < n; ++i)
+        putchar_raw(dados[i]);
+    return n;
+}
+
+// Flash de dados: nenhum código pode rodar da flash durante a operação. As interrupções ficam
+// desligadas neste núcleo e o núcleo 1, se estiver rodando, espera numa função da RAM.
+#define FLASH_DADOS (PICO_FLASH_SIZE_BYTES - HAL_FLASH_SETORES * HAL_FLASH_SETOR) // Deslocamento na flash
+
+static uint32_t flashTravar(void) {
+    if (nucleo1_passo)
+        multicore_lockout_start_blocking();
+    return save_and_disable_interrupts();
+}
+
+static void flashDestravar(uint32_t interrupcoes) {
+    restore_interrupts(interrupcoes);
+    if (nucleo1_passo)
+        multicore_lockout_end_blocking();
+}
+
+const uint8_t *halFlashDados() {
+    return (const uint8_t *)(XIP_BASE + FLASH_DADOS);
+}
+
+void halFlashApagar(uint setor) {
+    uint32_t interrupcoes = flashTravar();
+    flash_range_erase(FLASH_DADOS + setor * HAL_FLASH_SETOR, HAL_FLASH_SETOR); // Esvazia o cache do XIP no fim
+    flashDestravar(interrupcoes);
+}
+
+void halFlashGravar(uint32_t deslocamento, const uint8_t *pagina) {
+    uint32_t interrupcoes = flashTravar();
+    flash_range_program(FLASH_DADOS + deslocamento, pagina, HAL_FLASH_PAGINA);
+    flashDestravar(interrupcoes);
+}
+
+// LEDs: chamado quando o último bit saiu e o tempo de reset passou
+static int64_t HAL_RAM(npLatchConcluido)(alarm_id_t id, void *user_data) {
+    np_no_fio = false;
+    if (np_concluido) { // Avisa a camada de LEDs
+        np_concluido();
+    }
+    return 0; // Não repete o alarme
+}
+
+// Interrupção do DMA: a última palavra de uma cadeia entrou na FIFO do PIO dela
+static void HAL_RAM(npDmaIrq)(void) {
+    bool nenhum = true;
+    for (uint c = 0; c < np_cadeias; ++c) {
+        if (dma_channel_get_irq0_status(np_dma[c])) { // Interrupção compartilhada: ignora outros canais
+            dma_channel_acknowledge_irq0(np_dma[c]);  // Limpa a interrupção do canal
+            np_pendentes--;
+            nenhum = false;
+        }
+    }
+    if (nenhum || np_pendentes > 0) // As cadeias têm o mesmo tamanho: terminam quase juntas
+        return;
+    // A FIFO ainda precisa esvaziar antes do reset; o alarme marca o fim real do quadro
+    if (add_alarm_in_us(NP_DRENAGEM_US + NP_RESET_US, npLatchConcluido, NULL, true) < 0) {
+        npLatchConcluido(0, NULL); // Sem alarmes livres: libera imediatamente
+    }
+}
+
+void halLedsInit(const uint *pinos, uint cadeias, halCallback_t concluido) {
+    int offset[2] = { -1, -1 }; // O programa é carregado uma vez em cada PIO usado
+    np_concluido = concluido;
+    np_cadeias = cadeias < HAL_MAX_CADEIAS ? cadeias : HAL_MAX_CADEIAS;
+    np_dma_mascara = 0;
+    for (uint c = 0; c < np_cadeias; ++c) {
+        PIO pio = pio0;                                 // Seleciona o PIO0
+        int sm_livre = pio_claim_unused_sm(pio, false); // Aloca uma State Machine não utilizada
+        if (sm_livre < 0) {                             // Se não encontrou no PIO0, tenta no PIO1
+            pio = pio1;
+            sm_livre = pio_claim_unused_sm(pio, true);
+        }
+        uint indice = pio_get_index(pio);
+        if (offset[indice] < 0) // Adiciona o programa PIO para controlar os LEDs WS2812B
+            offset[indice] = (int)pio_add_program(pio, &ws2818b_program);
+        np_pio[c] = pio;
+        np_sm[c] = (uint)sm_livre;
+        ws2818b_program_init(pio, np_sm[c], (uint)offset[indice], pinos[c], NP_FREQ); // Inicializa a State Machine com o programa e a frequência
+
+        // Configura o DMA para escrever uma palavra por LED na FIFO de transmissão, no ritmo do PIO
+        np_dma[c] = dma_claim_unused_channel(true);
+        dma_channel_config cfg = dma_channel_get_default_config(np_dma[c]);
+        channel_config_set_transfer_data_size(&cfg, DMA_SIZE_32);        // Palavras de 32 bits (24 úteis)
+        channel_config_set_read_increment(&cfg, true);                   // Percorre o quadro
+        channel_config_set_write_increment(&cfg, false);                 // Sempre a mesma FIFO
+        channel_config_set_dreq(&cfg, pio_get_dreq(pio, np_sm[c], true)); // Avança quando a FIFO tem espaço
+        dma_channel_configure(np_dma[c], &cfg, &pio->txf[np_sm[c]], NULL, 0, false);
+        dma_channel_set_irq0_enabled(np_dma[c], true);
+        np_dma_mascara |= 1u << np_dma[c];
+    }
+    irq_add_shared_handler(DMA_IRQ_0, npDmaIrq, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+}
+
+void HAL_RAM(halLedsEnviar)(const uint32_t *palavras, uint n) {
+    np_no_fio = true;
+    np_pendentes = np_cadeias;
+    for (uint c = 0; c < np_cadeias; ++c) { // Arma todos os canais antes de disparar
+        dma_channel_set_read_addr(np_dma[c], palavras + c * n, false);
+        dma_channel_set_trans_count(np_dma[c], n, false);
+    }
+    dma_start_channel_mask(np_dma_mascara); // Todas as cadeias começam juntas
+}
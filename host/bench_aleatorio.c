@@ -0,0 +1,61 @@
+// Compara o gerador antigo (rand() % 4 e rand() % 2 por passo) com o xoshiro128** de aleatorio.c:
+// palavras por segundo e passos de sequência gerados por segundo.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "aleatorio.h"
+#include "sequencia.h"
+
+#define ITERACOES 20000000
+
+static volatile uint32_t sumidouro; // Impede que o compilador descarte a geração
+
+static double agoraNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int main(int argc, char **argv) {
+    long iteracoes = argc > 1 ? atol(argv[1]) : ITERACOES;
+    aleatorio_t g;
+    aleatorioSemear(&g, 1);
+    srand(1);
+
+    // Palavras cruas
+    uint32_t soma = 0;
+    double t0 = agoraNs();
+    for (long i = 0; i < iteracoes; ++i)
+        soma += rand();
+    double t1 = agoraNs();
+    for (long i = 0; i < iteracoes; ++i)
+        soma += aleatorioProximo(&g);
+    double t2 = agoraNs();
+    sumidouro = soma;
+
+    // Sequências completas do modo sem fim
+    static sequencia_t s;
+    long sequencias = iteracoes / SEQUENCIA_MAX_PASSOS + 1;
+    double t3 = agoraNs();
+    for (long k = 0; k < sequencias; ++k) {
+        sequenciaLimpar(&s);
+        for (int i = 0; i < SEQUENCIA_MAX_PASSOS; ++i)
+            sequenciaAcrescentar(&s, (Direcao)(rand() % 4), rand() % 2);
+        sumidouro += s.passos[k % sizeof(s.passos)];
+    }
+    double t4 = agoraNs();
+    for (long k = 0; k < sequencias; ++k) {
+        sequenciaLimpar(&s);
+        sequenciaGerar(&s, &g, SEQUENCIA_MAX_PASSOS);
+        sumidouro += s.passos[k % sizeof(s.passos)];
+    }
+    double t5 = agoraNs();
+
+    double passos = (double)sequencias * SEQUENCIA_MAX_PASSOS;
+    printf("rand_ns=%.2f xoshiro_ns=%.2f ganho=%.2fx\n", (t1 - t0) / iteracoes, (t2 - t1) / iteracoes,
+           t2 > t1 ? (t1 - t0) / (t2 - t1) : 0.0);
+    printf("passos_rand_por_s=%.0f passos_xoshiro_por_s=%.0f ganho=%.2fx\n", passos * 1e9 / (t4 - t3),
+           passos * 1e9 / (t5 - t4), t5 > t4 ? (t4 - t3) / (t5 - t4) : 0.0);
+    return 0;
+}
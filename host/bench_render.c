@@ -0,0 +1,59 @@
+// Compara a barra de progresso antiga (porcentagem com divisão de 64 bits e float) com a de
+// ponto fixo de render.c, e mede o quadro de uma seta esmaecida (gama + brilho + sprite).
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "neopixel.h"
+#include "sprites.h"
+#include "render.h"
+
+#define ITERACOES 2000000
+#define TEMPO_LIMITE_MS 5000
+
+static volatile uint32_t sumidouro; // Impede que o compilador descarte o desenho
+
+static double agoraNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Caminho antigo: progresso em % por divisão de 64 bits, LEDs acesos por conta em float
+static void barraAntiga(uint64_t decorrido_us) {
+    int progresso = (int)(decorrido_us / (TEMPO_LIMITE_MS * 10));
+    npClear();
+    int acesos = (int)((float)progresso / 100.0 * LED_COUNT);
+    for (int i = 0; i < acesos; i++)
+        npSetLED(i, 0, 0, 32);
+}
+
+int main(int argc, char **argv) {
+    long iteracoes = argc > 1 ? atol(argv[1]) : ITERACOES;
+    static const animacao_t progresso = ANIMACAO(0, LED_COUNT * RENDER_Q8, TEMPO_LIMITE_MS * 1000);
+    static const animacao_t esmaecer = ANIMACAO(0, 255, 100000);
+    const npLED_t azul = { .G = 0, .R = 0, .B = 32 };
+    renderInit(RENDER_BRILHO_PADRAO);
+
+    double t0 = agoraNs();
+    for (long i = 0; i < iteracoes; ++i) {
+        barraAntiga((uint64_t)(i * 2477) % 5000000);
+        sumidouro += leds[i % LED_COUNT].B;
+    }
+    double t1 = agoraNs();
+    for (long i = 0; i < iteracoes; ++i) {
+        renderBarra(animacaoValor(&progresso, (uint64_t)(i * 2477) % 5000000), azul);
+        sumidouro += leds[i % LED_COUNT].B;
+    }
+    double t2 = agoraNs();
+    for (long i = 0; i < iteracoes; ++i) {
+        renderSprite(spritesSetas[i & 3], azul, (uint8_t)animacaoValor(&esmaecer, (uint64_t)(i * 977) % 100000));
+        sumidouro += leds[i % LED_COUNT].B;
+    }
+    double t3 = agoraNs();
+
+    double antiga = (t1 - t0) / iteracoes, nova = (t2 - t1) / iteracoes;
+    printf("barra_float_ns=%.2f barra_ponto_fixo_ns=%.2f ganho=%.2fx\n", antiga, nova, nova > 0 ? antiga / nova : 0.0);
+    printf("seta_esmaecida_ns=%.2f tabelas_bytes=%zu\n", (t3 - t2) / iteracoes, sizeof(renderGama) * 2);
+    return 0;
+}
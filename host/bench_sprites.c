@@ -0,0 +1,62 @@
+// Compara o desenho antigo (npClear + npSetLED(getIndex(x, y)) por pixel)
+// com o blit das máscaras pré-calculadas de sprites.c.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "neopixel.h"
+#include "sprites.h"
+
+#define ITERACOES 2000000
+
+typedef struct { uint8_t n; uint8_t x[25], y[25]; } glifo_t; // Glifo no formato do código antigo
+
+static glifo_t glifos[14];   // 10 algarismos + 4 setas
+static uint32_t mascaras[14];
+static volatile uint32_t sumidouro; // Impede que o compilador descarte o desenho
+
+static double agoraNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Caminho antigo: apaga tudo e calcula o índice em zigue-zague de cada pixel
+static void desenharAntigo(const glifo_t *g, uint8_t r, uint8_t gr, uint8_t b) {
+    npClear();
+    for (int i = 0; i < g->n; ++i)
+        npSetLED(getIndex(g->x[i], g->y[i]), r, gr, b);
+}
+
+int main(int argc, char **argv) {
+    long iteracoes = argc > 1 ? atol(argv[1]) : ITERACOES;
+
+    for (int k = 0; k < 14; ++k) { // Reconstrói as listas de pixels a partir das máscaras
+        mascaras[k] = k < 10 ? spritesDigitos[k] : spritesSetas[k - 10];
+        glifos[k].n = 0;
+        for (int y = 0; y < 5; ++y)
+            for (int x = 0; x < 5; ++x)
+                if ((mascaras[k] >> getIndex(x, y)) & 1u) {
+                    glifos[k].x[glifos[k].n] = x;
+                    glifos[k].y[glifos[k].n] = y;
+                    glifos[k].n++;
+                }
+    }
+
+    double t0 = agoraNs();
+    for (long i = 0; i < iteracoes; ++i) {
+        desenharAntigo(&glifos[i % 14], 0, 0, 32);
+        sumidouro += leds[i % LED_COUNT].B;
+    }
+    double t1 = agoraNs();
+    for (long i = 0; i < iteracoes; ++i) {
+        spriteDesenhar(mascaras[i % 14], 0, 0, 32);
+        sumidouro += leds[i % LED_COUNT].B;
+    }
+    double t2 = agoraNs();
+
+    double antigo = (t1 - t0) / iteracoes, novo = (t2 - t1) / iteracoes;
+    printf("desenho_antigo_ns=%.2f desenho_sprite_ns=%.2f ganho=%.2fx\n", antigo, novo, novo > 0 ? antigo / novo : 0.0);
+    printf("tabela_sprites_bytes=%zu\n", sizeof(spritesDigitos) + sizeof(spritesSetas) + sizeof(spriteCheckmark) + sizeof(spritePausa));
+    return 0;
+}
@@ -0,0 +1,104 @@
+// Cliente do protocolo USB: mede latência (PROTO_ECO) e vazão de quadros crus contra a placa
+// ou contra o simulador (memoryMatrix2_host -u), e confere a injeção de entradas e a devolução
+// da matriz ao jogo. Sai com erro se alguma resposta faltar ou se o jogo contar mensagens inválidas.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "usb_cliente.h"
+#include "neopixel.h"
+#include "entrada.h"
+
+#define ECOS 200         // Idas e voltas medidas
+#define QUADROS 1000     // Quadros enviados em rajada
+#define ECO_BYTES 16     // Payload de cada eco
+#define PAUSA_MS 50      // Tempo para a lógica do jogo processar uma entrada
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "uso: %s dispositivo [quadros]\n", argv[0]);
+        return 2;
+    }
+    int quadros = argc > 2 ? atoi(argv[2]) : QUADROS;
+    if (!clienteAbrir(argv[1]))
+        return 2;
+    int falhas = 0;
+
+    // Latência: ida e volta de um eco pequeno
+    uint8_t eco[ECO_BYTES];
+    double soma = 0, minimo = 1e18, maximo = 0;
+    int respondidos = 0;
+    for (int i = 0; i < ECOS; ++i) {
+        for (int j = 0; j < ECO_BYTES; ++j)
+            eco[j] = (uint8_t)(i + j);
+        double t0 = clienteAgoraUs();
+        clienteEnviar(PROTO_ECO, (uint8_t)i, eco, sizeof(eco));
+        uint32_t tamanho;
+        if (!clienteEsperar(PROTO_ECO, (uint8_t)i) || memcmp(clienteResposta(&tamanho), eco, sizeof(eco)) ||
+            tamanho != sizeof(eco))
+            continue;
+        double us = clienteAgoraUs() - t0;
+        soma += us;
+        minimo = us < minimo ? us : minimo;
+        maximo = us > maximo ? us : maximo;
+        respondidos++;
+    }
+    printf("ecos=%d respondidos=%d latencia_media_us=%.0f latencia_min_us=%.0f latencia_max_us=%.0f\n", ECOS,
+           respondidos, respondidos ? soma / respondidos : 0.0, respondidos ? minimo : 0.0, maximo);
+    if (respondidos != ECOS) {
+        fprintf(stderr, "falha: %d eco(s) sem resposta\n", ECOS - respondidos);
+        falhas++;
+    }
+
+    // Vazão: quadros em rajada; a placa exibe o mais novo a cada quadro que cabe no fio dos LEDs
+    protocoloEstado_t antes, depois;
+    if (!clienteConsultar(1, &antes)) {
+        fprintf(stderr, "falha: sem resposta à consulta\n");
+        return 1;
+    }
+    npLED_t quadro[LED_COUNT];
+    double t0 = clienteAgoraUs();
+    for (int i = 0; i < quadros; ++i) {
+        for (int j = 0; j < LED_COUNT; ++j) // Um LED correndo pela matriz
+            quadro[j] = (npLED_t){ .G = 0, .R = j == i % LED_COUNT ? 32 : 0, .B = (uint8_t)i };
+        clienteEnviar(PROTO_QUADRO, (uint8_t)i, quadro, sizeof(quadro));
+    }
+    bool respondeu = clienteConsultar(2, &depois);
+    double segundos = (clienteAgoraUs() - t0) / 1e6;
+    uint32_t exibidos = depois.remotos - antes.remotos;
+    uint32_t perdidos = depois.remotos_perdidos - antes.remotos_perdidos;
+    printf("quadros=%d exibidos=%u perdidos=%u enviados_por_s=%.0f exibidos_por_s=%.0f bytes_por_quadro=%u kB_por_s=%.1f\n",
+           quadros, exibidos, perdidos, quadros / segundos, exibidos / segundos,
+           (unsigned)PROTOCOLO_MAX_FIO(sizeof(quadro)), quadros * (double)PROTOCOLO_MAX_FIO(sizeof(quadro)) / segundos / 1e3);
+    if (!respondeu || !depois.remoto || exibidos == 0 || exibidos + perdidos > (uint32_t)quadros) {
+        fprintf(stderr, "falha: quadros remotos não chegaram aos LEDs\n");
+        falhas++;
+    }
+
+    // Entradas: um toque no botão do joystick pausa o jogo; outro retoma
+    protocoloEntrada_t entrada = { PROTO_DIRECAO_LOCAL, 1u << BOTAO_JOYSTICK_SW };
+    clienteEnviar(PROTO_ENTRADA, 3, &entrada, sizeof(entrada));
+    entrada.botoes = 0;
+    clienteEnviar(PROTO_ENTRADA, 4, &entrada, sizeof(entrada));
+    clientePausa(PAUSA_MS);
+    bool pausou = clienteConsultar(5, &depois) && depois.pausado;
+    entrada.botoes = 1u << BOTAO_JOYSTICK_SW;
+    clienteEnviar(PROTO_ENTRADA, 6, &entrada, sizeof(entrada));
+    entrada.botoes = 0;
+    clienteEnviar(PROTO_ENTRADA, 7, &entrada, sizeof(entrada));
+    clientePausa(PAUSA_MS);
+    bool retomou = clienteConsultar(8, &depois) && !depois.pausado;
+
+    // Matriz de volta para o jogo
+    clienteEnviar(PROTO_QUADRO, 9, NULL, 0);
+    clientePausa(PAUSA_MS);
+    bool devolvida = clienteConsultar(10, &depois) && !depois.remoto;
+    printf("pausa=%s retomada=%s matriz_devolvida=%s erros=%u registros=%u\n", pausou ? "ok" : "falha",
+           retomou ? "ok" : "falha", devolvida ? "ok" : "falha", depois.erros, clienteRegistros());
+    if (!pausou || !retomou || !devolvida || depois.erros != 0) {
+        fprintf(stderr, "falha: entrada injetada, devolução da matriz ou mensagens inválidas\n");
+        falhas++;
+    }
+    clienteFechar();
+    return falhas ? 1 : 0;
+}
@@ -0,0 +1,36 @@
+#!/bin/sh
+# Compara duas saídas do memoryMatrix2_bench (ex.: a da versão anterior e a atual) pelo melhor
+# lote por iteração, menos sujeito a ruído que a média; sai com erro se algum benchmark ficou mais
+# lento que a tolerância.
+# uso: comparar_bench.sh antes.txt depois.txt [tolerancia_%]
+antes=$1
+depois=$2
+tolerancia=${3:-10}
+awk -v tolerancia="$tolerancia" '
+    function campo(nome,    i, par) {
+        for (i = 1; i <= NF; ++i) {
+            split($i, par, "=")
+            if (par[1] == nome)
+                return par[2]
+        }
+        return ""
+    }
+    FNR == 1 { arquivo++ }
+    /^bench=/ {
+        chave = campo("bench") "/" campo("alvo")
+        if (arquivo == 1) {
+            base[chave] = campo("melhor")
+            next
+        }
+        if (!(chave in base)) {
+            printf "%-24s novo %s\n", chave, campo("melhor")
+            next
+        }
+        variacao = base[chave] > 0 ? 100 * (campo("melhor") - base[chave]) / base[chave] : 0
+        marca = variacao > tolerancia ? "  <- mais lento" : ""
+        printf "%-24s %10s -> %10s %+7.1f%%%s\n", chave, base[chave], campo("melhor"), variacao, marca
+        if (marca != "")
+            piores++
+    }
+    END { exit piores > 0 }
+' "$antes" "$depois"
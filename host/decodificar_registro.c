@@ -0,0 +1,40 @@
+// Decodificador dos registros binários do MemoryMatrix.
+// Lê um arquivo gravado pelo simulador (-l) e imprime uma linha de texto por registro,
+// com o instante em segundos; no fim, conta os registros e as perdas avisadas.
+
+#include <stdio.h>
+#include <string.h>
+#include "registro.h"
+
+int main(int argc, char **argv) {
+    if (argc > 2) {
+        fprintf(stderr, "uso: %s [registro.bin]   (sem arquivo, lê da entrada padrão)\n", argv[0]);
+        return 2;
+    }
+    FILE *f = argc == 2 ? fopen(argv[1], "rb") : stdin;
+    if (!f) {
+        perror(argv[1]);
+        return 2;
+    }
+    char assinatura[4];
+    if (fread(assinatura, 1, 4, f) != 4 || memcmp(assinatura, REGISTRO_ASSINATURA, 4) != 0) {
+        fprintf(stderr, "%s: não é um arquivo de registros\n", argc == 2 ? argv[1] : "entrada");
+        return 1;
+    }
+
+    registro_t r;
+    unsigned long registros = 0, perdidos = 0;
+    char texto[128];
+    while (fread(&r, sizeof(r), 1, f) == 1) {
+        registroFormatar(&r, texto, sizeof(texto));
+        printf("[%4lu.%06lu] %s\n", (unsigned long)(r.tempo_us / 1000000), (unsigned long)(r.tempo_us % 1000000), texto);
+        if (r.evento == REG_PERDIDOS)
+            perdidos += (uint32_t)r.args[0];
+        else
+            registros++;
+    }
+    if (f != stdin)
+        fclose(f);
+    fprintf(stderr, "registros=%lu perdidos=%lu\n", registros, perdidos);
+    return 0;
+}
@@ -0,0 +1,627 @@
+#define _GNU_SOURCE // ppoll
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "hal_host.h"
+#include "mosaico.h"
+
+#define HOST_MAX_EVENTOS 32  // Eventos pendentes ao mesmo tempo
+#define HOST_US_POR_LED 30   // 24 bits a 800 kHz
+#define HOST_RESET_US 100    // Tempo de reset dos LEDs
+#define HOST_MAX_TIMERS 4    // Temporizadores periódicos simultâneos
+#define HOST_USB_LIVRE 256   // Espaço garantido no pseudo-terminal com POLLOUT (a maior mensagem tem 170 bytes)
+
+typedef struct {
+    uint64_t tempo;      // Instante virtual (us)
+    uint32_t ordem;      // Desempate: eventos do mesmo instante saem na ordem de agendamento
+    hostEvento_t funcao; // Ação
+    void *contexto;      // Argumento da ação
+    bool ativo;          // Slot ocupado
+} evento_t;
+
+static uint64_t agora_us;                      // Relógio virtual
+static bool ativo;                             // FALSE encerra o laço principal do jogo
+static uint32_t entropia;                       // Devolvida por halEntropia: sessões reproduzíveis
+static bool niveis[HOST_NUM_PINOS];            // Nível de cada pino
+static bool externos[HOST_NUM_PINOS];          // Pinos com nível imposto pelo simulador (o pull-up não muda)
+static uint16_t adc[HOST_NUM_CANAIS];          // Valor de cada canal do ADC
+static evento_t eventos[HOST_MAX_EVENTOS];     // Fila de eventos virtuais
+static uint32_t proxima_ordem;                 // Contador de agendamento
+static halCallback_t leds_concluido;           // Aviso de quadro travado
+static halGpioCallback_t irqs[HOST_NUM_PINOS];  // Interrupção de cada pino
+static npLED_t quadro[LED_COUNT];              // Cena 5x5 reconstruída a partir do mosaico
+static npLED_t fisico[MOSAICO_LEDS];           // Todos os LEDs de todas as cadeias
+static uint leds_cadeias;                      // Cadeias inicializadas
+static hostObservadores_t observadores;        // Saídas observadas pelo simulador
+static hostEstatisticas_t estatisticas;        // Contadores da sessão
+
+// Botões filtrados: modelo do botoes.pio com amostragem contínua (o PIO amostra a cada 100 us,
+// então a borda no Pico sai até uma amostra mais tarde). Uma borda vale depois de uma janela
+// inteira sem mudança do pino; só há evento agendado enquanto algum pino está nessa espera
+static halGpioCallback_t botoes_callback;      // NULL sem halBotoesInit
+static uint32_t botoes_janela_us;
+static bool botoes_filtrado[HOST_NUM_PINOS];   // Pino com uma máquina de estado
+static bool botoes_nivel[HOST_NUM_PINOS];      // Nível filtrado (o programa começa em alto)
+static uint64_t botoes_mudanca[HOST_NUM_PINOS]; // Última mudança do pino
+static bool botoes_espera[HOST_NUM_PINOS];     // Conferência agendada
+
+// Temporizador periódico: o evento se reagenda antes de chamar o callback
+typedef struct {
+    uint32_t periodo_us;
+    halCallback_t callback;
+    bool parado;            // Por halTimerPausar: sem evento na fila
+} temporizador_t;
+static temporizador_t timers[HOST_MAX_TIMERS];
+static uint num_timers;
+
+// ADC contínuo: as amostras são geradas sob demanda, quando o anel é consultado
+static volatile uint16_t *adc_anel;  // Anel do jogo (NULL se parado)
+static uint adc_tamanho;             // Tamanho do anel em amostras
+static uint adc_canais[HOST_NUM_CANAIS]; // Ordem do rodízio
+static uint adc_num_canais;
+static uint32_t adc_taxa_hz;         // Amostras por segundo (todos os canais)
+static uint64_t adc_inicio_us;       // Instante da primeira amostra
+static uint64_t adc_geradas;         // Amostras já gravadas no anel
+static uint16_t adc_ruido;           // Amplitude máxima do ruído somado a cada amostra
+static uint32_t adc_semente;         // Gerador do ruído
+static bool adc_parado;              // halAdcPausar: o anel não muda
+static uint32_t relogio_khz;         // halRelogio (0 = o do boot)
+
+// Núcleo 1: o passo roda como evento, no instante que ele mesmo pediu ou quando é acordado
+static halPasso_t nucleo1_passo;     // NULL se o núcleo 1 não foi iniciado
+static uint64_t nucleo1_proximo;     // Próximo despertar agendado (um único evento na fila)
+
+// USB virtual: um descritor (ex.: o mestre de um pseudo-terminal). Com ele o relógio segue o tempo real
+static int usb_fd = -1;              // -1 sem USB
+static halCallback_t usb_chegou;     // Aviso de bytes para ler
+static uint64_t usb_base_us;         // Tempo real (us) do instante virtual 0
+
+// Flash de dados na RAM: não é zerada por hostReiniciar
+#define HOST_FLASH_BYTES (HAL_FLASH_SETORES * HAL_FLASH_SETOR)
+static uint8_t flash[HOST_FLASH_BYTES];
+static bool flash_formatada;         // FALSE até o primeiro uso: o vetor começa zerado, a flash em 0xFF
+static bool flash_cortada;           // Sem energia: apagar e gravar não fazem nada
+static bool flash_corte_armado;
+static uint32_t flash_restantes;     // Bytes até o corte armado
+static hostFlashEstatisticas_t flash_estatisticas;
+
+// Executa, em ordem, todos os eventos até 'alvo' e avança o relógio
+static void hostAvancar(uint64_t alvo) {
+    for (;;) {
+        int prox = -1;
+        for (int i = 0; i < HOST_MAX_EVENTOS; ++i) { // Procura o evento mais antigo
+            if (!eventos[i].ativo || eventos[i].tempo > alvo)
+                continue;
+            if (prox < 0 || eventos[i].tempo < eventos[prox].tempo ||
+                (eventos[i].tempo == eventos[prox].tempo && eventos[i].ordem < eventos[prox].ordem))
+                prox = i;
+        }
+        if (prox < 0)
+            break;
+        evento_t e = eventos[prox];
+        eventos[prox].ativo = false; // Libera o slot antes de executar (a ação pode reagendar)
+        if (e.tempo > agora_us)
+            agora_us = e.tempo;
+        estatisticas.eventos++;
+        e.funcao(e.contexto);
+    }
+    if (alvo > agora_us)
+        agora_us = alvo;
+}
+
+// Instante do próximo evento, ou 'padrao' se não houver nenhum
+static uint64_t hostProximoEvento(uint64_t padrao) {
+    uint64_t prox = UINT64_MAX;
+    for (int i = 0; i < HOST_MAX_EVENTOS; ++i)
+        if (eventos[i].ativo && eventos[i].tempo < prox)
+            prox = eventos[i].tempo;
+    return prox == UINT64_MAX ? padrao : prox;
+}
+
+static void hostTimer(void *contexto) {
+    temporizador_t *t = contexto;
+    hostAgendar(agora_us + t->periodo_us, hostTimer, t);
+    t->callback();
+}
+
+// Grava no anel as amostras que o ADC já teria convertido até agora
+static void hostAdcGerar(void) {
+    uint64_t devidas = (agora_us - adc_inicio_us) * adc_taxa_hz / 1000000 + 1;
+    if (devidas - adc_geradas > adc_tamanho) // Só as últimas voltas do anel importam
+        adc_geradas = (devidas - adc_tamanho) / adc_num_canais * adc_num_canais;
+    for (; adc_geradas < devidas; ++adc_geradas) {
+        int valor = adc[adc_canais[adc_geradas % adc_num_canais]];
+        if (adc_ruido) {
+            adc_semente = adc_semente * 1103515245u + 12345u;
+            valor += (int)((adc_semente >> 16) % (2u * adc_ruido + 1)) - adc_ruido;
+        }
+        adc_anel[adc_geradas & (adc_tamanho - 1)] = valor < 0 ? 0 : valor > 4095 ? 4095 : valor;
+    }
+}
+
+static void hostNucleo1(void *contexto);
+
+// Agenda o núcleo 1, a não ser que ele já vá acordar antes. O despertar mais cedo substitui o
+// anterior na fila: com muitos despertares seguidos, eventos superados não se acumulam
+static void hostNucleo1Agendar(uint64_t tempo_us) {
+    if (!nucleo1_passo || tempo_us >= nucleo1_proximo)
+        return;
+    for (int i = 0; i < HOST_MAX_EVENTOS; ++i)
+        if (eventos[i].ativo && eventos[i].funcao == hostNucleo1)
+            eventos[i].ativo = false;
+    nucleo1_proximo = tempo_us;
+    hostAgendar(tempo_us, hostNucleo1, NULL);
+}
+
+static void hostNucleo1(void *contexto) {
+    nucleo1_proximo = UINT64_MAX;
+    hostNucleo1Agendar(nucleo1_passo());
+}
+
+// Fim da janela de um botão: a borda vale se o pino não mudou desde a última mudança
+static void hostBotaoConferir(void *contexto) {
+    uint pino = (uint)(uintptr_t)contexto;
+    if (agora_us - botoes_mudanca[pino] < botoes_janela_us) { // Mudou de novo: a janela recomeçou
+        hostAgendar(botoes_mudanca[pino] + botoes_janela_us, hostBotaoConferir, contexto);
+        return;
+    }
+    botoes_espera[pino] = false;
+    if (niveis[pino] == botoes_nivel[pino])
+        return; // Voltou ao nível filtrado antes de completar a janela
+    botoes_nivel[pino] = niveis[pino];
+    botoes_callback(pino, niveis[pino]);
+}
+
+static void hostBotaoMudou(uint pino) {
+    botoes_mudanca[pino] = agora_us;
+    if (!botoes_espera[pino]) {
+        botoes_espera[pino] = true;
+        hostAgendar(agora_us + botoes_janela_us, hostBotaoConferir, (void *)(uintptr_t)pino);
+    }
+}
+
+static void hostLedsConcluido(void *contexto) {
+    if (leds_concluido)
+        leds_concluido();
+}
+
+void hostReiniciar(const hostObservadores_t *obs) {
+    agora_us = 0;
+    ativo = true;
+    proxima_ordem = 0;
+    leds_concluido = NULL;
+    memset(eventos, 0, sizeof(eventos));
+    memset(niveis, 0, sizeof(niveis));
+    memset(externos, 0, sizeof(externos));
+    entropia = 1;
+    memset(irqs, 0, sizeof(irqs));
+    botoes_callback = NULL;
+    memset(botoes_filtrado, 0, sizeof(botoes_filtrado));
+    memset(botoes_espera, 0, sizeof(botoes_espera));
+    memset(quadro, 0, sizeof(quadro));
+    memset(fisico, 0, sizeof(fisico));
+    leds_cadeias = 0;
+    memset(&estatisticas, 0, sizeof(estatisticas));
+    num_timers = 0;
+    adc_anel = NULL;
+    adc_parado = false;
+    relogio_khz = 0;
+    adc_ruido = 0;
+    adc_semente = 1;
+    nucleo1_passo = NULL;
+    nucleo1_proximo = UINT64_MAX;
+    usb_fd = -1;
+    usb_chegou = NULL;
+    for (int i = 0; i < HOST_NUM_CANAIS; ++i)
+        adc[i] = HOST_ADC_CENTRO;
+    if (obs)
+        observadores = *obs;
+    else
+        memset(&observadores, 0, sizeof(observadores));
+}
+
+void hostDefinirEntropia(uint32_t valor) {
+    entropia = valor;
+}
+
+void hostEncerrar() {
+    ativo = false;
+}
+
+bool hostAgendar(uint64_t tempo_us, hostEvento_t funcao, void *contexto) {
+    for (int i = 0; i < HOST_MAX_EVENTOS; ++i) {
+        if (!eventos[i].ativo) {
+            eventos[i] = (evento_t){ tempo_us < agora_us ? agora_us : tempo_us, proxima_ordem++, funcao, contexto, true };
+            return true;
+        }
+    }
+    fprintf(stderr, "hal_host: fila de eventos cheia\n");
+    return false;
+}
+
+void hostDefinirPino(uint pino, bool nivel) {
+    if (pino >= HOST_NUM_PINOS)
+        return;
+    externos[pino] = true;
+    if (niveis[pino] == nivel)
+        return;
+    niveis[pino] = nivel;
+    if (irqs[pino]) // Borda: dispara a interrupção como o hardware faria
+        irqs[pino](pino, nivel);
+    if (botoes_filtrado[pino])
+        hostBotaoMudou(pino);
+}
+
+void hostDefinirAdc(uint canal, uint16_t valor) {
+    if (canal < HOST_NUM_CANAIS)
+        adc[canal] = valor;
+}
+
+void hostDefinirRuidoAdc(uint16_t amplitude) {
+    adc_ruido = amplitude;
+}
+
+static uint64_t hostTempoReal(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + ts.tv_nsec / 1000;
+}
+
+void hostDefinirUsb(int fd) {
+    usb_fd = fd;
+    if (fd >= 0)
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    usb_base_us = hostTempoReal() - agora_us; // O relógio virtual continua de onde estava
+}
+
+const npLED_t *hostQuadro() {
+    return quadro;
+}
+
+const npLED_t *hostQuadroFisico() {
+    return fisico;
+}
+
+const hostEstatisticas_t *hostEstatisticas() {
+    return &estatisticas;
+}
+
+void hostFlashFormatar() {
+    memset(flash, 0xFF, sizeof(flash));
+    memset(&flash_estatisticas, 0, sizeof(flash_estatisticas));
+    flash_formatada = true;
+    flash_cortada = flash_corte_armado = false;
+}
+
+void hostFlashCortar(uint32_t bytes) {
+    flash_corte_armado = true;
+    flash_restantes = bytes;
+}
+
+void hostFlashReligar() {
+    flash_cortada = flash_corte_armado = false;
+}
+
+const hostFlashEstatisticas_t *hostFlashEstatisticas() {
+    return &flash_estatisticas;
+}
+
+// Quantos dos 'n' bytes de uma operação acontecem antes do corte
+static uint32_t hostFlashEnergia(uint32_t n) {
+    if (!flash_formatada)
+        hostFlashFormatar();
+    if (flash_cortada)
+        return 0;
+    if (!flash_corte_armado || flash_restantes > n) {
+        flash_restantes -= flash_corte_armado ? n : 0;
+        return n;
+    }
+    uint32_t feitos = flash_restantes;
+    flash_cortada = true;
+    flash_estatisticas.cortes++;
+    return feitos;
+}
+
+// Sistema
+void halInit() {
+}
+
+bool halAtivo() {
+    return ativo;
+}
+
+void halEsfriarCache() {
+}
+
+// Flash: apagar põe 1 em tudo, gravar só derruba bits (AND), como na NOR de verdade. Um corte
+// deixa a operação feita até o meio, do começo da área para o fim.
+const uint8_t *halFlashDados() {
+    if (!flash_formatada)
+        hostFlashFormatar();
+    return flash;
+}
+
+void halFlashApagar(uint setor) {
+    uint32_t n = hostFlashEnergia(HAL_FLASH_SETOR);
+    if (n == 0 && flash_cortada)
+        return;
+    memset(flash + setor * HAL_FLASH_SETOR, 0xFF, n);
+    flash_estatisticas.apagamentos[setor]++;
+}
+
+void halFlashGravar(uint32_t deslocamento, const uint8_t *pagina) {
+    uint32_t n = hostFlashEnergia(HAL_FLASH_PAGINA);
+    if (n == 0 && flash_cortada)
+        return;
+    for (uint32_t i = 0; i < n; ++i)
+        flash[deslocamento + i] &= pagina[i];
+    flash_estatisticas.paginas++;
+}
+
+// Tempo real, não virtual: o custo medido é o do código no computador que roda o simulador
+uint32_t halCiclos() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec) & HAL_CICLOS_MASCARA;
+}
+
+uint32_t halEntropia() {
+    return entropia;
+}
+
+// Relógio: só anda quando o jogo espera, então uma sessão roda muito mais rápido que o tempo real
+uint32_t halTempoMs() {
+    return (uint32_t)(agora_us / 1000);
+}
+
+uint64_t halTempoUs() {
+    return agora_us;
+}
+
+// Com USB, esperar também leva tempo real: o relógio virtual não pode ficar à frente do computador
+static void hostEsperar(uint64_t alvo) {
+    if (usb_fd >= 0) {
+        uint64_t real = hostTempoReal() - usb_base_us;
+        if (alvo > real) {
+            struct timespec espera = { (time_t)((alvo - real) / 1000000), (long)((alvo - real) % 1000000) * 1000 };
+            nanosleep(&espera, NULL);
+        }
+    }
+    hostAvancar(alvo);
+}
+
+void halEsperaMs(uint32_t ms) {
+    hostEsperar(agora_us + (uint64_t)ms * 1000);
+}
+
+void halEsperaUs(uint32_t us) {
+    hostEsperar(agora_us + us);
+}
+
+// Com USB, dorme de verdade até o instante 'alvo' ou até chegarem bytes; devolve TRUE se chegaram
+// e, nesse caso, traz 'alvo' para o instante da chegada
+static bool hostEsperarUsb(uint64_t *alvo) {
+    uint64_t agora = hostTempoReal() - usb_base_us;
+    struct timespec espera, *limite = NULL;
+    if (*alvo != HAL_SEM_LIMITE) {
+        uint64_t falta = *alvo > agora ? *alvo - agora : 0;
+        espera = (struct timespec){ (time_t)(falta / 1000000), (long)(falta % 1000000) * 1000 };
+        limite = &espera;
+    }
+    struct pollfd p = { usb_fd, POLLIN, 0 };
+    if (ppoll(&p, 1, limite, NULL) <= 0 || !(p.revents & POLLIN))
+        return false;
+    agora = hostTempoReal() - usb_base_us;
+    if (agora < *alvo)
+        *alvo = agora;
+    return true;
+}
+
+void halOcioso(uint64_t limite_us) {
+    uint64_t prox = hostProximoEvento(limite_us); // Pula direto para o próximo evento
+    uint64_t alvo = prox < limite_us ? prox : limite_us;
+    bool chegou = usb_fd >= 0 && hostEsperarUsb(&alvo);
+    hostAvancar(alvo);
+    if (chegou && usb_chegou) // Como a interrupção do USB
+        usb_chegou();
+}
+
+// USB
+void halUsbEntrada(halCallback_t chegou) {
+    usb_chegou = chegou;
+}
+
+// Em tempo real, ler também traz o relógio virtual até agora: com o USB cheio o jogo pode nunca
+// chegar a halOcioso, e os eventos vencidos (fim de quadro, temporizadores) rodam aqui, como
+// interrupções no meio da tarefa
+uint halUsbLer(uint8_t *dados, uint max) {
+    if (usb_fd < 0)
+        return 0;
+    uint64_t real = hostTempoReal() - usb_base_us;
+    hostAvancar(real > agora_us ? real : agora_us); // Nunca volta; os eventos do instante atual também rodam
+    ssize_t n = read(usb_fd, dados, max);
+    return n > 0 ? (uint)n : 0;
+}
+
+// O pseudo-terminal não diz quanto cabe; com POLLOUT ele aceita blocos de KiB, então conta a maior mensagem
+uint halUsbLivre() {
+    if (usb_fd < 0)
+        return 0;
+    struct pollfd p = { usb_fd, POLLOUT, 0 };
+    return poll(&p, 1, 0) > 0 && (p.revents & POLLOUT) ? HOST_USB_LIVRE : 0;
+}
+
+// O console é o stdout do simulador, que nunca enche
+uint halConsoleLivre() {
+    return UINT32_MAX;
+}
+
+uint halUsbEscrever(const uint8_t *dados, uint n) {
+    if (usb_fd < 0)
+        return 0;
+    ssize_t escritos = write(usb_fd, dados, n);
+    return escritos > 0 ? (uint)escritos : 0;
+}
+
+bool halTimerPeriodico(uint32_t periodo_us, halCallback_t callback) {
+    if (num_timers >= HOST_MAX_TIMERS)
+        return false;
+    temporizador_t *t = &timers[num_timers++];
+    t->periodo_us = periodo_us;
+    t->callback = callback;
+    t->parado = false;
+    return hostAgendar(agora_us + periodo_us, hostTimer, t);
+}
+
+void halTimerPausar(halCallback_t callback, bool pausado) {
+    for (uint i = 0; i < num_timers; ++i) {
+        temporizador_t *t = &timers[i];
+        if (t->callback != callback || t->parado == pausado)
+            continue;
+        t->parado = pausado;
+        if (!pausado) {
+            hostAgendar(agora_us + t->periodo_us, hostTimer, t);
+            continue;
+        }
+        for (int e = 0; e < HOST_MAX_EVENTOS; ++e) // Tira da fila o próximo disparo
+            if (eventos[e].ativo && eventos[e].funcao == hostTimer && eventos[e].contexto == t)
+                eventos[e].ativo = false;
+    }
+}
+
+// O relógio virtual não depende do clk_sys: só guarda a frequência para o simulador e os testes
+void halRelogio(uint32_t khz) {
+    relogio_khz = khz;
+}
+
+uint32_t hostRelogio() {
+    return relogio_khz;
+}
+
+// GPIO
+void halGpioInit(uint pino, bool saida) {
+    if (pino < HOST_NUM_PINOS && !externos[pino])
+        niveis[pino] = false;
+}
+
+void halGpioPullUp(uint pino) {
+    if (pino < HOST_NUM_PINOS && !externos[pino])
+        niveis[pino] = true;
+}
+
+bool halGpioLer(uint pino) {
+    return pino < HOST_NUM_PINOS && niveis[pino];
+}
+
+void halGpioEscrever(uint pino, bool valor) {
+    if (pino < HOST_NUM_PINOS)
+        niveis[pino] = valor;
+    if (observadores.gpio)
+        observadores.gpio(pino, valor);
+}
+
+void halGpioIrq(uint pino, halGpioCallback_t callback) {
+    if (pino < HOST_NUM_PINOS)
+        irqs[pino] = callback;
+}
+
+bool halBotoesInit(const uint *pinos, uint n, uint32_t janela_us, halGpioCallback_t callback) {
+    botoes_callback = callback;
+    botoes_janela_us = janela_us;
+    for (uint b = 0; b < n; ++b) {
+        if (pinos[b] >= HOST_NUM_PINOS)
+            continue;
+        botoes_filtrado[pinos[b]] = true;
+        botoes_nivel[pinos[b]] = true;
+        if (!niveis[pinos[b]]) // Já apertado: a primeira janela começa agora
+            hostBotaoMudou(pinos[b]);
+    }
+    return true;
+}
+
+// ADC
+void halAdcInit() {
+}
+
+void halAdcGpioInit(uint pino) {
+}
+
+uint16_t halAdcLer(uint canal) {
+    return canal < HOST_NUM_CANAIS ? adc[canal] : 0;
+}
+
+void halAdcContinuo(uint mascara_canais, uint32_t taxa_hz, volatile uint16_t *anel, uint tamanho) {
+    adc_num_canais = 0;
+    for (uint c = 0; c < HOST_NUM_CANAIS; ++c)
+        if (mascara_canais & (1u << c))
+            adc_canais[adc_num_canais++] = c;
+    adc_anel = anel;
+    adc_tamanho = tamanho;
+    adc_taxa_hz = taxa_hz;
+    adc_inicio_us = agora_us;
+    adc_geradas = 0;
+    hostAdcGerar();
+}
+
+uint halAdcPosicao() {
+    if (!adc_anel)
+        return 0;
+    if (!adc_parado)
+        hostAdcGerar();
+    return adc_geradas & (adc_tamanho - 1);
+}
+
+void halAdcPausar(bool pausado) {
+    adc_parado = pausado;
+    if (!pausado && adc_anel) { // Recomeça do início do anel, como o DMA no Pico
+        adc_inicio_us = agora_us;
+        adc_geradas = 0;
+        hostAdcGerar();
+    }
+}
+
+// PWM: só repassa o tom para o observador
+void halPwmInit(uint pino) {
+    halPwmTom(pino, 0, 0);
+}
+
+void halPwmTom(uint pino, uint32_t freq_hz, uint8_t volume) {
+    if (observadores.pwm)
+        observadores.pwm(pino, freq_hz, volume);
+}
+
+// Núcleo 1
+void halNucleo1Iniciar(halPasso_t passo) {
+    nucleo1_passo = passo;
+    nucleo1_proximo = UINT64_MAX;
+    hostNucleo1Agendar(agora_us);
+}
+
+void halNucleo1Acordar() {
+    hostNucleo1Agendar(agora_us);
+}
+
+// LEDs: decodifica as palavras GRB de todas as cadeias e reconstrói a cena lógica pelo mosaico
+void halLedsInit(const uint *pinos, uint cadeias, halCallback_t concluido) {
+    leds_concluido = concluido;
+    leds_cadeias = cadeias;
+}
+
+void halLedsEnviar(const uint32_t *palavras, uint n) {
+    for (uint i = 0; i < n * leds_cadeias && i < MOSAICO_LEDS; ++i) {
+        fisico[i].G = palavras[i] & 0xFF;
+        fisico[i].R = (palavras[i] >> 8) & 0xFF;
+        fisico[i].B = (palavras[i] >> 16) & 0xFF;
+    }
+    for (uint i = 0; i < LED_COUNT; ++i)
+        quadro[i] = fisico[mosaicoAmostra(i)];
+    uint64_t duracao = (uint64_t)n * HOST_US_POR_LED + HOST_RESET_US; // As cadeias transmitem em paralelo
+    estatisticas.quadros++;
+    estatisticas.tempo_fio_us += duracao;
+    if (observadores.quadro)
+        observadores.quadro(quadro);
+    hostAgendar(agora_us + duracao, hostLedsConcluido, NULL); // O fio fica ocupado como no hardware
+}
@@ -0,0 +1,59 @@
+#ifndef HAL_HOST_H
+#define HAL_HOST_H
+
+// Controle do mundo virtual do simulador: relógio, eventos agendados,
+// entradas roteirizadas e o quadro recebido pelos LEDs (todas as cadeias do mosaico).
+// O USB pode ser ligado a um descritor de verdade; aí o simulador roda em tempo real.
+// A flash de dados é um vetor na RAM que sobrevive a hostReiniciar, como a da placa a um reset,
+// com contagem de desgaste e cortes de energia no meio de uma gravação.
+// Os botões de halBotoesInit seguem um modelo do botoes.pio, com o nível amostrado continuamente.
+
+#include "hal.h"
+#include "neopixel.h"
+
+#define HOST_NUM_PINOS 30   // GPIOs do RP2040
+#define HOST_NUM_CANAIS 5   // Canais do ADC
+#define HOST_ADC_CENTRO 2048 // Joystick parado
+
+typedef void (*hostEvento_t)(void *contexto); // Ação executada em um instante virtual
+
+// Funções chamadas pelo simulador quando o jogo produz uma saída
+typedef struct {
+    void (*quadro)(const npLED_t *quadro); // Cada quadro enviado aos LEDs (ordem física)
+    void (*gpio)(uint pino, bool valor);   // Cada escrita em pino de saída
+    void (*pwm)(uint pino, uint32_t freq_hz, uint8_t volume); // Cada mudança de tom de um buzzer
+} hostObservadores_t;
+
+// Contadores de uma sessão
+typedef struct {
+    uint64_t quadros;      // Quadros enviados aos LEDs
+    uint64_t tempo_fio_us; // Tempo virtual ocupado pelo fio dos LEDs
+    uint64_t eventos;      // Eventos agendados executados
+} hostEstatisticas_t;
+
+void hostReiniciar(const hostObservadores_t *observadores); // Zera relógio, pinos e eventos para uma nova sessão
+void hostEncerrar(void);                                     // Faz halAtivo() devolver FALSE
+bool hostAgendar(uint64_t tempo_us, hostEvento_t funcao, void *contexto); // Agenda uma ação no tempo virtual
+void hostDefinirPino(uint pino, bool nivel);                 // Impõe o nível de um pino de entrada (vale mais que o pull-up)
+void hostDefinirAdc(uint canal, uint16_t valor);             // Define o valor lido em um canal do ADC
+void hostDefinirEntropia(uint32_t valor);                    // Valor de halEntropia (semente do jogo)
+void hostDefinirRuidoAdc(uint16_t amplitude);                // Ruído uniforme (+/- amplitude) nas conversões contínuas
+void hostDefinirUsb(int fd);                                 // Liga o USB a um descritor (-1 desliga); com ele o relógio segue o tempo real
+const npLED_t *hostQuadro(void);                             // Último quadro recebido pelos LEDs (cena 5x5, ordem física de um painel)
+const npLED_t *hostQuadroFisico(void);                       // Último quadro de todas as cadeias (MOSAICO_LEDS_POR_CADEIA LEDs por cadeia)
+const hostEstatisticas_t *hostEstatisticas(void);            // Contadores da sessão atual
+uint32_t hostRelogio(void);                                  // Último halRelogio em kHz (0 = o relógio do boot)
+
+// Desgaste e operações da flash de dados desde hostFlashFormatar
+typedef struct {
+    uint32_t apagamentos[HAL_FLASH_SETORES]; // Por setor
+    uint32_t paginas;                        // Páginas gravadas
+    uint32_t cortes;                         // Operações interrompidas por um corte de energia
+} hostFlashEstatisticas_t;
+
+void hostFlashFormatar(void);        // Flash de fábrica (tudo 0xFF) e contadores zerados
+void hostFlashCortar(uint32_t bytes); // Corta a energia depois de mais 'bytes' apagados ou gravados: a operação em curso fica pela metade e as seguintes não acontecem
+void hostFlashReligar(void);          // Energia de volta; a flash fica como o corte a deixou
+const hostFlashEstatisticas_t *hostFlashEstatisticas(void);
+
+#endif
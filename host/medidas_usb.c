@@ -0,0 +1,56 @@
+// Lê os histogramas de medidas.h da placa ou do simulador (memoryMatrix2_host -u) e mostra
+// contagem, média, percentis e as barras dos baldes. Sai com erro se alguma medida não responder.
+
+#include <stdio.h>
+#include <string.h>
+#include "usb_cliente.h"
+#include "medidas.h"
+
+#define BARRA 40 // Largura da barra do balde mais cheio
+
+static void mostrar(medida_t m, const histograma_t *h) {
+    printf("%s (%s): amostras=%u", medidaNome(m), medidaUnidade(m), h->amostras);
+    if (h->amostras == 0) {
+        printf("\n");
+        return;
+    }
+    printf(" min=%u media=%llu p50=%u p90=%u p99=%u max=%u\n", h->minimo,
+           (unsigned long long)(h->soma / h->amostras), histogramaPercentil(h, 50), histogramaPercentil(h, 90),
+           histogramaPercentil(h, 99), h->maximo);
+    uint32_t maior = 0;
+    for (uint32_t b = 0; b < HISTOGRAMA_BALDES; ++b)
+        maior = h->baldes[b] > maior ? h->baldes[b] : maior;
+    for (uint32_t b = 0; b < HISTOGRAMA_BALDES; ++b) {
+        if (h->baldes[b] == 0)
+            continue;
+        int largura = (int)(((uint64_t)h->baldes[b] * BARRA + maior - 1) / maior);
+        printf("  < %10llu %8u ", 1ull << b, h->baldes[b]);
+        for (int i = 0; i < largura; ++i)
+            putchar('#');
+        putchar('\n');
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "uso: %s dispositivo\n", argv[0]);
+        return 2;
+    }
+    if (!clienteAbrir(argv[1]))
+        return 2;
+    int falhas = 0;
+    for (uint8_t m = 0; m < MEDIDAS_NUM; ++m) {
+        clienteEnviar(PROTO_MEDIDAS, m, &m, 1);
+        uint32_t tamanho;
+        histograma_t h;
+        if (!clienteEsperar(PROTO_MEDIDA, m) || (clienteResposta(&tamanho), tamanho != sizeof(h))) {
+            fprintf(stderr, "falha: sem resposta para %s\n", medidaNome(m));
+            falhas++;
+            continue;
+        }
+        memcpy(&h, clienteResposta(&tamanho), sizeof(h));
+        mostrar(m, &h);
+    }
+    clienteFechar();
+    return falhas ? 1 : 0;
+}
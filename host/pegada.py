@@ -0,0 +1,179 @@
+#!/usr/bin/env python3
+# Pegada do firmware na flash e na RAM, lida do mapa do ligador (memoryMatrix2.elf.map, gerado por
+# pico_add_extra_outputs). Mostra o uso de cada região de memória, o tamanho de cada seção de saída
+# e as maiores funções e dados (o SDK compila com -ffunction-sections, então cada um tem sua seção).
+# Seções copiadas da flash para a RAM no boot (.data, código HAL_RAM) contam nas duas regiões.
+# Sai com erro se uma região passar do orçamento dado em --limite.
+#
+# uso: pegada.py memoryMatrix2.elf.map [--limite FLASH=262144] [--limite RAM=65536] [--maiores 25]
+
+import re
+import sys
+
+HEX = r'0x[0-9a-fA-F]+'
+# Prefixos das seções de entrada: o que vem depois é o nome da função ou do dado
+PREFIXOS = ('.time_critical.', '.text.', '.rodata.', '.data.', '.bss.', '.sram_text.', '.uninitialized_data.')
+
+
+def ler_mapa(caminho):
+    regioes = []  # (nome, origem, tamanho)
+    secoes = []   # Seções de saída: {nome, endereco, tamanho, carga}
+    entradas = [] # Seções de entrada: {nome, endereco, tamanho, objeto, saida}
+    estado = None
+    saida = None
+    pendente = None  # Nome de seção (de saída ou de entrada) cujo endereço vem na linha seguinte
+    with open(caminho, encoding='utf-8', errors='replace') as f:
+        for linha in f:
+            linha = linha.rstrip('\n')
+            if linha.startswith('Memory Configuration'):
+                estado = 'regioes'
+                continue
+            if linha.startswith('Linker script and memory map'):
+                estado = 'mapa'
+                continue
+            if estado == 'regioes':
+                m = re.match(r'^(\S+)\s+(' + HEX + r')\s+(' + HEX + r')', linha)
+                if m and m.group(1) != '*default*':
+                    regioes.append((m.group(1), int(m.group(2), 16), int(m.group(3), 16)))
+                continue
+            if estado != 'mapa':
+                continue
+
+            if pendente:
+                m = re.match(r'^\s+(' + HEX + r')\s+(' + HEX + r')(.*)$', linha)
+                tipo, nome = pendente
+                pendente = None
+                if m:
+                    resto = m.group(3).strip()
+                    if tipo == 'saida':
+                        saida = nova_saida(secoes, nome, m.group(1), m.group(2), resto)
+                    elif saida is not None:
+                        entradas.append(nova_entrada(nome, m.group(1), m.group(2), resto, saida))
+                    continue
+
+            # Seção de saída: começa na coluna 0
+            m = re.match(r'^(\.\S+)(?:\s+(' + HEX + r')\s+(' + HEX + r')(.*))?$', linha)
+            if m:
+                if m.group(2) is None:
+                    pendente = ('saida', m.group(1))
+                else:
+                    saida = nova_saida(secoes, m.group(1), m.group(2), m.group(3), m.group(4).strip())
+                continue
+            if linha.startswith('/DISCARD/'):
+                saida = None
+                continue
+
+            # Seção de entrada: um espaço e o nome (o preenchimento de alinhamento só conta na de saída)
+            m = re.match(r'^ (\.\S+|COMMON)(?:\s+(' + HEX + r')\s+(' + HEX + r')\s*(.*))?$', linha)
+            if m and saida is not None:
+                if m.group(2) is None:
+                    pendente = ('entrada', m.group(1))
+                else:
+                    entradas.append(nova_entrada(m.group(1), m.group(2), m.group(3), m.group(4), saida))
+    return regioes, secoes, entradas
+
+
+def nova_saida(secoes, nome, endereco, tamanho, resto):
+    carga = re.search(r'load address (' + HEX + r')', resto)
+    secao = {'nome': nome, 'endereco': int(endereco, 16), 'tamanho': int(tamanho, 16),
+             'carga': int(carga.group(1), 16) if carga else None}
+    secoes.append(secao)
+    return secao
+
+
+def nova_entrada(nome, endereco, tamanho, objeto, saida):
+    return {'nome': nome, 'endereco': int(endereco, 16), 'tamanho': int(tamanho, 16),
+            'objeto': objeto.strip(), 'saida': saida}
+
+
+def regiao_de(regioes, endereco):
+    for nome, origem, tamanho in regioes:
+        if origem <= endereco < origem + tamanho:
+            return nome
+    return None  # Seções que não vão para a memória (depuração, atributos)
+
+
+def simbolo(entrada):
+    nome = entrada['nome']
+    for prefixo in PREFIXOS:
+        if nome.startswith(prefixo):
+            return nome[len(prefixo):]
+    objeto = re.sub(r'.*/', '', entrada['objeto'])  # Seção sem nome de função: fica o objeto
+    return nome + ' (' + objeto + ')'
+
+
+def main(argv):
+    limites = {}
+    maiores = 25
+    caminho = None
+    i = 1
+    while i < len(argv):
+        if argv[i] == '--limite' and i + 1 < len(argv):
+            regiao, _, valor = argv[i + 1].partition('=')
+            limites[regiao] = int(valor, 0)
+            i += 2
+        elif argv[i] == '--maiores' and i + 1 < len(argv):
+            maiores = int(argv[i + 1])
+            i += 2
+        else:
+            caminho = argv[i]
+            i += 1
+    if not caminho:
+        print('uso: pegada.py mapa [--limite REGIAO=bytes]... [--maiores n]', file=sys.stderr)
+        return 2
+
+    regioes, secoes, entradas = ler_mapa(caminho)
+    usado = {nome: 0 for nome, _, _ in regioes}
+
+    print('secao                    regiao     endereco      bytes  carga')
+    for s in secoes:
+        regiao = regiao_de(regioes, s['endereco'])
+        if regiao is None or s['tamanho'] == 0:
+            continue
+        usado[regiao] += s['tamanho']
+        carga = regiao_de(regioes, s['carga']) if s['carga'] is not None else None
+        if carga and carga != regiao:  # Imagem na flash copiada para a RAM no boot
+            usado[carga] += s['tamanho']
+        print('%-24s %-10s 0x%08x %8d  %s' % (s['nome'], regiao, s['endereco'], s['tamanho'], carga or ''))
+
+    itens = []
+    for e in entradas:
+        regiao = regiao_de(regioes, e['endereco'])
+        if regiao is None or e['tamanho'] == 0:
+            continue
+        carga = e['saida']['carga']
+        if carga is not None:  # Mesmo deslocamento dentro da imagem na flash
+            carga = regiao_de(regioes, carga + e['endereco'] - e['saida']['endereco'])
+        onde = regiao + ('+' + carga if carga and carga != regiao else '')
+        itens.append((e['tamanho'], onde, e['saida']['nome'], simbolo(e), e['nome'].startswith('.time_critical.')))
+    itens.sort(reverse=True)
+
+    print()
+    print('maiores (%d de %d)' % (min(maiores, len(itens)), len(itens)))
+    for tamanho, onde, saida, nome, _ in itens[:maiores]:
+        print('%8d  %-16s %-20s %s' % (tamanho, onde, saida, nome))
+
+    na_ram = [(tamanho, nome) for tamanho, _, _, nome, ram in itens if ram]  # HAL_RAM (__not_in_flash_func)
+    print()
+    print('funcoes_na_ram=%d bytes=%d' % (len(na_ram), sum(t for t, _ in na_ram)))
+    for tamanho, nome in na_ram:
+        print('%8d  %s' % (tamanho, nome))
+
+    print()
+    falhas = 0
+    for nome, origem, tamanho in regioes:
+        limite = limites.get(nome)
+        print('regiao=%s usado=%d tamanho=%d%s' % (nome, usado[nome], tamanho,
+                                                    ' limite=%d' % limite if limite is not None else ''))
+        if limite is not None and usado[nome] > limite:
+            print('falha: %s usa %d bytes, acima do orçamento de %d' % (nome, usado[nome], limite), file=sys.stderr)
+            falhas += 1
+    for nome in limites:
+        if nome not in usado:
+            print('falha: região %s não existe no mapa' % nome, file=sys.stderr)
+            falhas += 1
+    return 1 if falhas else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
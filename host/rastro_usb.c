@@ -0,0 +1,53 @@
+// Baixa o rastro (rastro.h) da placa ou do simulador (memoryMatrix2_host -u) para um arquivo que o
+// memoryMatrix2_host -R reproduz. O rastro continua crescendo durante a leitura: vale o total da
+// primeira parte, e os eventos gravados depois ficam de fora.
+
+#include <stdio.h>
+#include <string.h>
+#include "usb_cliente.h"
+#include "rastro.h"
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        fprintf(stderr, "uso: %s dispositivo rastro.bin\n", argv[0]);
+        return 2;
+    }
+    if (!clienteAbrir(argv[1]))
+        return 2;
+    static rastroEvento_t eventos[RASTRO_EVENTOS];
+    protocoloRastro_t cabecalho = { 0 };
+    uint32_t n = 0, total = 1;
+    for (uint8_t seq = 0; n < total; ++seq) {
+        uint8_t pedido[2] = { (uint8_t)n, (uint8_t)(n >> 8) };
+        clienteEnviar(PROTO_RASTRO, seq, pedido, sizeof(pedido));
+        uint32_t tamanho = 0;
+        const uint8_t *parte = clienteEsperar(PROTO_RASTRO_PARTE, seq) ? clienteResposta(&tamanho) : NULL;
+        if (tamanho < sizeof(cabecalho) || (tamanho - sizeof(cabecalho)) % sizeof(rastroEvento_t) != 0) {
+            fprintf(stderr, "falha: sem resposta para o evento %u\n", n);
+            clienteFechar();
+            return 1;
+        }
+        memcpy(&cabecalho, parte, sizeof(cabecalho));
+        total = n == 0 ? cabecalho.total : total;
+        uint32_t recebidos = (tamanho - sizeof(cabecalho)) / sizeof(rastroEvento_t);
+        if (recebidos == 0 || n + recebidos > RASTRO_EVENTOS)
+            break;
+        memcpy(&eventos[n], parte + sizeof(cabecalho), recebidos * sizeof(rastroEvento_t));
+        n += recebidos;
+    }
+    clienteFechar();
+    n = n < total ? n : total;
+
+    FILE *f = fopen(argv[2], "wb");
+    if (!f) {
+        perror(argv[2]);
+        return 1;
+    }
+    fwrite(RASTRO_ASSINATURA, 1, 4, f);
+    fwrite(&cabecalho.perdidos, sizeof(cabecalho.perdidos), 1, f);
+    fwrite(eventos, sizeof(rastroEvento_t), n, f);
+    if (fclose(f) != 0)
+        return 1;
+    printf("rastro_eventos=%u perdidos=%u\n", n, cabecalho.perdidos);
+    return 0;
+}
@@ -0,0 +1,206 @@
+#include <string.h>
+#include "hal_host.h"
+#include "pinos.h"
+#include "entrada.h"
+#include "joystick.h"
+#include "rastro.h"
+#include "reproducao.h"
+
+#define ANTECEDENCIA_US 5000 // Direções entram meio tick (TICK_US do jogo = 10 ms) antes do tick que as viu
+#define SINCRONIA_US 1000    // Intervalo entre as procuras pela semente do jogo reproduzido
+#define FIM_US 10000         // A sessão vai um tick além do último evento do rastro
+
+// Nomes dos estados do jogo, na mesma ordem do enum Estado
+static const char *const estados[] = { "nivel", "seta", "apagado", "preparar", "direcao", "cor",
+                                       "som", "luz", "espera", "vitoria", "pausado", "retomando" };
+#define NUM_ESTADOS (sizeof(estados) / sizeof(estados[0]))
+
+static rastroEvento_t original[RASTRO_EVENTOS];
+static uint64_t tempos[RASTRO_EVENTOS];  // Instantes do original sem a volta dos 32 bits
+static uint32_t n_original, perdidos_original;
+static int semente = -1;                 // Índice da semente no original
+static uint16_t entradas[RASTRO_EVENTOS]; // Índices das entradas em ordem de injeção
+static uint32_t n_entradas, proxima;
+static int64_t deslocamento;             // Instante na sessão menos o instante no original
+static uint64_t atraso;
+
+static uint64_t instanteInjecao(uint32_t k) {
+    return tempos[k] - (original[k].tipo == RASTRO_DIRECAO ? ANTECEDENCIA_US : 0);
+}
+
+bool reproducaoCarregar(const char *caminho) {
+    FILE *f = fopen(caminho, "rb");
+    if (!f) {
+        perror(caminho);
+        return false;
+    }
+    char assinatura[4];
+    if (fread(assinatura, 1, 4, f) != 4 || memcmp(assinatura, RASTRO_ASSINATURA, 4) != 0 ||
+        fread(&perdidos_original, sizeof(perdidos_original), 1, f) != 1) {
+        fprintf(stderr, "%s: não é um rastro\n", caminho);
+        fclose(f);
+        return false;
+    }
+    n_original = (uint32_t)fread(original, sizeof(rastroEvento_t), RASTRO_EVENTOS, f);
+    fclose(f);
+
+    uint64_t volta = 0;
+    semente = -1;
+    n_entradas = 0;
+    for (uint32_t k = 0; k < n_original; ++k) {
+        // Um carimbo muito menor que o anterior deu a volta (as bordas podem vir um pouco antes)
+        if (k > 0 && original[k].tempo_us + volta + (1ull << 31) < tempos[k - 1])
+            volta += 1ull << 32;
+        tempos[k] = original[k].tempo_us + volta;
+        if (original[k].tipo == RASTRO_SEMENTE && semente < 0)
+            semente = (int)k;
+        if (original[k].tipo == RASTRO_BOTAO || original[k].tipo == RASTRO_DIRECAO) {
+            uint32_t i = n_entradas++; // Inserção estável pelo instante de injeção
+            for (; i > 0 && instanteInjecao(entradas[i - 1]) > instanteInjecao(k); --i)
+                entradas[i] = entradas[i - 1];
+            entradas[i] = (uint16_t)k;
+        }
+    }
+    if (semente < 0) {
+        fprintf(stderr, "%s: rastro sem a semente do jogo\n", caminho);
+        return false;
+    }
+    return true;
+}
+
+bool reproducaoGravar(const char *caminho) {
+    FILE *f = fopen(caminho, "wb");
+    if (!f) {
+        perror(caminho);
+        return false;
+    }
+    uint32_t perdidos = rastroPerdidos();
+    fwrite(RASTRO_ASSINATURA, 1, 4, f);
+    fwrite(&perdidos, sizeof(perdidos), 1, f);
+    fwrite(rastroEventos(), sizeof(rastroEvento_t), rastroTamanho(), f);
+    return fclose(f) == 0;
+}
+
+uint32_t reproducaoSemente() {
+    return original[semente].c;
+}
+
+static void encerrar(void *contexto) {
+    hostEncerrar();
+}
+
+// Injeta a próxima entrada e agenda a seguinte (uma por vez na fila de eventos)
+static void injetar(void *contexto) {
+    const rastroEvento_t *e = &original[entradas[proxima++]];
+    if (e->tipo == RASTRO_DIRECAO) {
+        joystickInjetar(e->a);
+    } else {
+        static const uint pinos[NUM_BOTOES] = { BUTTON_COR_1, BUTTON_COR_2, JOYSTICK_SW };
+        if (e->a < NUM_BOTOES)
+            hostDefinirPino(pinos[e->a], !e->b); // Botões são ativos em nível baixo
+    }
+    if (proxima < n_entradas)
+        hostAgendar(instanteInjecao(entradas[proxima]) + deslocamento + atraso, injetar, NULL);
+}
+
+// Espera o jogo gravar a semente: o instante dela alinha os dois relógios. As entradas que vêm antes
+// (apertos durante o boot) já estão agendadas nos instantes do original, contados do boot
+static void sincronizar(void *contexto) {
+    const rastroEvento_t *e = rastroEventos();
+    for (uint32_t k = 0; k < rastroTamanho(); ++k) {
+        if (e[k].tipo == RASTRO_SEMENTE) {
+            deslocamento = (int64_t)e[k].tempo_us - (int64_t)tempos[semente];
+            hostAgendar(tempos[n_original - 1] + deslocamento + atraso + FIM_US, encerrar, NULL);
+            return;
+        }
+    }
+    hostAgendar(halTempoUs() + SINCRONIA_US, sincronizar, NULL);
+}
+
+void reproducaoPreparar(uint64_t atraso_us) {
+    atraso = atraso_us;
+    if (original[semente].a) // Modo sem fim: botão A segurado no boot; a soltura está no rastro
+        hostDefinirPino(BUTTON_COR_1, false);
+    deslocamento = 0;
+    proxima = 0;
+    if (n_entradas > 0)
+        hostAgendar(instanteInjecao(entradas[0]) + atraso, injetar, NULL);
+    hostAgendar(0, sincronizar, NULL);
+}
+
+// Tempo em cada estado: de uma troca até a seguinte (o último, até o fim do rastro)
+static void temposPorEstado(const rastroEvento_t *e, const uint64_t *t, uint32_t n, uint32_t *vezes, uint64_t *total) {
+    int anterior = -1;
+    for (uint32_t k = 0; k < n; ++k) {
+        if (e[k].tipo != RASTRO_ESTADO || e[k].a >= NUM_ESTADOS)
+            continue;
+        if (anterior >= 0)
+            total[e[anterior].a] += t[k] - t[anterior];
+        vezes[e[k].a]++;
+        anterior = (int)k;
+    }
+    if (anterior >= 0)
+        total[e[anterior].a] += t[n - 1] - t[anterior];
+}
+
+static void imprimirEvento(FILE *saida, const char *nome, const rastroEvento_t *e, uint64_t t) {
+    fprintf(saida, " %s=\"%s a=%u b=%u c=%u t=%llu\"", nome, rastroNome(e->tipo), e->a, e->b, e->c, (unsigned long long)t);
+}
+
+uint32_t reproducaoComparar(FILE *saida, uint32_t folga_us) {
+    static uint64_t sessao_t[RASTRO_EVENTOS];
+    const rastroEvento_t *sessao = rastroEventos();
+    uint64_t fim = tempos[n_original - 1] + atraso; // No relógio do original
+    uint32_t n_sessao = 0;
+    for (uint32_t k = 0; k < rastroTamanho(); ++k) { // Só o trecho coberto pelo original
+        int64_t t = (int64_t)sessao[k].tempo_us - deslocamento;
+        if (t > (int64_t)fim)
+            break;
+        sessao_t[n_sessao++] = t < 0 ? 0 : (uint64_t)t;
+    }
+
+    uint32_t divergencias = 0, fora_do_tempo = 0, maior_diferenca = 0, n = n_original < n_sessao ? n_original : n_sessao;
+    int primeira = -1;
+    for (uint32_t k = 0; k < n; ++k) {
+        const rastroEvento_t *a = &original[k], *b = &sessao[k];
+        if (a->tipo != b->tipo || a->a != b->a || a->b != b->b || a->c != b->c) {
+            divergencias++;
+            primeira = primeira < 0 ? (int)k : primeira;
+            continue;
+        }
+        bool atrasada = a->tipo == RASTRO_BOTAO; // Direções são vistas no tick: o atraso só aparece se mudar o tick
+        int64_t diferenca = (int64_t)sessao_t[k] - (int64_t)(tempos[k] + (atrasada ? atraso : 0));
+        uint32_t absoluta = (uint32_t)(diferenca < 0 ? -diferenca : diferenca);
+        maior_diferenca = absoluta > maior_diferenca ? absoluta : maior_diferenca;
+        if (absoluta > folga_us) {
+            fora_do_tempo++;
+            primeira = primeira < 0 ? (int)k : primeira;
+        }
+    }
+    divergencias += (n_original > n ? n_original - n : 0) + (n_sessao > n ? n_sessao - n : 0);
+
+    uint32_t vezes[2][NUM_ESTADOS] = { { 0 } };
+    uint64_t total[2][NUM_ESTADOS] = { { 0 } };
+    temposPorEstado(original, tempos, n_original, vezes[0], total[0]);
+    if (n_sessao > 0)
+        temposPorEstado(sessao, sessao_t, n_sessao, vezes[1], total[1]);
+    for (uint32_t e = 0; e < NUM_ESTADOS; ++e) {
+        if (vezes[0][e] == 0 && vezes[1][e] == 0)
+            continue;
+        fprintf(saida, "estado=%s vezes=%u reproducao_vezes=%u tempo_ms=%.1f reproducao_tempo_ms=%.1f\n", estados[e],
+                vezes[0][e], vezes[1][e], total[0][e] / 1000.0, total[1][e] / 1000.0);
+    }
+    fprintf(saida, "rastro_eventos=%u reproducao_eventos=%u perdidos=%u divergencias=%u fora_do_tempo=%u maior_diferenca_us=%u\n",
+            n_original, n_sessao, perdidos_original, divergencias, fora_do_tempo, maior_diferenca);
+    if (primeira < 0 && n_original != n_sessao)
+        primeira = (int)n;
+    if (primeira >= 0) {
+        fprintf(saida, "primeira_divergencia=%d", primeira);
+        if ((uint32_t)primeira < n_original)
+            imprimirEvento(saida, "original", &original[primeira], tempos[primeira]);
+        if ((uint32_t)primeira < n_sessao)
+            imprimirEvento(saida, "reproducao", &sessao[primeira], sessao_t[primeira]);
+        fprintf(saida, "\n");
+    }
+    return divergencias + fora_do_tempo;
+}
@@ -0,0 +1,25 @@
+#ifndef REPRODUCAO_H
+#define REPRODUCAO_H
+
+// Reprodução de um rastro (rastro.h) no simulador: a semente e o modo vão para o boot, cada borda
+// de botão vai para o pino no mesmo instante e cada direção vai para o joystick meio tick antes
+// do tick que a viu (sem passar pelo filtro do ADC). Os instantes do rastro são alinhados pelo
+// evento da semente, então um rastro do Pico também serve. No fim, as saídas gravadas pelo jogo
+// reproduzido (camadas, estados e vereditos) são comparadas com as do rastro, evento a evento.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+bool reproducaoCarregar(const char *caminho);  // Lê um rastro; FALSE se não abriu ou não é um rastro
+bool reproducaoGravar(const char *caminho);    // Grava o rastro da sessão atual do jogo
+uint32_t reproducaoSemente(void);              // Semente do jogo gravado
+// Nova sessão: prende o botão A se o jogo gravado estava no modo sem fim e agenda as entradas,
+// 'atraso_us' depois do original (0 = os mesmos instantes)
+void reproducaoPreparar(uint64_t atraso_us);
+// Compara a sessão com o rastro e imprime o relatório: a primeira divergência, a diferença de
+// instante de cada evento e o tempo em cada estado do jogo. Diferenças de instante até 'folga_us'
+// não contam. Devolve o número de divergências
+uint32_t reproducaoComparar(FILE *saida, uint32_t folga_us);
+
+#endif
@@ -0,0 +1,499 @@
+// Simulador do MemoryMatrix para Linux.
+// Roda o mesmo main() do firmware sobre a HAL do host, com relógio virtual,
+// quadro 5x5 virtual e entradas vindas de um roteiro ou de um jogador automático.
+// Com -u, o USB do jogo vira um pseudo-terminal e a sessão roda em tempo real (veja bench_usb).
+// Com -R, as entradas vêm de um rastro gravado (-g ou rastro_usb) e as saídas são comparadas com ele.
+
+#define _GNU_SOURCE // posix_openpt, cfmakeraw
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <termios.h>
+#include "hal_host.h"
+#include "pinos.h"
+#include "escalonador.h"
+#include "registro.h"
+#include "sequencia.h"
+#include "render.h"
+#include "compositor.h"
+#include "mosaico.h"
+#include "medidas.h"
+#include "energia.h"
+#include "reproducao.h"
+
+#define NIVEIS_VITORIA 9       // Mesmo MAX_SEQUENCIA do jogo
+#define MAX_PASSOS SEQUENCIA_MAX_PASSOS // Passos memorizados pelo jogador automático
+#define SEM_FIM_SEGURAR_MS 100 // Botão A segurado no boot para escolher o modo sem fim
+#define MAX_ROTEIRO 1024       // Linhas de um roteiro
+#define US_POR_MS 1000ULL
+
+#define BOT_FIM_SEQUENCIA_MS 400 // Sem nova seta após um apagado: a sequência acabou
+#define BOT_INICIO_MS 350        // Do fim da sequência até o jogo começar a ler (250 + 500 - 400)
+#define BOT_SEGURAR_MS 120       // Tempo segurando joystick e botão (mais de duas leituras)
+#define BOT_PAUSA_MS 60          // Intervalo entre passos
+
+int memoryMatrixMain(void); // main() do jogo, renomeado na compilação para o host
+int getIndex(int x, int y); // Layout da matriz, definido pelo jogo
+
+enum { JOY_CIMA, JOY_BAIXO, JOY_ESQUERDA, JOY_DIREITA, JOY_CENTRO }; // Mesma ordem do enum Direcao
+enum { QUADRO_OUTRO, QUADRO_SETA, QUADRO_APAGADO };
+
+typedef struct {
+    int direcao; // JOY_*
+    bool cor1;   // TRUE = vermelho (botão A)
+} passo_t;
+
+typedef struct {
+    uint64_t tempo_us; // Instante virtual
+    int alvo;          // -1 = joystick, senão pino
+    int valor;         // Direção (joystick) ou 1 = pressionado
+} acao_t;
+
+// Opções da linha de comando
+static int sessoes = 1000;
+static double prob_erro = 0.0;
+static uint64_t limite_us = 600 * 1000 * US_POR_MS;
+static int reacao_ms = 100;
+static bool verboso = false;
+static const char *arquivo_roteiro = NULL;
+static int niveis_vitoria = NIVEIS_VITORIA; // -i: modo sem fim, encerrando depois deste nível
+static bool sem_fim = false;
+static bool semente_fixa = false; // -S: todas as sessões com a mesma semente do jogo
+static uint32_t semente_jogo;
+static FILE *arquivo_registro = NULL; // -l: registros em binário, para o decodificador
+static const char *arquivo_usb = NULL;  // -u: onde escrever o caminho do pseudo-terminal do USB
+static const char *arquivo_rastro = NULL; // -g: rastro da sessão, para reproduzir com -R
+static const char *arquivo_reproducao = NULL; // -R: rastro reproduzido no lugar do jogador
+static uint64_t atraso_reproducao_us = 0;  // -A: entradas da reprodução atrasadas
+static uint32_t folga_reproducao_us = 0;   // -T: diferença de instante aceita na comparação
+
+// Estado da sessão
+static int acertos, derrotas_sessao;
+static bool vitoria;
+
+// Jogador automático
+static passo_t memoria[MAX_PASSOS], entrada[MAX_PASSOS];
+static int n_memoria, n_entrada, passo_atual, fase;
+static int ultimo_quadro;
+static uintptr_t geracao;
+static uint32_t semente_bot = 1;
+
+// Roteiro
+static acao_t roteiro[MAX_ROTEIRO];
+static int n_roteiro, proxima_acao;
+
+// Gerador próprio, para não interferir no rand() do jogo
+static double botAleatorio(void) {
+    semente_bot = semente_bot * 1664525u + 1013904223u;
+    return (semente_bot >> 8) / (double)(1u << 24);
+}
+
+static void definirJoystick(int direcao) {
+    hostDefinirAdc(0, direcao == JOY_CIMA ? 4095 : direcao == JOY_BAIXO ? 0 : HOST_ADC_CENTRO);     // Eixo Y
+    hostDefinirAdc(1, direcao == JOY_DIREITA ? 4095 : direcao == JOY_ESQUERDA ? 0 : HOST_ADC_CENTRO); // Eixo X
+}
+
+static bool aceso(const npLED_t *q, int x, int y) {
+    const npLED_t *p = &q[getIndex(x, y)];
+    return p->R || p->G || p->B;
+}
+
+// Reconhece as setas de mostrarSequencia pela ponta (dois pixels característicos)
+static int classificar(const npLED_t *q, passo_t *passo) {
+    int acesos = 0, vermelhos = 0, verdes = 0;
+    for (int i = 0; i < LED_COUNT; ++i) {
+        if (q[i].R || q[i].G || q[i].B) acesos++;
+        if (q[i].R && !q[i].G && !q[i].B) vermelhos++;
+        if (q[i].G && !q[i].R && !q[i].B) verdes++;
+    }
+    if (acesos == 0)
+        return QUADRO_APAGADO;
+    if (acesos != 7 || (vermelhos != 7 && verdes != 7))
+        return QUADRO_OUTRO;
+    passo->cor1 = vermelhos == 7;
+    if (aceso(q, 1, 1) && aceso(q, 3, 1)) passo->direcao = JOY_CIMA;
+    else if (aceso(q, 1, 3) && aceso(q, 3, 3)) passo->direcao = JOY_BAIXO;
+    else if (aceso(q, 1, 1) && aceso(q, 1, 3)) passo->direcao = JOY_ESQUERDA;
+    else if (aceso(q, 3, 1) && aceso(q, 3, 3)) passo->direcao = JOY_DIREITA;
+    else return QUADRO_OUTRO;
+    return QUADRO_SETA;
+}
+
+// Executa um passo da entrada: joystick, depois botão, depois solta tudo
+static void botAcao(void *contexto) {
+    uint64_t agora = halTempoUs();
+    passo_t *p = &entrada[passo_atual];
+    switch (fase) {
+        case 0: { // Move o joystick (às vezes para a direção errada)
+            int direcao = p->direcao;
+            if (prob_erro > 0 && botAleatorio() < prob_erro)
+                direcao = (direcao + 1) % 4;
+            definirJoystick(direcao);
+            fase = 1;
+            hostAgendar(agora + BOT_SEGURAR_MS * US_POR_MS, botAcao, NULL);
+            break;
+        }
+        case 1: // Volta ao centro e pressiona o botão da cor
+            definirJoystick(JOY_CENTRO);
+            hostDefinirPino(p->cor1 ? BUTTON_COR_1 : BUTTON_COR_2, false);
+            fase = 2;
+            hostAgendar(agora + BOT_SEGURAR_MS * US_POR_MS, botAcao, NULL);
+            break;
+        default: // Solta o botão e segue para o próximo passo
+            hostDefinirPino(BUTTON_COR_1, true);
+            hostDefinirPino(BUTTON_COR_2, true);
+            fase = 0;
+            if (++passo_atual < n_entrada)
+                hostAgendar(agora + BOT_PAUSA_MS * US_POR_MS, botAcao, NULL);
+            break;
+    }
+}
+
+// Nenhuma seta nova desde o último apagado: começa a repetir a sequência
+static void botFimSequencia(void *contexto) {
+    if ((uintptr_t)contexto != geracao || n_memoria == 0)
+        return; // Apareceu outra seta nesse meio tempo
+    memcpy(entrada, memoria, sizeof(passo_t) * n_memoria);
+    n_entrada = n_memoria;
+    n_memoria = 0;
+    passo_atual = 0;
+    fase = 0;
+    hostAgendar(halTempoUs() + (BOT_INICIO_MS + reacao_ms) * US_POR_MS, botAcao, NULL);
+}
+
+static void botQuadro(const npLED_t *q) {
+    passo_t passo;
+    int tipo = classificar(q, &passo);
+    if (tipo == QUADRO_SETA && ultimo_quadro != QUADRO_SETA) { // Nova seta da sequência
+        if (n_memoria < MAX_PASSOS)
+            memoria[n_memoria++] = passo;
+        geracao++;
+    } else if (tipo == QUADRO_APAGADO && ultimo_quadro == QUADRO_SETA) {
+        hostAgendar(halTempoUs() + BOT_FIM_SEQUENCIA_MS * US_POR_MS, botFimSequencia, (void *)++geracao);
+    }
+    ultimo_quadro = tipo;
+}
+
+static void encerrarSessao(void *contexto) {
+    hostEncerrar();
+}
+
+// Fim de sessão: LED de erro apagado ou todos os níveis vencidos. O jogo guarda o histórico
+// quando o LED do resultado apaga, então a sessão vai até aí; as tarefas liberadas no mesmo
+// instante (o primeiro quadro do placar) ainda rodam, e o rastro não termina no meio do instante
+static void observarGpio(uint pino, bool valor) {
+    if (valor) {
+        acertos += pino == LED_ACERTO;
+    } else if (pino == LED_ERRO) {
+        derrotas_sessao++;
+        hostAgendar(halTempoUs() + 1, encerrarSessao, NULL);
+    } else if (pino == LED_ACERTO && acertos >= niveis_vitoria) {
+        vitoria = true;
+        hostAgendar(halTempoUs() + 1, encerrarSessao, NULL);
+    }
+}
+
+// Grava cada registro drenado como os 16 bytes crus
+static bool gravarRegistro(const registro_t *registro) {
+    fwrite(registro, sizeof(*registro), 1, arquivo_registro);
+    return true;
+}
+
+static void soltarBotaoA(void *contexto) {
+    hostDefinirPino(BUTTON_COR_1, true);
+}
+
+static void limiteDeTempo(void *contexto) {
+    hostEncerrar();
+}
+
+// Aplica as ações do roteiro em ordem de tempo
+static void roteiroAcao(void *contexto) {
+    const acao_t *a = &roteiro[proxima_acao++];
+    if (a->alvo < 0)
+        definirJoystick(a->valor);
+    else
+        hostDefinirPino(a->alvo, !a->valor); // Botões são ativos em nível baixo
+    if (proxima_acao < n_roteiro)
+        hostAgendar(roteiro[proxima_acao].tempo_us, roteiroAcao, NULL);
+}
+
+// Formato: uma ação por linha, "<tempo_ms> <joy|cor1|cor2|sw> <valor>"
+// joy aceita CIMA, BAIXO, ESQUERDA, DIREITA ou CENTRO; botões aceitam 1 (pressionado) ou 0
+static bool carregarRoteiro(const char *caminho) {
+    static const char *direcoes[] = { "CIMA", "BAIXO", "ESQUERDA", "DIREITA", "CENTRO" };
+    FILE *f = fopen(caminho, "r");
+    if (!f) {
+        perror(caminho);
+        return false;
+    }
+    char linha[128], alvo[16], valor[16];
+    unsigned long tempo_ms;
+    int numero = 0;
+    n_roteiro = 0;
+    while (fgets(linha, sizeof(linha), f)) {
+        numero++;
+        if (linha[0] == '#' || linha[strspn(linha, " \t\r\n")] == '\0')
+            continue;
+        if (sscanf(linha, "%lu %15s %15s", &tempo_ms, alvo, valor) != 3 || n_roteiro >= MAX_ROTEIRO) {
+            fprintf(stderr, "%s:%d: linha inválida\n", caminho, numero);
+            fclose(f);
+            return false;
+        }
+        acao_t *a = &roteiro[n_roteiro];
+        a->tempo_us = tempo_ms * US_POR_MS;
+        if (strcmp(alvo, "joy") == 0) {
+            a->alvo = -1;
+            a->valor = -1;
+            for (int d = 0; d < 5; ++d)
+                if (strcmp(valor, direcoes[d]) == 0)
+                    a->valor = d;
+        } else {
+            a->alvo = strcmp(alvo, "cor1") == 0 ? BUTTON_COR_1 : strcmp(alvo, "cor2") == 0 ? BUTTON_COR_2 :
+                      strcmp(alvo, "sw") == 0 ? JOYSTICK_SW : -2;
+            a->valor = atoi(valor) != 0;
+        }
+        if (a->alvo == -2 || a->valor < 0 || (n_roteiro > 0 && a->tempo_us < roteiro[n_roteiro - 1].tempo_us)) {
+            fprintf(stderr, "%s:%d: ação inválida ou fora de ordem\n", caminho, numero);
+            fclose(f);
+            return false;
+        }
+        n_roteiro++;
+    }
+    fclose(f);
+    return true;
+}
+
+// USB em um pseudo-terminal: o lado escravo fica aberto aqui também, em modo cru, para nenhum
+// byte ser ecoado ou traduzido e o mestre não dar erro enquanto nenhum cliente estiver conectado.
+// O caminho do escravo vai para 'caminho' (escrito de uma vez, para quem espera o arquivo aparecer)
+static int abrirUsb(const char *caminho) {
+    int mestre = posix_openpt(O_RDWR | O_NOCTTY);
+    if (mestre < 0 || grantpt(mestre) != 0 || unlockpt(mestre) != 0) {
+        perror("posix_openpt");
+        return -1;
+    }
+    const char *escravo = ptsname(mestre);
+    int fd = open(escravo, O_RDWR | O_NOCTTY);
+    struct termios modo;
+    if (fd < 0 || tcgetattr(fd, &modo) != 0) {
+        perror(escravo);
+        return -1;
+    }
+    cfmakeraw(&modo);
+    tcsetattr(fd, TCSANOW, &modo);
+    char temporario[512];
+    snprintf(temporario, sizeof(temporario), "%s.tmp", caminho);
+    FILE *f = fopen(temporario, "w");
+    if (!f) {
+        perror(temporario);
+        return -1;
+    }
+    fprintf(f, "%s\n", escravo);
+    fclose(f);
+    rename(temporario, caminho);
+    return mestre;
+}
+
+static void uso(const char *programa) {
+    fprintf(stderr,
+            "uso: %s [-n sessões] [-e prob_erro] [-r reação_ms] [-t limite_s] [-s roteiro] [-l registro.bin] [-i níveis] [-S semente] [-u usb.txt]\n"
+            "          [-g rastro.bin] [-R rastro.bin [-A atraso_ms] [-T folga_us]] [-v]\n"
+            "  sem -s, um jogador automático lê as setas do quadro virtual e as repete\n"
+            "  com -l, as mensagens do jogo vão em binário para o arquivo (veja decodificar_registro)\n"
+            "  com -i, joga o modo sem fim e conta vitória ao passar do nível pedido\n"
+            "  com -S, usa a semente registrada por uma partida (sem -S, cada sessão tem a sua)\n"
+            "  com -u, o USB é um pseudo-terminal (caminho gravado em usb.txt): uma sessão, em tempo real e sem jogador automático\n"
+            "  com -g, grava o rastro da sessão (entradas, camadas, estados e vereditos)\n"
+            "  com -R, uma sessão com as entradas do rastro; erro se as saídas divergirem (-A atrasa as entradas, -T tolera\n"
+            "  diferenças de instante, como as de um rastro do Pico)\n",
+            programa);
+}
+
+static double segundosReais(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv) {
+    int opcao;
+    while ((opcao = getopt(argc, argv, "n:e:r:t:s:l:i:S:u:g:R:A:T:vh")) != -1) {
+        switch (opcao) {
+            case 'n': sessoes = atoi(optarg); break;
+            case 'e': prob_erro = atof(optarg); break;
+            case 'r': reacao_ms = atoi(optarg); break;
+            case 't': limite_us = strtoull(optarg, NULL, 10) * 1000 * US_POR_MS; break;
+            case 's': arquivo_roteiro = optarg; break;
+            case 'l': arquivo_registro = fopen(optarg, "wb"); if (!arquivo_registro) { perror(optarg); return 2; } break;
+            case 'i': sem_fim = true; niveis_vitoria = atoi(optarg); break;
+            case 'S': semente_fixa = true; semente_jogo = strtoul(optarg, NULL, 0); break;
+            case 'u': arquivo_usb = optarg; sessoes = 1; break;
+            case 'g': arquivo_rastro = optarg; sessoes = 1; break;
+            case 'R': arquivo_reproducao = optarg; sessoes = 1; break;
+            case 'A': atraso_reproducao_us = strtoull(optarg, NULL, 10) * US_POR_MS; break;
+            case 'T': folga_reproducao_us = (uint32_t)strtoul(optarg, NULL, 10); break;
+            case 'v': verboso = true; break;
+            default: uso(argv[0]); return 2;
+        }
+    }
+    if (arquivo_roteiro && !carregarRoteiro(arquivo_roteiro))
+        return 2;
+    if (arquivo_reproducao && !reproducaoCarregar(arquivo_reproducao))
+        return 2;
+    int usb = arquivo_usb ? abrirUsb(arquivo_usb) : -1;
+    if (arquivo_usb && usb < 0)
+        return 2;
+
+    // A saída do jogo (printf) só aparece com -v
+    fflush(stdout);
+    int saida_original = dup(STDOUT_FILENO);
+    if (!verboso) {
+        int nulo = open("/dev/null", O_WRONLY);
+        dup2(nulo, STDOUT_FILENO);
+        close(nulo);
+    }
+
+    hostObservadores_t observadores = { arquivo_roteiro || arquivo_usb ? NULL : botQuadro, observarGpio };
+    if (arquivo_reproducao) // A sessão vai até o fim do rastro, com quantas partidas ele tiver
+        observadores = (hostObservadores_t){ NULL, NULL };
+    if (arquivo_registro) {
+        fwrite(REGISTRO_ASSINATURA, 1, 4, arquivo_registro);
+        registroDefinirSaida(gravarRegistro);
+    }
+    int vitorias = 0, derrotas = 0;
+    uint64_t quadros = 0, submetidos = 0, tempo_virtual_us = 0, tempo_fio_us = 0, niveis = 0;
+    uint64_t escalonado_us = 0, ocioso_us = 0, despertares = 0, registros = 0, registros_perdidos = 0;
+    uint64_t pausas = 0, pausa_us = 0, reduzido_us = 0, acordadas_pausa = 0;
+    uint64_t esperas = 0, espera_us = 0, espera_reduzido_us = 0;
+    uint64_t desenhos = 0, desenho_ns = 0, desenho_pior_ns = 0, composicoes = 0, pixels_compostos = 0;
+    histograma_t medidas[MEDIDAS_NUM]; // Histogramas de todas as sessões
+    for (int m = 0; m < MEDIDAS_NUM; ++m)
+        histogramaLimpar(&medidas[m]);
+    hostFlashFormatar(); // Cada sessão é um boot: o histórico do jogo passa de uma para a outra
+    double inicio = segundosReais();
+
+    for (int s = 0; s < sessoes; ++s) {
+        hostReiniciar(&observadores);
+        acertos = derrotas_sessao = 0;
+        vitoria = false;
+        n_memoria = n_entrada = 0;
+        ultimo_quadro = QUADRO_OUTRO;
+        semente_bot = 1 + s;
+        hostDefinirEntropia(semente_fixa ? semente_jogo : (uint32_t)(s + 1) * 0x9E3779B9u);
+        proxima_acao = 0;
+        hostDefinirPino(BUTTON_COR_1, true); // Botões soltos (pull-up)
+        hostDefinirPino(BUTTON_COR_2, true);
+        hostDefinirPino(JOYSTICK_SW, true);
+        if (sem_fim) { // Segura o botão A durante o boot
+            hostDefinirPino(BUTTON_COR_1, false);
+            hostAgendar(SEM_FIM_SEGURAR_MS * US_POR_MS, soltarBotaoA, NULL);
+        }
+        if (arquivo_reproducao) {
+            hostDefinirEntropia(reproducaoSemente());
+            reproducaoPreparar(atraso_reproducao_us);
+        }
+        hostAgendar(limite_us, limiteDeTempo, NULL);
+        if (arquivo_roteiro && n_roteiro > 0)
+            hostAgendar(roteiro[0].tempo_us, roteiroAcao, NULL);
+        hostDefinirUsb(usb);
+
+        memoryMatrixMain(); // Retorna quando a sessão é encerrada
+        while (registroDrenar()) // O que a sessão registrou depois do último tempo ocioso
+            ;
+        if (arquivo_rastro && !reproducaoGravar(arquivo_rastro))
+            return 2;
+
+        vitorias += vitoria;
+        derrotas += derrotas_sessao > 0;
+        niveis += acertos + (vitoria ? 0 : 1);
+        quadros += hostEstatisticas()->quadros;
+        submetidos += npGetStats().submitted;
+        tempo_fio_us += hostEstatisticas()->tempo_fio_us;
+        tempo_virtual_us += halTempoUs();
+        escalonadorEstatisticas_t e = escalonadorEstatisticas();
+        escalonado_us += e.total_us;
+        ocioso_us += e.ocioso_us;
+        despertares += e.despertares;
+        energiaEstatisticas_t en = energiaEstatisticas();
+        pausas += en.pausas;
+        pausa_us += en.pausa_us;
+        reduzido_us += en.reduzido_us;
+        acordadas_pausa += en.acordadas;
+        esperas += en.esperas;
+        espera_us += en.espera_us;
+        espera_reduzido_us += en.espera_reduzido_us;
+        registros += registroGravados();
+        registros_perdidos += registroPerdidos();
+        renderEstatisticas_t r = renderEstatisticas();
+        desenhos += r.quadros;
+        desenho_ns += r.ciclos;
+        if (r.pior > desenho_pior_ns)
+            desenho_pior_ns = r.pior;
+        compositorEstatisticas_t c = compositorEstatisticas();
+        composicoes += c.composicoes;
+        pixels_compostos += c.pixels;
+        for (int m = 0; m < MEDIDAS_NUM; ++m)
+            histogramaSomar(&medidas[m], medida((medida_t)m));
+    }
+    if (arquivo_registro)
+        fclose(arquivo_registro);
+
+    double real = segundosReais() - inicio;
+    fflush(stdout);
+    dup2(saida_original, STDOUT_FILENO);
+    close(saida_original);
+
+    double virtual_s = tempo_virtual_us / 1e6;
+    printf("sessoes=%d vitorias=%d derrotas=%d nivel_medio=%.2f\n", sessoes, vitorias, derrotas,
+           sessoes ? (double)niveis / sessoes : 0.0);
+    printf("tempo_virtual_s=%.1f tempo_real_s=%.3f aceleracao=%.0fx sessoes_por_s=%.0f\n", virtual_s, real,
+           real > 0 ? virtual_s / real : 0.0, real > 0 ? sessoes / real : 0.0);
+    printf("quadros_submetidos=%llu quadros_enviados=%llu fio_ocupado=%.2f%% custo_real_por_quadro_us=%.3f\n",
+           (unsigned long long)submetidos, (unsigned long long)quadros,
+           tempo_virtual_us ? 100.0 * tempo_fio_us / tempo_virtual_us : 0.0, submetidos ? real * 1e6 / submetidos : 0.0);
+    printf("desenhos=%llu desenho_medio_ns=%.0f desenho_pior_ns=%llu pixels_por_composicao=%.1f\n",
+           (unsigned long long)desenhos, desenhos ? (double)desenho_ns / desenhos : 0.0,
+           (unsigned long long)desenho_pior_ns, composicoes ? (double)pixels_compostos / composicoes : 0.0);
+    printf("leds=%d cadeias=%d tempo_por_quadro_us=%.0f\n", MOSAICO_PAINEIS * PAINEL_LEDS, MOSAICO_CADEIAS,
+           quadros ? (double)tempo_fio_us / quadros : 0.0);
+    printf("nucleo_ocioso=%.2f%% despertares_por_s=%.0f\n", escalonado_us ? 100.0 * ocioso_us / escalonado_us : 0.0,
+           escalonado_us ? despertares * 1e6 / escalonado_us : 0.0);
+    printf("pausas=%llu pausa_s=%.1f relogio_reduzido=%.2f%% despertares_na_pausa_por_s=%.1f despertar_max_us=%u\n",
+           (unsigned long long)pausas, pausa_us / 1e6, pausa_us ? 100.0 * reduzido_us / pausa_us : 0.0,
+           pausa_us ? acordadas_pausa * 1e6 / pausa_us : 0.0, medidas[MEDIDA_DESPERTAR].maximo);
+    printf("esperas_da_cor=%llu espera_s=%.1f espera_relogio_reduzido=%.2f%%\n", (unsigned long long)esperas,
+           espera_us / 1e6, espera_us ? 100.0 * espera_reduzido_us / espera_us : 0.0);
+    printf("registros=%llu registros_perdidos=%llu\n", (unsigned long long)registros,
+           (unsigned long long)registros_perdidos);
+    printf("reacao_direcao_p50_us=%u reacao_cor_p50_us=%u fio_max_us=%u atraso_tick_p99_us=%u atraso_tick_max_us=%u\n",
+           histogramaPercentil(&medidas[MEDIDA_REACAO_DIRECAO], 50), histogramaPercentil(&medidas[MEDIDA_REACAO_COR], 50),
+           medidas[MEDIDA_FIO].maximo, histogramaPercentil(&medidas[MEDIDA_ATRASO_TICK], 99),
+           medidas[MEDIDA_ATRASO_TICK].maximo);
+    const hostFlashEstatisticas_t *flash = hostFlashEstatisticas();
+    uint32_t apagamentos_min = UINT32_MAX, apagamentos_max = 0;
+    for (int setor = 0; setor < HAL_FLASH_SETORES; ++setor) {
+        if (flash->apagamentos[setor] < apagamentos_min)
+            apagamentos_min = flash->apagamentos[setor];
+        if (flash->apagamentos[setor] > apagamentos_max)
+            apagamentos_max = flash->apagamentos[setor];
+    }
+    printf("flash_paginas=%u flash_apagamentos_min=%u flash_apagamentos_max=%u\n", flash->paginas, apagamentos_min,
+           apagamentos_max);
+
+    if (arquivo_reproducao && reproducaoComparar(stdout, folga_reproducao_us) != 0) {
+        fprintf(stderr, "falha: a reprodução divergiu do rastro %s\n", arquivo_reproducao);
+        return 1;
+    }
+
+    // Sem erros propositais o jogador automático precisa vencer todas as sessões
+    if (!arquivo_roteiro && !arquivo_usb && !arquivo_reproducao && prob_erro == 0.0 && vitorias != sessoes) {
+        fprintf(stderr, "falha: %d de %d sessões sem vitória\n", sessoes - vitorias, sessoes);
+        return 1;
+    }
+    return 0;
+}
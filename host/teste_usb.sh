@@ -0,0 +1,29 @@
+#!/bin/sh
+# Simulador com o USB em um pseudo-terminal, em tempo real, e o bench_usb como computador;
+# depois lê os histogramas com o medidas_usb (o fio tem que ter amostras) e baixa o rastro com o
+# rastro_usb (tem que ter ao menos a semente).
+# uso: teste_usb.sh memoryMatrix2_host bench_usb medidas_usb rastro_usb
+simulador=$1
+bench=$2
+medidas=$3
+rastro=$4
+rm -f usb_teste.txt
+"$simulador" -u usb_teste.txt -t 30 > /dev/null &
+pid=$!
+for i in $(seq 50); do # O simulador grava o caminho do pseudo-terminal ao subir
+    [ -s usb_teste.txt ] && break
+    sleep 0.1
+done
+"$bench" "$(cat usb_teste.txt)" 500
+resultado=$?
+if [ $resultado -eq 0 ]; then
+    "$medidas" "$(cat usb_teste.txt)" > medidas_teste.txt && ! grep -q '^fio (us): amostras=0$' medidas_teste.txt
+    resultado=$?
+fi
+if [ $resultado -eq 0 ]; then
+    "$rastro" "$(cat usb_teste.txt)" rastro_usb_teste.bin > /dev/null && [ $(wc -c < rastro_usb_teste.bin) -ge 20 ]
+    resultado=$?
+fi
+kill $pid 2> /dev/null
+wait $pid 2> /dev/null
+exit $resultado
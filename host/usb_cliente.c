@@ -0,0 +1,126 @@
+#define _GNU_SOURCE // cfmakeraw
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include "usb_cliente.h"
+
+static int fd = -1;
+static protocoloDecodificador_t decodificador;
+static uint8_t recebido[PROTOCOLO_MAX_PAYLOAD];
+static struct {
+    bool chegou;
+    uint8_t tipo, seq;
+    uint32_t tamanho;
+    uint8_t payload[PROTOCOLO_MAX_PAYLOAD];
+} resposta;
+static uint32_t registros;
+
+double clienteAgoraUs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static uint8_t *destino(uint8_t tipo, uint32_t *capacidade) {
+    *capacidade = sizeof(recebido);
+    return recebido;
+}
+
+static void mensagem(uint8_t tipo, uint8_t seq, uint8_t *payload, uint32_t tamanho) {
+    if (tipo == PROTO_REGISTRO) {
+        registros++;
+        return;
+    }
+    resposta.chegou = true;
+    resposta.tipo = tipo;
+    resposta.seq = seq;
+    resposta.tamanho = tamanho;
+    memcpy(resposta.payload, payload, tamanho);
+}
+
+// Lê o que já chegou; espera até 'prazo_ms' por algo
+static void receber(int prazo_ms) {
+    struct pollfd p = { fd, POLLIN, 0 };
+    if (poll(&p, 1, prazo_ms) <= 0)
+        return;
+    uint8_t bloco[256];
+    ssize_t n = read(fd, bloco, sizeof(bloco));
+    if (n > 0)
+        protocoloReceber(&decodificador, bloco, (uint32_t)n);
+}
+
+bool clienteAbrir(const char *dispositivo) {
+    fd = open(dispositivo, O_RDWR | O_NOCTTY);
+    struct termios modo;
+    if (fd < 0 || tcgetattr(fd, &modo) != 0) {
+        perror(dispositivo);
+        return false;
+    }
+    cfmakeraw(&modo);
+    tcsetattr(fd, TCSANOW, &modo);
+    tcflush(fd, TCIOFLUSH);
+    protocoloIniciar(&decodificador, destino, mensagem);
+    registros = 0;
+    const uint8_t zero = 0;
+    return write(fd, &zero, 1) == 1; // Fecha qualquer mensagem que tenha ficado pela metade
+}
+
+void clienteEnviar(uint8_t tipo, uint8_t seq, const void *payload, uint32_t n) {
+    uint8_t fio[PROTOCOLO_MAX_FIO(PROTOCOLO_MAX_PAYLOAD)];
+    uint32_t total = protocoloCodificar(tipo, seq, payload, n, fio);
+    resposta.chegou = false;
+    for (uint32_t escritos = 0; escritos < total;) {
+        ssize_t r = write(fd, fio + escritos, total - escritos);
+        if (r <= 0) {
+            perror("write");
+            exit(1);
+        }
+        escritos += (uint32_t)r;
+        receber(0); // Não deixa as respostas encherem o caminho de volta
+    }
+}
+
+bool clienteEsperar(uint8_t tipo, uint8_t seq) {
+    double limite = clienteAgoraUs() + CLIENTE_ESPERA_MS * 1000.0;
+    while (clienteAgoraUs() < limite) {
+        if (resposta.chegou && resposta.tipo == tipo && resposta.seq == seq)
+            return true;
+        resposta.chegou = false;
+        receber(1);
+    }
+    return false;
+}
+
+const uint8_t *clienteResposta(uint32_t *tamanho) {
+    *tamanho = resposta.tamanho;
+    return resposta.payload;
+}
+
+bool clienteConsultar(uint8_t seq, protocoloEstado_t *estado) {
+    clienteEnviar(PROTO_CONSULTA, seq, NULL, 0);
+    if (!clienteEsperar(PROTO_ESTADO, seq) || resposta.tamanho != sizeof(*estado))
+        return false;
+    memcpy(estado, resposta.payload, sizeof(*estado));
+    return true;
+}
+
+void clientePausa(int ms) {
+    double limite = clienteAgoraUs() + ms * 1000.0;
+    while (clienteAgoraUs() < limite)
+        receber(1);
+}
+
+uint32_t clienteRegistros(void) {
+    return registros;
+}
+
+void clienteFechar(void) {
+    if (fd >= 0)
+        close(fd);
+    fd = -1;
+}
@@ -0,0 +1,24 @@
+#ifndef USB_CLIENTE_H
+#define USB_CLIENTE_H
+
+// Lado do computador do protocolo USB (protocolo.h), para as ferramentas do host: abre a placa
+// ou o pseudo-terminal do simulador em modo cru, envia mensagens e espera as respostas.
+// Registros (PROTO_REGISTRO) que chegam no meio do caminho são só contados.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "protocolo.h"
+
+#define CLIENTE_ESPERA_MS 1000 // Prazo de cada resposta
+
+bool clienteAbrir(const char *dispositivo);                                     // FALSE se não abriu
+void clienteEnviar(uint8_t tipo, uint8_t seq, const void *payload, uint32_t n); // Escreve tudo, lendo o que chega enquanto isso
+bool clienteEsperar(uint8_t tipo, uint8_t seq);                                  // Resposta 'tipo' com o mesmo seq
+const uint8_t *clienteResposta(uint32_t *tamanho);                              // Payload da última resposta
+bool clienteConsultar(uint8_t seq, protocoloEstado_t *estado);                  // PROTO_CONSULTA e a resposta
+void clientePausa(int ms);                                                      // Espera lendo o que chega
+uint32_t clienteRegistros(void);                                                // PROTO_REGISTRO recebidos
+double clienteAgoraUs(void);                                                    // Relógio monotônico
+void clienteFechar(void);
+
+#endif
@@ -0,0 +1,86 @@
+#include "hal.h"
+#include "joystick.h"
+
+#define CANAL_Y 0 // Posições pares do anel
+#define CANAL_X 1 // Posições ímpares do anel
+
+// Anel preenchido pelo DMA; o modo ring exige alinhamento ao tamanho em bytes
+static volatile uint16_t anel[JOYSTICK_ANEL] __attribute__((aligned(JOYSTICK_ANEL * sizeof(uint16_t))));
+
+static int16_t centro_x = 2048, centro_y = 2048; // Medidos na calibração
+static volatile int16_t desvio_x, desvio_y;      // Última média menos o centro
+static volatile Direcao direcao = CENTRO;        // Direção publicada para o jogo
+static uint8_t injetada = JOYSTICK_LOCAL;         // Direção imposta, ou JOYSTICK_LOCAL
+
+// Média das últimas 'janela' amostras de cada eixo, lidas para trás a partir da posição do DMA
+static void HAL_RAM(joystickMedia)(uint janela, int16_t *x, int16_t *y) {
+    uint pos = halAdcPosicao();
+    uint32_t soma[2] = {0, 0};
+    for (uint k = 1; k <= 2 * janela; ++k) {
+        uint i = (pos - k) & (JOYSTICK_ANEL - 1);
+        soma[i & 1] += anel[i]; // A paridade do índice diz o canal
+    }
+    *x = (int16_t)(soma[CANAL_X] / janela);
+    *y = (int16_t)(soma[CANAL_Y] / janela);
+}
+
+// Histerese: a direção atual só cai abaixo do limiar de saída; uma nova precisa passar do de entrada
+static Direcao HAL_RAM(joystickClassificar)(int dx, int dy, Direcao atual) {
+    switch (atual) {
+        case ESQUERDA: if (dx < -JOYSTICK_LIMIAR_SAI) return ESQUERDA; break;
+        case DIREITA:  if (dx > JOYSTICK_LIMIAR_SAI) return DIREITA; break;
+        case CIMA:     if (dy > JOYSTICK_LIMIAR_SAI) return CIMA; break;
+        case BAIXO:    if (dy < -JOYSTICK_LIMIAR_SAI) return BAIXO; break;
+        default: break;
+    }
+    if (dx < -JOYSTICK_LIMIAR_ENTRA) return ESQUERDA; // O eixo X tem prioridade, como na leitura antiga
+    if (dx > JOYSTICK_LIMIAR_ENTRA) return DIREITA;
+    if (dy > JOYSTICK_LIMIAR_ENTRA) return CIMA;
+    if (dy < -JOYSTICK_LIMIAR_ENTRA) return BAIXO;
+    return CENTRO;
+}
+
+// Temporizador (contexto de interrupção): filtra e publica a direção
+static void HAL_RAM(joystickAtualizar)(void) {
+    int16_t x, y;
+    joystickMedia(JOYSTICK_JANELA, &x, &y);
+    desvio_x = x - centro_x;
+    desvio_y = y - centro_y;
+    direcao = joystickClassificar(desvio_x, desvio_y, direcao);
+}
+
+// Inicia o rodízio dos canais 0 e 1 e mede o centro com o anel inteiro
+void joystickInit() {
+    halAdcContinuo((1u << CANAL_Y) | (1u << CANAL_X), JOYSTICK_TAXA_HZ, anel, JOYSTICK_ANEL);
+    halEsperaMs(JOYSTICK_CALIBRACAO_MS); // Enche o anel
+    joystickMedia(JOYSTICK_ANEL / 2, &centro_x, &centro_y);
+    direcao = CENTRO;
+    injetada = JOYSTICK_LOCAL;
+    desvio_x = 0;
+    desvio_y = 0;
+    halTimerPeriodico(JOYSTICK_PERIODO_US, joystickAtualizar);
+}
+
+Direcao joystickDirecao() {
+    return injetada != JOYSTICK_LOCAL ? (Direcao)injetada : direcao;
+}
+
+void joystickInjetar(uint8_t nova) {
+    injetada = nova;
+}
+
+// Sem conversões nem interrupções; na volta, o anel recomeça e a direção se refaz em poucos períodos
+void joystickPausar(bool pausado) {
+    halTimerPausar(joystickAtualizar, pausado);
+    halAdcPausar(pausado);
+}
+
+void joystickEixos(int16_t *x, int16_t *y) {
+    *x = desvio_x;
+    *y = desvio_y;
+}
+
+void joystickCentro(int16_t *x, int16_t *y) {
+    *x = centro_x;
+    *y = centro_y;
+}
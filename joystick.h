@@ -0,0 +1,35 @@
+#ifndef JOYSTICK_H
+#define JOYSTICK_H
+
+// Amostragem contínua do joystick: o ADC alterna sozinho entre os canais 0 (Y) e 1 (X) e o DMA
+// grava as conversões em um anel. Um temporizador tira a média das últimas amostras de cada eixo,
+// aplica a histerese e publica a direção; o jogo só lê uma variável, sem conversões no caminho.
+
+#include <stdint.h>
+
+#define JOYSTICK_TAXA_HZ 2000      // Conversões por segundo, somando os dois eixos
+#define JOYSTICK_ANEL 64           // Amostras no anel do DMA (potência de 2)
+#define JOYSTICK_JANELA 8          // Amostras de cada eixo na média (sobreamostragem)
+#define JOYSTICK_PERIODO_US 5000   // Intervalo entre atualizações da direção
+#define JOYSTICK_CALIBRACAO_MS 40  // Tempo de amostragem com o joystick solto para achar o centro
+#define JOYSTICK_LIMIAR_ENTRA 600  // Desvio do centro para reconhecer uma direção
+#define JOYSTICK_LIMIAR_SAI 300    // Desvio abaixo do qual a direção atual é abandonada
+#define JOYSTICK_LOCAL 0xFF        // joystickInjetar: volta à direção medida
+
+// Definição das direções possíveis do joystick
+typedef enum {
+    CIMA,    // Direção para cima
+    BAIXO,   // Direção para baixo
+    ESQUERDA, // Direção para a esquerda
+    DIREITA,  // Direção para a direita
+    CENTRO   // Direção central (neutra)
+} Direcao;
+
+void joystickInit(void);                      // Inicia a amostragem e calibra o centro (joystick solto)
+Direcao joystickDirecao(void);                // Última direção filtrada (ou a injetada)
+void joystickInjetar(uint8_t direcao);        // Direção imposta no lugar da medida (USB, reprodução de rastros); JOYSTICK_LOCAL desfaz
+void joystickPausar(bool pausado);            // Para o ADC e o temporizador (a direção fica a última), ou os religa
+void joystickEixos(int16_t *x, int16_t *y);   // Desvio filtrado de cada eixo em relação ao centro
+void joystickCentro(int16_t *x, int16_t *y);  // Centro medido na calibração
+
+#endif
@@ -0,0 +1,75 @@
+#include <string.h>
+#include "hal.h"
+#include "medidas.h"
+
+#define MEDIDAS_NOME(nome, texto, unidade) texto,
+static const char *const nomes[MEDIDAS_NUM] = { MEDIDAS(MEDIDAS_NOME) };
+#undef MEDIDAS_NOME
+#define MEDIDAS_UNIDADE(nome, texto, unidade) unidade,
+static const char *const unidades[MEDIDAS_NUM] = { MEDIDAS(MEDIDAS_UNIDADE) };
+#undef MEDIDAS_UNIDADE
+
+static histograma_t histogramas[MEDIDAS_NUM];
+
+void histogramaLimpar(histograma_t *h) {
+    memset(h, 0, sizeof(*h));
+    h->minimo = UINT32_MAX;
+}
+
+void HAL_RAM(histogramaAdicionar)(histograma_t *h, uint32_t valor) {
+    h->baldes[histogramaBalde(valor)]++;
+    h->amostras++;
+    h->soma += valor;
+    if (valor < h->minimo)
+        h->minimo = valor;
+    if (valor > h->maximo)
+        h->maximo = valor;
+}
+
+void histogramaSomar(histograma_t *destino, const histograma_t *origem) {
+    for (uint32_t b = 0; b < HISTOGRAMA_BALDES; ++b)
+        destino->baldes[b] += origem->baldes[b];
+    destino->amostras += origem->amostras;
+    destino->soma += origem->soma;
+    if (origem->minimo < destino->minimo)
+        destino->minimo = origem->minimo;
+    if (origem->maximo > destino->maximo)
+        destino->maximo = origem->maximo;
+}
+
+// Só há a resolução dos baldes: devolve o maior valor que cabe no balde onde o percentil cai
+uint32_t histogramaPercentil(const histograma_t *h, uint32_t percentual) {
+    if (h->amostras == 0)
+        return 0;
+    uint64_t alvo = ((uint64_t)h->amostras * percentual + 99) / 100; // Amostras até o percentil, arredondado para cima
+    uint64_t acumulado = 0;
+    for (uint32_t b = 0; b < HISTOGRAMA_BALDES; ++b) {
+        acumulado += h->baldes[b];
+        if (acumulado >= alvo && acumulado > 0) {
+            uint32_t limite = b == HISTOGRAMA_BALDES - 1 ? UINT32_MAX : (1u << b) - 1; // O último balde não tem teto
+            return limite < h->maximo ? limite : h->maximo;
+        }
+    }
+    return h->maximo;
+}
+
+void medidasInit() {
+    for (uint32_t m = 0; m < MEDIDAS_NUM; ++m)
+        histogramaLimpar(&histogramas[m]);
+}
+
+void HAL_RAM(medir)(medida_t m, uint32_t valor) {
+    histogramaAdicionar(&histogramas[m], valor);
+}
+
+const histograma_t *medida(medida_t m) {
+    return &histogramas[m];
+}
+
+const char *medidaNome(medida_t m) {
+    return nomes[m];
+}
+
+const char *medidaUnidade(medida_t m) {
+    return unidades[m];
+}
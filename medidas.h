@@ -0,0 +1,58 @@
+#ifndef MEDIDAS_H
+#define MEDIDAS_H
+
+// Instrumentação: histogramas de tamanho fixo com baldes em potências de 2. O balde b conta os
+// valores com b bits significativos ([2^(b-1), 2^b); o balde 0 só o zero), então registrar uma
+// amostra é uma contagem de zeros à esquerda e um incremento, sem divisão nem alocação, e 32
+// baldes cobrem de 1 us a mais de meia hora. Cada medida tem um único escritor (uma tarefa, a
+// interrupção de fim de quadro ou o núcleo da saída); quem lê para exibir pode ver um histograma
+// no meio de uma atualização, o que só desloca uma amostra.
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define HISTOGRAMA_BALDES 32
+
+// Medidas, com nome e unidade (us = microssegundos; ciclos = ciclos no Pico, ns no simulador)
+#define MEDIDAS(X)                                                                        \
+    X(MEDIDA_REACAO_DIRECAO, "reacao_direcao", "us") /* Início da espera até a direção */ \
+    X(MEDIDA_REACAO_COR, "reacao_cor", "us")         /* Direção até o toque da cor */     \
+    X(MEDIDA_FIO, "fio", "us")                       /* Quadro disparado até travar */    \
+    X(MEDIDA_ENVIO, "envio", "ciclos")               /* npFrameSubmit, com a espera do fio */ \
+    X(MEDIDA_JOYSTICK, "joystick", "ciclos")         /* lerJoystick */                    \
+    X(MEDIDA_ATRASO_TICK, "atraso_tick", "us")       /* Liberação até o início da tarefa de entrada */ \
+    X(MEDIDA_DESPERTAR, "despertar", "us")           /* Botão na pausa até o relógio cheio */
+
+#define MEDIDAS_ENUM(nome, texto, unidade) nome,
+typedef enum { MEDIDAS(MEDIDAS_ENUM) MEDIDAS_NUM } medida_t;
+#undef MEDIDAS_ENUM
+
+// Histograma: 152 bytes little-endian (também é o payload de PROTO_MEDIDA)
+typedef struct {
+    uint64_t soma;     // Soma das amostras (média = soma / amostras)
+    uint32_t amostras;
+    uint32_t minimo;   // UINT32_MAX sem amostras
+    uint32_t maximo;
+    uint32_t baldes[HISTOGRAMA_BALDES];
+} histograma_t;
+
+_Static_assert(sizeof(histograma_t) == 152, "histograma_t vai cru para o fio");
+
+// Balde de um valor: número de bits significativos, com os valores enormes no último
+static inline uint32_t histogramaBalde(uint32_t valor) {
+    uint32_t balde = valor ? 32 - (uint32_t)__builtin_clz(valor) : 0;
+    return balde < HISTOGRAMA_BALDES ? balde : HISTOGRAMA_BALDES - 1;
+}
+
+void histogramaLimpar(histograma_t *h);
+void histogramaAdicionar(histograma_t *h, uint32_t valor);
+void histogramaSomar(histograma_t *destino, const histograma_t *origem);
+uint32_t histogramaPercentil(const histograma_t *h, uint32_t percentual); // Limite superior do balde do percentil (até o máximo)
+
+void medidasInit(void);                             // Esvazia todos os histogramas
+void medir(medida_t medida, uint32_t valor);        // Uma amostra
+const histograma_t *medida(medida_t medida);        // Histograma de uma medida
+const char *medidaNome(medida_t medida);            // Nome curto (ex.: "reacao_cor")
+const char *medidaUnidade(medida_t medida);         // "us" ou "ciclos"
+
+#endif
@@ -1,25 +1,24 @@
 #include <stdio.h>
 #include <stdlib.h>
-#include <time.h>
-#include "pico/stdlib.h" // Biblioteca padrão do Pico SDK
-#include "hardware/pio.h"  // Biblioteca para usar o PIO (Programmable I/O)
-#include "hardware/clocks.h" // Biblioteca para controlar os clocks
-#include "hardware/gpio.h" // Biblioteca para controlar os GPIOs (General Purpose I/O)
-#include "hardware/adc.h"  // Biblioteca para usar o ADC (Analog-to-Digital Converter)
-#include "ws2818b.pio.h" // Biblioteca para controlar os LEDs WS2812B (NeoPixel) usando PIO
-
-// Definições de pinos
-#define LED_COUNT 25       // Número de LEDs na matriz
-#define LED_PIN 7          // Pino GPIO conectado aos LEDs
-#define JOYSTICK_VRX 27    // Pino GPIO conectado à saída VRx do joystick (eixo X)
-#define JOYSTICK_VRY 26    // Pino GPIO conectado à saída VRy do joystick (eixo Y)
-#define JOYSTICK_SW 22     // Pino GPIO conectado ao botão do joystick
-#define BUTTON_COR_1 5     // Pino GPIO conectado ao botão da cor 1
-#define BUTTON_COR_2 6     // Pino GPIO conectado ao botão da cor 2
-#define BUZZER_ACERTO 10   // Pino GPIO conectado ao buzzer de acerto
-#define BUZZER_ERRO 21     // Pino GPIO conectado ao buzzer de erro
-#define LED_ERRO 13        // Pino GPIO conectado ao LED de erro
-#define LED_ACERTO 11      // Pino GPIO conectado ao LED de acerto
+#include <string.h>
+#include "hal.h"      // Acesso ao hardware (Pico SDK ou simulador)
+#include "pinos.h"    // Definições de pinos
+#include "neopixel.h" // Driver dos LEDs WS2812B (NeoPixel) com PIO e DMA
+#include "sprites.h"  // Algarismos, setas e verificado pré-calculados
+#include "entrada.h"  // Eventos dos botões por interrupção
+#include "joystick.h" // Direção do joystick amostrada por DMA
+#include "escalonador.h" // Tarefas cooperativas
+#include "saida.h"    // LEDs e buzzers (no núcleo 1 no modo multinúcleo)
+#include "registro.h" // Mensagens em binário, formatadas só no tempo ocioso
+#include "sequencia.h" // Passos da partida, 4 bits cada
+#include "aleatorio.h" // Gerador xoshiro128** semeado pelo hardware
+#include "render.h"    // Gama, brilho e animações em ponto fixo
+#include "protocolo.h" // Mensagens binárias pelo USB
+#include "medidas.h"   // Histogramas de tempos de reação, do fio e do laço
+#include "armazem.h"   // Histórico persistente na flash
+#include "rastro.h"    // Entradas e saídas gravadas para a reprodução no simulador
+#include "energia.h"   // Relógio reduzido e joystick parado na pausa e na vez da cor
+#include "texto.h"     // Letreiro rolando para números de mais de um algarismo
 
 // Definições de cores
 #define COR_1_R 32        // Componente vermelha da cor 1
@@ -37,587 +36,849 @@
 #define COR_NUMERO_R 0       // Componente vermelha da cor do número
 #define COR_NUMERO_G 0       // Componente verde da cor do número
 #define COR_NUMERO_B 32       // Componente azul da cor do número
-
-// Definição do tipo enum para as direções
-typedef enum {
-    CIMA,    // Direção para cima
-    BAIXO,   // Direção para baixo
-    ESQUERDA, // Direção para a esquerda
-    DIREITA,  // Direção para a direita
-    CENTRO   // Direção central (neutra)
-} Direcao;
-
-// Definição da estrutura para representar um pixel (LED)
-struct pixel_t {
-    uint8_t G, R, B; // Componentes verde, vermelha e azul do pixel
-};
-typedef struct pixel_t pixel_t; // Cria um alias para a struct pixel_t
-typedef pixel_t npLED_t;       // Cria um alias para representar um LED NeoPixel
-
-// Variáveis globais
-npLED_t leds[LED_COUNT]; // Array para armazenar o estado de cada LED
-PIO np_pio;               // Instância do PIO que será utilizada
-uint sm;                 // State Machine do PIO
+#define COR_ENTRADA 12        // Componentes da seta escolhida pelo jogador (branca, sobre a barra)
+#define COR_PAUSA 16          // Componentes do sinal de pausa (branco, sobre a cena congelada)
+
+// Tempos do jogo
+#define MAX_SEQUENCIA 9           // Nível máximo do jogo (no modo sem fim, SEQUENCIA_MAX_PASSOS)
+#define TEMPO_LIMITE_MS 5000      // Tempo para cada direção e cada cor
+#define TICK_US 10000             // Período da tarefa de entrada: pausa e joystick respondem em até um tick
+#define QUADRO_PROGRESSO_US 50000 // Atualização da barra de progresso (cada LED acende em 4 quadros)
+#define QUADRO_ANIMACAO_US 20000  // Quadros durante os esmaecimentos das setas
+#define SETA_MS 500               // Cada seta fica acesa por 500ms
+#define ESMAECER_US 100000        // Entrada e saída de cada seta
+#define PAUSA_DORMIR_US 100000    // Da pausa até o relógio cair: o sinal de pausa já saiu para os LEDs
+#define TEXTO_PASSO_US 80000      // Passo do letreiro: 12,5 colunas por segundo
+
+// Enlace USB
+#define USB_BLOCO 64     // Bytes lidos do USB por vez
+#define USB_BLOCOS 8     // Blocos por execução da tarefa; o resto fica para a próxima
+#define USB_PRAZO_US 1000 // Quadros e consultas respondidos antes do próximo quadro nos LEDs
+
+// Chaves do armazém
+#define CHAVE_HISTORICO 0 // historico_t
 
 // Protótipos das funções
-void npInit(uint pin);                                                              // Inicializa os LEDs NeoPixel
-void npSetLED(const uint index, const uint8_t r, const uint8_t g, const uint8_t b); // Define a cor de um LED
-void npClear();                                                                   // Apaga todos os LEDs
-void npWrite();                                                                   // Envia os dados para os LEDs
-int getIndex(int x, int y);                                                        // Calcula o índice do LED na matriz
 Direcao lerJoystick();                                                              // Lê a direção do joystick
 bool lerBotaoCor1();                                                               // Lê o estado do botão da cor 1
 bool lerBotaoCor2();                                                               // Lê o estado do botão da cor 2
 bool lerBotaoJoystick();                                                           // Lê o estado do botão do joystick
-void tocarBuzzerEco(int buzzer_a_pin, int buzzer_b_pin);                           // Toca o buzzer com um efeito de eco
-void tocarBuzzerCoro(int buzzer_a_pin, int buzzer_b_pin);                           // Toca o buzzer em coro
-void feedback(int buzzer_a_pin, int buzzer_b_pin, int led_pin, int duracao_ms, bool is_acerto); // Fornece feedback visual e sonoro
-void mostrarSequencia(const Direcao *sequencia, const bool *cores, int tamanho); // Exibe a sequência de direções e cores
-bool verificarSequencia(const Direcao *sequencia_correta, const bool *cores_corretas, int tamanho); // Verifica se a sequência inserida está correta
 void desenharSeta(Direcao direcao, bool cor1, bool cor2);                         // Desenha uma seta na matriz de LEDs
-void mapearDirecaoNaMatriz(Direcao direcao, int r, int g, int b);                   // Mapeia uma direção para a matriz de LEDs
-void mostrarBarraProgresso(int progresso);                                       // Exibe uma barra de progresso na matriz de LEDs
+void mapearDirecaoNaMatriz(Direcao direcao, npLED_t cor, uint8_t intensidade);      // Mapeia uma direção para a matriz de LEDs
+void mostrarBarraProgresso(int32_t preenchido_q8);                               // Exibe uma barra de progresso na matriz de LEDs
 void desenharNumero(int numero, int r, int g, int b);                             // Desenha um número na matriz de LEDs
 void desenharCheckmark(int r, int g, int b);                                      // DEsenha um verificado
 
-// Funções de inicialização do PIO e manipulação da matriz
-void npInit(uint pin) {
-    uint offset = pio_add_program(pio0, &ws2818b_program); // Adiciona o programa PIO para controlar os LEDs WS2812B
-    np_pio = pio0;                                        // Seleciona o PIO0
-    sm = pio_claim_unused_sm(np_pio, false);             // Aloca uma State Machine não utilizada
-    if (sm < 0) {                                           // Se não encontrou no PIO0, tenta no PIO1
-        np_pio = pio1;
-        sm = pio_claim_unused_sm(np_pio, true);
-    }
-    ws2818b_program_init(np_pio, sm, offset, pin, 800000.f); // Inicializa a State Machine com o programa e a frequência
-    for (uint i = 0; i < LED_COUNT; ++i) {                    // Apaga todos os LEDs
-        leds[i].R = 0;
-        leds[i].G = 0;
-        leds[i].B = 0;
-    }
+// Estados do jogo. Cada estado tem um prazo; a tarefa de lógica é acordada no prazo ou por uma entrada.
+typedef enum {
+    ESTADO_NIVEL,     // Mostra o número do nível
+    ESTADO_SETA,      // Mostra uma seta da sequência
+    ESTADO_APAGADO,   // Matriz apagada entre as setas
+    ESTADO_PREPARAR,  // Intervalo antes da vez do jogador
+    ESTADO_DIRECAO,   // Espera a direção do passo atual
+    ESTADO_COR,       // Espera a cor do passo atual
+    ESTADO_SOM,       // Buzzer de acerto ou erro tocando
+    ESTADO_LUZ,       // LED de acerto ou erro aceso
+    ESTADO_ESPERA,    // Intervalo depois do resultado
+    ESTADO_VITORIA,   // Verificado depois do último nível
+    ESTADO_PAUSADO,   // Parado até um novo toque no botão do joystick
+    ESTADO_RETOMANDO  // Um segundo antes de voltar ao estado interrompido
+} Estado;
+
+// Sons de resultado: { frequência, duração, volume inicial, volume final, buzzers }
+static const somNota_t somEco[] = {  // Acerto: A, pausa, B mais agudo, cada um sumindo
+    {1319, 100, 200, 80, SOM_BUZZER_A}, {0, 50, 0, 0, 0}, {1760, 150, 200, 0, SOM_BUZZER_B}, {0}
+};
+static const somNota_t somCoro[] = { // Erro: A e B juntos, grave e constante
+    {233, 200, 255, 255, SOM_BUZZER_A | SOM_BUZZER_B}, {0}
+};
+
+// Tom de cada direção enquanto a seta é mostrada (indexado por Direcao): quanto mais alto, mais agudo
+static const somNota_t somSetas[4][2] = {
+    [CIMA]     = { {784, 300, 180, 0, SOM_BUZZER_A}, {0} },
+    [BAIXO]    = { {392, 300, 180, 0, SOM_BUZZER_A}, {0} },
+    [ESQUERDA] = { {523, 300, 180, 0, SOM_BUZZER_A}, {0} },
+    [DIREITA]  = { {659, 300, 180, 0, SOM_BUZZER_A}, {0} },
+};
+
+// Animações: intensidade das setas ao entrar e sair, e LEDs acesos (Q8) da barra de tempo
+static const animacao_t esmaecer = ANIMACAO(0, 255, ESMAECER_US);
+static const animacao_t progresso = ANIMACAO(0, LED_COUNT * RENDER_Q8, TEMPO_LIMITE_MS * 1000);
+
+// Estado do jogo, alterado só pela tarefa de lógica
+static struct {
+    Estado estado;
+    uint64_t inicio_us;               // Início do estado atual
+    uint64_t prazo_us;                // Fim do estado atual (ESCALONADOR_NUNCA = sem prazo)
+    int nivel;                        // Nível atual
+    int passo;                        // Passo da sequência sendo mostrado ou lido
+    bool sem_fim;                     // Modo sem fim: a sequência cresce até SEQUENCIA_MAX_PASSOS
+    sequencia_t sequencia;            // Direções e cores da partida (TRUE = cor 1)
+    Direcao input_direcao;            // Direção inserida no passo atual
+    bool joystick_solto;              // A direção só vale depois de o joystick passar pelo centro
+    uint64_t inicio_cor_us;           // Referência para o tempo de reação
+    bool acertou;                     // Resultado da rodada
+    Estado interrompido;              // Estado em que a pausa chegou
+    uint64_t interrompido_inicio_us;  // Início e prazo do estado interrompido
+    uint64_t interrompido_prazo_us;
+    uint64_t pausa_us;                // Início da pausa
+} jogo;
+
+// Histórico de todas as partidas desde a primeira, guardado na flash ao fim de cada uma
+typedef struct {
+    uint32_t partidas;       // Partidas terminadas (vitória ou derrota)
+    uint32_t vitorias;
+    uint32_t passos;         // Passos acertados
+    uint32_t reacoes;        // Cores inseridas
+    uint32_t reacao_ms;      // Soma dos tempos de reação à cor
+    uint16_t recorde;        // Maior nível concluído no modo normal
+    uint16_t recorde_sem_fim; // E no modo sem fim
+} historico_t;
+
+static historico_t historico;
+
+// Entradas coletadas pela tarefa de entrada e consumidas pela tarefa de lógica
+static struct {
+    bool pausa;       // Toque no botão do joystick
+    bool cor;         // Toque em um botão de cor
+    bool cor1;        // TRUE = cor 1
+    uint64_t cor_us;  // Instante do toque
+    Direcao direcao;  // Última direção lida
+} entradas;
+
+// Enlace USB: quadros crus, entradas injetadas e consultas de um computador (protocolo.h)
+static protocoloDecodificador_t usb;
+static struct {
+    bool ativo;       // Já chegou uma mensagem válida: os registros vão em binário pelo enlace
+    uint8_t botoes;   // Botões injetados que estão apertados (bit = Botao)
+    uint8_t seq;      // Sequência das mensagens que o jogo envia por conta própria
+    uint8_t payload[PROTOCOLO_MAX_PAYLOAD]; // Destino de tudo que não é quadro
+} enlace;
+
+static aleatorio_t gerador; // Semeado uma vez por boot; a semente vai para o registro
+static texto_t letreiro;    // Texto rolando na camada dos sprites
+static uint64_t letreiro_estado = ESCALONADOR_NUNCA; // Início do estado que começou o letreiro
+static uint32_t camadas_ocupadas; // Camadas publicadas com algum pixel (bit = camada_t)
+static int tarefa_entrada, tarefa_logica, tarefa_render, tarefa_usb; // Tarefas do escalonador
+#ifndef MM_MULTINUCLEO
+static int tarefa_saida; // LEDs e buzzers no próprio núcleo 0
+#endif
+
+// Funções de leitura do joystick e botões
+Direcao lerJoystick() {
+    uint32_t inicio = halCiclos();
+    Direcao direcao = joystickDirecao(); // Já filtrada pelo temporizador (ou injetada pelo USB); nenhuma conversão aqui
+    medir(MEDIDA_JOYSTICK, (halCiclos() - inicio) & HAL_CICLOS_MASCARA);
+    return direcao;
+}
+
+// Lê o estado do botão da cor 1
+bool lerBotaoCor1() {
+    return entradaPressionado(BOTAO_COR_1); // Retorna TRUE se o botão ESTÁ pressionado (estado filtrado)
 }
 
-// Define a cor de um LED específico
-void npSetLED(const uint index, const uint8_t r, const uint8_t g, const uint8_t b) {
-    leds[index].R = r; // Define o componente vermelho
-    leds[index].G = g; // Define o componente verde
-    leds[index].B = b; // Define o componente azul
+// Lê o estado do botão da cor 2
+bool lerBotaoCor2() {
+    return entradaPressionado(BOTAO_COR_2); // Retorna TRUE se o botão ESTÁ pressionado (estado filtrado)
 }
 
-// Apaga todos os LEDs
-void npClear() {
-    for (uint i = 0; i < LED_COUNT; ++i) // Itera sobre todos os LEDs
-        npSetLED(i, 0, 0, 0);               // Define a cor como preto (apagado)
+// Lê o estado do botão do joystick
+bool lerBotaoJoystick() {
+    return entradaPressionado(BOTAO_JOYSTICK_SW); // Retorna TRUE se o botão ESTÁ pressionado (estado filtrado)
 }
 
-// Envia os dados para os LEDs
-void npWrite() {
-    for (uint i = 0; i < LED_COUNT; ++i) {                  // Itera sobre todos os LEDs
-        pio_sm_put_blocking(np_pio, sm, leds[i].G);         // Envia o componente verde
-        pio_sm_put_blocking(np_pio, sm, leds[i].R);         // Envia o componente vermelho
-        pio_sm_put_blocking(np_pio, sm, leds[i].B);         // Envia o componente azul
-    }
-    sleep_us(100); // Pequena pausa para garantir a transmissão dos dados
+// Publica os pixels de leds[] cobertos por 'mascara' como o conteúdo de uma camada
+static void publicarCamada(camada_t camada, uint32_t mascara) {
+    if (!mascara && !(camadas_ocupadas & (1u << camada))) // Já está vazia: nem ocupa a fila
+        return;
+    uint16_t crc = 0xFFFF;
+    for (uint i = 0; i < LED_COUNT; ++i)
+        if (mascara & (1u << i))
+            crc = protocoloCrc(crc, (const uint8_t *)&leds[i], sizeof(npLED_t));
+    rastrear(halTempoUs(), RASTRO_CAMADA, camada, crc, mascara);
+    saidaCamada(camada, leds, mascara);
+    camadas_ocupadas = mascara ? camadas_ocupadas | (1u << camada) : camadas_ocupadas & ~(1u << camada);
+}
+
+// Esvazia uma camada: as de baixo voltam a aparecer
+static void apagarCamada(camada_t camada) {
+    publicarCamada(camada, 0);
+}
+
+// Desenha um sinal de verificado na matriz de LEDs
+void desenharCheckmark(int r, int g, int b) {
+    spriteDesenhar(spriteCheckmark, r, g, b);        // Desenha o sprite em leds[]
+    publicarCamada(CAMADA_SPRITE, spriteCheckmark); // Só os pixels do sprite cobrem o fundo
+}
+
+// Funções de manipulação da matriz
+void mapearDirecaoNaMatriz(Direcao direcao, npLED_t cor, uint8_t intensidade) {
+    uint32_t seta = (direcao >= CIMA && direcao <= DIREITA) ? spritesSetas[direcao] : 0; // Direção inválida esvazia a camada
+    renderSprite(seta, cor, intensidade); // Desenha a seta esmaecida em leds[]
+    publicarCamada(CAMADA_SPRITE, seta);
 }
 
-// Calcula o índice do LED na matriz, considerando o layout em zigue-zague
-int getIndex(int x, int y) {
-    if (y % 2 == 0) {                  // Se a linha for par
-        return 24 - (y * 5 + x);       // Calcula o índice da esquerda para a direita
-    } else {                             // Se a linha for ímpar
-        return 24 - (y * 5 + (4 - x)); // Calcula o índice da direita para a esquerda
+// Exibe uma barra de progresso no fundo da matriz; o LED da ponta acende aos poucos
+void mostrarBarraProgresso(int32_t preenchido_q8) {
+    static const npLED_t cor = { .G = COR_PROGRESSO_G, .R = COR_PROGRESSO_R, .B = COR_PROGRESSO_B };
+    publicarCamada(CAMADA_FUNDO, renderBarra(preenchido_q8, cor)); // LEDs acesos em Q8: 256 por LED
+}
+
+// Rola um texto na camada dos sprites. O letreiro começa junto com o estado atual e cada quadro
+// só dá os passos vencidos; o próximo quadro é agendado para o próximo passo
+static void mostrarTexto(const char *texto, uint32_t passo_us, bool repetir, int r, int g, int b) {
+    bool novo = letreiro_estado != jogo.inicio_us;
+    if (novo) { // Outro estado (ou o mesmo depois da pausa): recomeça com a matriz vazia
+        textoIniciar(&letreiro, texto, passo_us, repetir, jogo.inicio_us);
+        letreiro_estado = jogo.inicio_us;
     }
+    if (textoAtualizar(&letreiro, halTempoUs()) || novo) {
+        spriteDesenhar(textoMascara(&letreiro), r, g, b);
+        publicarCamada(CAMADA_SPRITE, textoMascara(&letreiro));
+    }
+    escalonadorAgendar(tarefa_render, textoProximo(&letreiro)); // TEXTO_SEM_QUADRO é ESCALONADOR_NUNCA
 }
 
-// Funções de leitura do joystick e botões
-Direcao lerJoystick() {
-    const int16_t centro = 2048;   // Valor central do ADC
-    const int16_t deadzone = 200; // Deadzone para evitar leituras imprecisas
-    int16_t vrx_value = adc_read();  // Lê o valor do ADC do eixo X
-    adc_select_input(0);             // Seleciona o pino do eixo X
-    int16_t vry_value = adc_read();  // Lê o valor do ADC do eixo Y
-    adc_select_input(1);             // Seleciona o pino do eixo Y
-
-    if (vrx_value < (centro - deadzone)) { // Se o valor do eixo X for menor que o centro menos a deadzone
-        return ESQUERDA;                     // Retorna ESQUERDA
-    } else if (vrx_value > (centro + deadzone)) { // Se o valor do eixo X for maior que o centro mais a deadzone
-        return DIREITA;                              // Retorna DIREITA
-    } else if (vry_value > (centro + deadzone)) { // Se o valor do eixo Y for maior que o centro mais a deadzone
-        return CIMA;                                 // Retorna CIMA
-    } else if (vry_value < (centro - deadzone)) { // Se o valor do eixo Y for menor que o centro menos a deadzone
-        return BAIXO;                                // Retorna BAIXO
-    } else {                                          // Se estiver dentro da deadzone
-        return CENTRO;                               // Retorna CENTRO
+// Desenha um número na matriz de LEDs: um algarismo parado, ou mais rolando
+void desenharNumero(int numero, int r, int g, int b) {
+    if (numero < 0 || numero > 9) {
+        char texto[12];
+        snprintf(texto, sizeof(texto), "%d", numero);
+        mostrarTexto(texto, TEXTO_PASSO_US, true, r, g, b);
+        return;
     }
+    spriteDesenhar(spritesDigitos[numero], r, g, b); // Desenha o algarismo em leds[]
+    publicarCamada(CAMADA_SPRITE, spritesDigitos[numero]);
 }
 
-// Lê o estado do botão da cor 1
-bool lerBotaoCor1() {
-    return !gpio_get(BUTTON_COR_1); // Retorna TRUE se o botão ESTÁ pressionado (nível baixo)
+// Fim da partida: o placar (níveis concluídos) e o recorde do modo rolam uma vez no tempo do estado
+static void mostrarPlacar(void) {
+    char texto[TEXTO_MAX + 1];
+    uint16_t placar = (uint16_t)(jogo.nivel - 1); // Até SEQUENCIA_MAX_PASSOS: cabe com o recorde em TEXTO_MAX
+    snprintf(texto, sizeof(texto), "%u R%u", placar, jogo.sem_fim ? historico.recorde_sem_fim : historico.recorde);
+    uint32_t passo_us = (uint32_t)(jogo.prazo_us - jogo.inicio_us) / textoColunas(texto); // Uma divisão por partida
+    apagarCamada(CAMADA_FUNDO);
+    mostrarTexto(texto, passo_us < TEXTO_PASSO_US ? passo_us : TEXTO_PASSO_US, false, COR_NUMERO_R, COR_NUMERO_G, COR_NUMERO_B);
 }
 
-// Lê o estado do botão da cor 2
-bool lerBotaoCor2() {
-    return !gpio_get(BUTTON_COR_2); // Retorna TRUE se o botão ESTÁ pressionado (nível baixo)
+// Troca de estado: marca o início, calcula o prazo e pede um novo quadro
+static void entrarEstado(Estado estado, uint32_t duracao_ms) {
+    jogo.estado = estado;
+    jogo.inicio_us = halTempoUs();
+    jogo.prazo_us = duracao_ms ? jogo.inicio_us + (uint64_t)duracao_ms * 1000 : ESCALONADOR_NUNCA;
+    rastrear(jogo.inicio_us, RASTRO_ESTADO, estado, (uint16_t)jogo.nivel, (uint32_t)jogo.passo);
+    escalonadorAcordar(tarefa_render);
 }
 
-// Lê o estado do botão do joystick
-bool lerBotaoJoystick() {
-    return !gpio_get(JOYSTICK_SW); // Retorna TRUE se o botão ESTÁ pressionado (nível baixo)
-}
-
-// Funções de feedback de som
-void tocarBuzzerEco(int buzzer_a_pin, int buzzer_b_pin) {
-    if (buzzer_a_pin != -1 && buzzer_b_pin != -1) { // Se os pinos do buzzer forem válidos
-        gpio_put(buzzer_a_pin, 1);                     // Liga o buzzer A
-        sleep_ms(100);                                 // Aguarda 100ms
-        gpio_put(buzzer_a_pin, 0);                     // Desliga o buzzer A
-        sleep_ms(50);                                  // Aguarda 50ms
-        gpio_put(buzzer_b_pin, 1);                     // Liga o buzzer B
-        sleep_ms(150);                                 // Aguarda 150ms
-        gpio_put(buzzer_b_pin, 0);                     // Desliga o buzzer B
+// Mostra o nível. A partida nova gera a sequência inteira de uma vez; cada nível mostra um passo a mais
+static void iniciarNivel(void) {
+    registrar(REG_NIVEL, jogo.nivel, 0); // Registra o nível atual
+    if (jogo.nivel == 1) {
+        sequenciaLimpar(&jogo.sequencia);
+        sequenciaGerar(&jogo.sequencia, &gerador, jogo.sem_fim ? SEQUENCIA_MAX_PASSOS : MAX_SEQUENCIA);
     }
+    entrarEstado(ESTADO_NIVEL, 2000); // Exibe o número do nível por 2 segundos
+}
+
+// Espera a direção do passo atual
+static void iniciarDirecao(void) {
+    registrar(REG_AGUARDA_DIRECAO, jogo.passo + 1, 0); // Registra mensagem
+    jogo.input_direcao = CENTRO;
+    jogo.joystick_solto = false;
+    entrarEstado(ESTADO_DIRECAO, TEMPO_LIMITE_MS);
+}
+
+// Mostra a seta do passo atual com o tom da sua direção
+static void mostrarSeta(void) {
+    saidaSom(somSetas[sequenciaDirecao(&jogo.sequencia, jogo.passo)]);
+    entrarEstado(ESTADO_SETA, SETA_MS);
 }
 
-// Toca o buzzer em coro
-void tocarBuzzerCoro(int buzzer_a_pin, int buzzer_b_pin) {
-    if (buzzer_a_pin != -1 && buzzer_b_pin != -1) { // Se os pinos do buzzer forem válidos
-        gpio_put(buzzer_a_pin, 1);                     // Liga o buzzer A
-        gpio_put(buzzer_b_pin, 1);                     // Liga o buzzer B
-        sleep_ms(200);                                 // Aguarda 200ms
-        gpio_put(buzzer_a_pin, 0);                     // Desliga o buzzer A
-        gpio_put(buzzer_b_pin, 0);                     // Desliga o buzzer B
+// Fim da rodada: som, depois o LED de acerto ou erro
+static void mostrarResultado(rastroVeredito_t veredito) {
+    rastrear(halTempoUs(), RASTRO_VEREDITO, veredito, (uint16_t)jogo.nivel, (uint32_t)jogo.passo);
+    jogo.acertou = veredito == RASTRO_CERTO;
+    if (jogo.acertou) {
+        registrar(REG_ACERTO, 0, 0); // Registra mensagem
+        entrarEstado(ESTADO_SOM, saidaSom(somEco));  // Toca o buzzer com efeito de eco
+    } else {
+        registrar(REG_ERRO, 0, 0);   // Registra mensagem de Game Over
+        entrarEstado(ESTADO_SOM, saidaSom(somCoro)); // Toca o buzzer em coro
     }
 }
 
-// Função de feedback unificada
-void feedback(int buzzer_a_pin, int buzzer_b_pin, int led_pin, int duracao_ms, bool is_acerto) {
-    if (is_acerto) {                                    // Se acertou
-        tocarBuzzerEco(buzzer_a_pin, buzzer_b_pin);   // Toca o buzzer com efeito de eco
-    } else {                                             // Se errou
-        tocarBuzzerCoro(buzzer_a_pin, buzzer_b_pin);   // Toca o buzzer em coro
+// O último nível foi concluído
+static bool venceu(void) {
+    return jogo.nivel > (jogo.sem_fim ? SEQUENCIA_MAX_PASSOS : MAX_SEQUENCIA);
+}
+
+// Fim da partida, com o LED do resultado já apagado: o histórico vai para a flash agora, entre uma
+// partida e outra, quando parar a flash não atrasa nenhuma entrada, som ou quadro
+static void guardarHistorico(bool venceu) {
+    uint16_t nivel = (uint16_t)(jogo.nivel - 1); // Último nível concluído
+    uint16_t *recorde = jogo.sem_fim ? &historico.recorde_sem_fim : &historico.recorde;
+    historico.partidas++;
+    historico.vitorias += venceu;
+    if (nivel > *recorde)
+        *recorde = nivel;
+    armazemGravar(CHAVE_HISTORICO, &historico, sizeof(historico));
+    armazemDescarregar();
+    registrar(REG_HISTORICO, historico.partidas, *recorde);
+}
+
+// Cor escolhida: confere o passo e segue para o próximo ou para o resultado
+static void conferirPasso(bool input_cor) {
+    int i = jogo.passo;
+    Direcao direcao = sequenciaDirecao(&jogo.sequencia, i);
+    bool cor = sequenciaCor(&jogo.sequencia, i);
+    registrar(REG_COR, input_cor, cor); // Registra a cor inserida e a correta
+    sequenciaResultado_t resultado = sequenciaConferir(&jogo.sequencia, i, jogo.input_direcao, input_cor);
+    if (resultado == SEQUENCIA_DIRECAO_ERRADA) { // Se a direção inserida for diferente da correta
+        registrar(REG_DIRECAO_INCORRETA, direcao, jogo.input_direcao); // Registra mensagem de erro
+        mostrarResultado(RASTRO_DIRECAO_ERRADA);
+    } else if (resultado == SEQUENCIA_COR_ERRADA) { // Se a cor inserida for diferente da correta
+        registrar(REG_COR_INCORRETA, cor, input_cor); // Registra mensagem de erro
+        mostrarResultado(RASTRO_COR_ERRADA);
+    } else if (++jogo.passo < jogo.nivel) { // Próximo passo
+        historico.passos++;
+        iniciarDirecao();
+    } else {
+        historico.passos++;
+        mostrarResultado(RASTRO_CERTO);
     }
+}
 
-    gpio_put(led_pin, 1);    // Liga o LED
-    sleep_ms(duracao_ms); // Aguarda o tempo especificado
-    gpio_put(led_pin, 0);    // Desliga o LED
+// Tempo ocupado de cada núcleo desde o boot (a saída é o núcleo 1 no modo multinúcleo)
+static void mostrarCarga(void) {
+    escalonadorEstatisticas_t nucleo0 = escalonadorEstatisticas();
+    saidaEstatisticas_t saida = saidaEstatisticas();
+    registrar(REG_CARGA, nucleo0.total_us ? 10000 * (nucleo0.total_us - nucleo0.ocioso_us) / nucleo0.total_us : 0,
+              saida.total_us ? 10000 * saida.ocupado_us / saida.total_us : 0); // Em centésimos de %
+    registrar(REG_DESCARTES, saida.descartados, registroPerdidos());
+    renderEstatisticas_t render = renderEstatisticas();
+    registrar(REG_RENDER, render.quadros ? (uint32_t)(render.ciclos / render.quadros) : 0, render.pior);
+    const histograma_t *reacao = medida(MEDIDA_REACAO_COR);
+    registrar(REG_REACAO_PERCENTIS, histogramaPercentil(reacao, 50), histogramaPercentil(reacao, 90));
+    const histograma_t *atraso = medida(MEDIDA_ATRASO_TICK);
+    registrar(REG_ATRASO_TICK, histogramaPercentil(atraso, 99), atraso->maximo);
 }
 
-void desenharCheckmark(int r, int g, int b) {
-    npClear();
-    npSetLED(getIndex(0, 2), r, g, b);
-    npSetLED(getIndex(1, 3), r, g, b);
-    npSetLED(getIndex(2, 4), r, g, b);
-    npSetLED(getIndex(3, 3), r, g, b);
-    npSetLED(getIndex(4, 1), r, g, b);
+// Pausa em qualquer estado; um novo toque retoma depois de 1 segundo
+static void alternarPausa(uint64_t agora) {
+    if (jogo.estado == ESTADO_PAUSADO) {
+        energiaRetomar();
+        escalonadorAgendar(tarefa_entrada, agora + TICK_US); // A entrada volta a ser periódica
+        energiaEstatisticas_t energia = energiaEstatisticas();
+        registrar(REG_RETOMADO, 0, 0); // Registra mensagem
+        registrar(REG_ENERGIA, (uint32_t)(energia.pausa_us / 1000),
+                  energia.pausa_us ? (uint32_t)(10000 * energia.reduzido_us / energia.pausa_us) : 0);
+        entrarEstado(ESTADO_RETOMANDO, 1000);
+        return;
+    }
+    if (jogo.estado != ESTADO_RETOMANDO) { // Toque durante a retomada volta a pausar o mesmo estado
+        jogo.interrompido = jogo.estado;
+        jogo.interrompido_inicio_us = jogo.inicio_us;
+        jogo.interrompido_prazo_us = jogo.prazo_us;
+        jogo.pausa_us = agora;
+    }
+    registrar(REG_PAUSADO, 0, 0); // Registra mensagem
+    mostrarCarga();
+    entrarEstado(ESTADO_PAUSADO, 0);
+    energiaPausar();
+    escalonadorAgendar(tarefa_entrada, agora + PAUSA_DORMIR_US); // Depois, só acordada pelos botões
+}
 
-    npWrite();
+// Volta ao estado interrompido; o tempo pausado não conta no prazo dele
+static void retomar(uint64_t agora) {
+    uint64_t pausado = agora - jogo.pausa_us;
+    jogo.estado = jogo.interrompido;
+    jogo.inicio_us = jogo.interrompido_inicio_us + pausado;
+    jogo.prazo_us = jogo.interrompido_prazo_us == ESCALONADOR_NUNCA ? ESCALONADOR_NUNCA : jogo.interrompido_prazo_us + pausado;
+    escalonadorAcordar(tarefa_render);
 }
 
-// Funções de manipulação da matriz
-void mapearDirecaoNaMatriz(Direcao direcao, int r, int g, int b) {
-    npClear(); // Apaga todos os LEDs
-    switch (direcao) {
-        case CIMA: // Se a direção for CIMA
-            npSetLED(getIndex(2, 0), r, g, b);
-            npSetLED(getIndex(1, 1), r, g, b);
-            npSetLED(getIndex(3, 1), r, g, b);
-            npSetLED(getIndex(2, 1), r, g, b);
-            npSetLED(getIndex(2, 2), r, g, b);
-            npSetLED(getIndex(2, 3), r, g, b);
-            npSetLED(getIndex(2, 4), r, g, b);
+// Um passo da máquina de estados: reage às entradas e aos prazos vencidos
+static void avancarJogo(uint64_t agora) {
+    bool vencido = agora >= jogo.prazo_us;
+    switch (jogo.estado) {
+        case ESTADO_PAUSADO:
+            break;
+        case ESTADO_RETOMANDO:
+            if (vencido) retomar(agora);
+            break;
+        case ESTADO_NIVEL:
+            if (vencido) {
+                jogo.passo = 0;
+                mostrarSeta();
+            }
+            break;
+        case ESTADO_SETA:
+            if (vencido) entrarEstado(ESTADO_APAGADO, 250); // Apaga por 250ms
+            break;
+        case ESTADO_APAGADO:
+            if (vencido) {
+                if (++jogo.passo < jogo.nivel) {
+                    mostrarSeta();
+                } else {
+                    registrar(REG_SUA_VEZ, 0, 0); // Registra mensagem
+                    registrar(REG_PREPARE, 0, 0); // Registra mensagem de preparação
+                    entrarEstado(ESTADO_PREPARAR, 500);
+                }
+            }
             break;
-        case BAIXO: // Se a direção for BAIXO
-            npSetLED(getIndex(2, 4), r, g, b);
-            npSetLED(getIndex(1, 3), r, g, b);
-            npSetLED(getIndex(3, 3), r, g, b);
-            npSetLED(getIndex(2, 3), r, g, b);
-            npSetLED(getIndex(2, 2), r, g, b);
-            npSetLED(getIndex(2, 1), r, g, b);
-            npSetLED(getIndex(2, 0), r, g, b);
+        case ESTADO_PREPARAR:
+            if (vencido) {
+                jogo.passo = 0;
+                iniciarDirecao();
+            }
             break;
-        case ESQUERDA: // Se a direção for ESQUERDA
-            npSetLED(getIndex(0, 2), r, g, b);
-            npSetLED(getIndex(1, 1), r, g, b);
-            npSetLED(getIndex(1, 3), r, g, b);
-            npSetLED(getIndex(1, 2), r, g, b);
-            npSetLED(getIndex(2, 2), r, g, b);
-            npSetLED(getIndex(3, 2), r, g, b);
-            npSetLED(getIndex(4, 2), r, g, b);
+        case ESTADO_DIRECAO:
+            if (entradas.direcao == CENTRO) // Joystick solto: a direção anterior não conta mais
+                jogo.joystick_solto = true;
+            if (jogo.joystick_solto && entradas.direcao != CENTRO) { // Nova direção inserida
+                jogo.input_direcao = entradas.direcao;
+                medir(MEDIDA_REACAO_DIRECAO, (uint32_t)(agora - jogo.inicio_us)); // Resolução de um tick
+                registrar(REG_DIRECAO, jogo.input_direcao, sequenciaDirecao(&jogo.sequencia, jogo.passo)); // Registra a direção inserida e a correta
+                registrar(REG_AGUARDA_COR, jogo.passo + 1, 0); // Registra mensagem
+                jogo.inicio_cor_us = agora;
+                entradas.cor = false; // Cores antecipadas são descartadas
+                entrarEstado(ESTADO_COR, TEMPO_LIMITE_MS);
+            } else if (vencido) {
+                registrar(REG_TEMPO_DIRECAO, 0, 0); // Registra mensagem de erro
+                mostrarResultado(RASTRO_TEMPO_DIRECAO);
+            }
             break;
-        case DIREITA: // Se a direção for DIREITA
-            npSetLED(getIndex(4, 2), r, g, b);
-            npSetLED(getIndex(3, 1), r, g, b);
-            npSetLED(getIndex(3, 3), r, g, b);
-            npSetLED(getIndex(3, 2), r, g, b);
-            npSetLED(getIndex(2, 2), r, g, b);
-            npSetLED(getIndex(1, 2), r, g, b);
-            npSetLED(getIndex(0, 2), r, g, b);
+        case ESTADO_COR:
+            if (entradas.cor && entradas.cor_us >= jogo.inicio_cor_us) {
+                entradas.cor = false;
+                registrar(REG_REACAO, (int32_t)(entradas.cor_us - jogo.inicio_cor_us), 0); // Carimbo da interrupção
+                medir(MEDIDA_REACAO_COR, (uint32_t)(entradas.cor_us - jogo.inicio_cor_us));
+                historico.reacoes++;
+                historico.reacao_ms += (uint32_t)((entradas.cor_us - jogo.inicio_cor_us) / 1000);
+                conferirPasso(entradas.cor1);
+            } else if (vencido) {
+                registrar(REG_TEMPO_COR, 0, 0); // Registra mensagem de erro
+                mostrarResultado(RASTRO_TEMPO_COR);
+            }
             break;
-        default: // Se a direção for inválida
-            npClear(); // Apaga todos os LEDs
+        case ESTADO_SOM:
+            if (vencido) { // O som terminou: acende o LED do resultado
+                halGpioEscrever(jogo.acertou ? LED_ACERTO : LED_ERRO, 1);
+                entrarEstado(ESTADO_LUZ, jogo.acertou ? 200 : 500);
+            }
+            break;
+        case ESTADO_LUZ:
+            if (vencido) {
+                halGpioEscrever(jogo.acertou ? LED_ACERTO : LED_ERRO, 0); // Desliga o LED
+                if (jogo.acertou) {
+                    jogo.nivel++;           // Aumenta o nível
+                    registrar(REG_PREPARE, 0, 0); // Registra mensagem
+                }
+                if (!jogo.acertou || venceu())
+                    guardarHistorico(jogo.acertou); // Fim da partida
+                entrarEstado(ESTADO_ESPERA, 2000); // Aguarda 2 segundos
+            }
+            break;
+        case ESTADO_ESPERA:
+            if (vencido) {
+                if (!jogo.acertou) {
+                    jogo.nivel = 1; // Reinicia o nível
+                    iniciarNivel();
+                } else if (venceu()) { // Se o jogador venceu o jogo (atingiu o nível máximo)
+                    registrar(REG_VITORIA, 0, 0); // Registra mensagem de vitória
+                    entrarEstado(ESTADO_VITORIA, 5000); // Mostra o verificado por 5 segundos
+                } else {
+                    iniciarNivel();
+                }
+            }
+            break;
+        case ESTADO_VITORIA:
+            if (vencido) {
+                jogo.nivel = 1;
+                iniciarNivel();
+            }
             break;
     }
-    npWrite(); // Envia os dados para os LEDs
 }
 
-// Exibe a sequência de direções e cores
-void mostrarSequencia(const Direcao *sequencia, const bool *cores, int tamanho) {
-    for (int i = 0; i < tamanho; i++) { // Itera sobre a sequência
-        if (cores[i]) {                   // Se a cor for a cor 1
-            mapearDirecaoNaMatriz(sequencia[i], COR_1_R, COR_1_G, COR_1_B); // Mapeia a direção com a cor 1
-        } else {                                                            // Se a cor for a cor 2
-            mapearDirecaoNaMatriz(sequencia[i], COR_2_R, COR_2_G, COR_2_B); // Mapeia a direção com a cor 2
-        }
-        sleep_ms(500); // Aguarda 500ms
-        npClear();     // Apaga todos os LEDs
-        npWrite();     // Envia os dados para os LEDs
-        sleep_ms(250); // Aguarda 250ms
+// Um toque para a lógica, dos botões ou injetado pelo USB
+static void registrarToque(Botao botao, uint64_t tempo_us) {
+    if (botao == BOTAO_JOYSTICK_SW) {
+        entradas.pausa = true;
+    } else if (!entradas.cor) { // Guarda o primeiro toque de cor ainda não consumido
+        entradas.cor = true;
+        entradas.cor1 = botao == BOTAO_COR_1; // Cor 1 = TRUE, cor 2 = FALSE
+        entradas.cor_us = tempo_us;
     }
 }
 
-// Exibe uma barra de progresso na matriz de LEDs
-void mostrarBarraProgresso(int progresso) {
-    npClear();                                                // Apaga todos os LEDs
-    int num_leds_acesos = (int)((float)progresso / 100.0 * LED_COUNT); // Calcula o número de LEDs a serem acesos
-    for (int i = 0; i < num_leds_acesos; i++) {                          // Itera sobre os LEDs a serem acesos
-        npSetLED(i, COR_PROGRESSO_R, COR_PROGRESSO_G, COR_PROGRESSO_B);   // Define a cor do LED
+// Tarefa de entrada (periódica): leva toques e direção do joystick para a lógica
+static void tarefaEntrada(void) {
+    energiaAcordar(); // Na pausa, a borda que acordou a tarefa é tratada com o relógio cheio
+    medir(MEDIDA_ATRASO_TICK, (uint32_t)(halTempoUs() - escalonadorLiberacao())); // Jitter do período
+    entradaEvento_t evento;
+    bool acordar = false;
+    while (entradaProximo(&evento)) {
+        rastrear(evento.tempo_us, RASTRO_BOTAO, evento.botao, evento.pressionado, 0); // Soltar também conta: a reprodução solta o pino
+        if (!evento.pressionado)
+            continue;
+        registrarToque(evento.botao, evento.tempo_us);
+        acordar = true;
     }
-    npWrite(); // Envia os dados para os LEDs
-}
-
-// Verifica se a sequência inserida está correta
-bool verificarSequencia(const Direcao *sequencia_correta, const bool *cores_corretas, int tamanho) {
-    printf("Prepare-se! \n"); // Imprime mensagem de preparação
-    sleep_ms(500);              // Aguarda 500ms
-
-    for (int i = 0; i < tamanho; i++) { // Itera sobre a sequência
-        Direcao input_direcao = CENTRO;    // Inicializa a direção inserida
-        bool input_cor = false;           // Inicializa a cor inserida
-        bool botao_pressionado = false;  // Inicializa o estado do botão
-        int tempo_limite = 5000;          // Define o tempo limite para a entrada
-        int tempo_inicio = to_ms_since_boot(get_absolute_time()); // Marca o tempo de início
-        int tempo_decorrido;          // Variável para armazenar o tempo decorrido
-        int progresso;                // Variável para armazenar o progresso
-
-        // 1. Ler Direção do Joystick
-        printf("Aguardando entrada do joystick para a direção %d...\n", i + 1); // Imprime mensagem
-        while (input_direcao == CENTRO && (tempo_decorrido = to_ms_since_boot(get_absolute_time()) - tempo_inicio) < tempo_limite) {
-            Direcao direcao_lida = lerJoystick(); // Lê a direção do joystick
-            if (direcao_lida != CENTRO) {         // Se a direção for diferente de CENTRO
-                input_direcao = direcao_lida;      // Define a direção inserida
-            }
-            sleep_ms(50); // Aguarda 50ms
-            progresso = (int)((float)tempo_decorrido / tempo_limite * 100); // Calcula o progresso
-            mostrarBarraProgresso(progresso); // Exibe a barra de progresso
-        }
-
-        if (input_direcao == CENTRO) { // Se o tempo limite for atingido sem nenhuma entrada
-            printf("Tempo esgotado para a direção!\n"); // Imprime mensagem de erro
-            mostrarBarraProgresso(0);                  // Apaga a barra de progresso
-            return false;                              // Retorna falso (errou)
-        }
-        printf("Direção inserida: %d, Direção correta: %d\n", input_direcao, sequencia_correta[i]); // Imprime a direção inserida e a correta
-
-        // 2. Ler Cor (Botão)
-        printf("Aguardando entrada do botão para a cor %d...\n", i + 1); // Imprime mensagem
-        tempo_inicio = to_ms_since_boot(get_absolute_time());            // Marca o tempo de início
-        while (!botao_pressionado && (tempo_decorrido = to_ms_since_boot(get_absolute_time()) - tempo_inicio) < tempo_limite) {
-            if (lerBotaoCor1()) {           // Se o botão da cor 1 for pressionado
-                input_cor = true;            // Define a cor inserida como TRUE
-                botao_pressionado = true;  // Define o estado do botão como TRUE
-            } else if (lerBotaoCor2()) {    // Se o botão da cor 2 for pressionado
-                input_cor = false;           // Define a cor inserida como FALSE
-                botao_pressionado = true;  // Define o estado do botão como TRUE
-            }
-            sleep_ms(50); // Aguarda 50ms
-            progresso = (int)((float)tempo_decorrido / tempo_limite * 100); // Calcula o progresso
-            mostrarBarraProgresso(progresso); // Exibe a barra de progresso
-        }
-
-        if (!botao_pressionado) {           // Se o tempo limite for atingido sem nenhuma entrada
-            printf("Tempo esgotado para a cor!\n"); // Imprime mensagem de erro
-            mostrarBarraProgresso(0);                  // Apaga a barra de progresso
-            return false;                              // Retorna falso (errou)
-        }
-
-        printf("Cor inserida: %s, Cor correta: %s\n", input_cor ? "Vermelho" : "Verde", cores_corretas[i] ? "Vermelho" : "Verde"); // Imprime a cor inserida e a correta
+    Direcao direcao = lerJoystick(); // Lê a direção do joystick
+    if (direcao != entradas.direcao) {
+        rastrear(halTempoUs(), RASTRO_DIRECAO, direcao, 0, 0);
+        entradas.direcao = direcao;
+        acordar = true;
+    }
+    if (acordar)
+        escalonadorAcordar(tarefa_logica);
+    if (energiaEconomizando()) { // Dorme com o relógio reduzido até a próxima borda de botão
+        energiaDormir();
+        escalonadorAgendar(tarefa_entrada, ESCALONADOR_NUNCA);
+    }
+}
 
-        if (input_direcao != sequencia_correta[i]) { // Se a direção inserida for diferente da correta
-            printf("Direcao incorreta! Esperado: %d, Recebido: %d\n", sequencia_correta[i], input_direcao); // Imprime mensagem de erro
-            mostrarBarraProgresso(0);                  // Apaga a barra de progresso
-            return false;                              // Retorna falso (errou)
-        }
+// Borda de botão durante a pausa ou a espera da cor (contexto de interrupção)
+static void acordarEntrada(void) {
+    escalonadorAcordarIrq(tarefa_entrada);
+}
 
-        if (input_cor != cores_corretas[i]) { // Se a cor inserida for diferente da correta
-            printf("Cor incorreta! Esperado: %s, Recebido: %s\n", cores_corretas[i] ? "Vermelho" : "Verde", input_cor ? "Vermelho" : "Verde"); // Imprime mensagem de erro
-            mostrarBarraProgresso(0);                  // Apaga a barra de progresso
-            return false;                              // Retorna falso (errou)
-        }
-        mostrarBarraProgresso(0); // Apaga a barra de progresso
+// Na vez da cor só os botões interessam: o joystick para e o relógio cai como na pausa, e o prazo
+// da cor continua com a lógica. Na vez da direção o joystick segue amostrando a cada tick
+static void economizarNaEspera(uint64_t agora) {
+    bool esperando = jogo.estado == ESTADO_COR;
+    if (esperando && !energiaEconomizando()) {
+        energiaEsperar(); // A entrada dorme no próximo tick
+    } else if (!esperando && jogo.estado != ESTADO_PAUSADO && energiaEconomizando()) {
+        energiaRetomar();
+        escalonadorAgendar(tarefa_entrada, agora + TICK_US); // A entrada volta a ser periódica
     }
+}
 
-    return true; // Retorna verdadeiro (acertou)
+// Tarefa de lógica (sob demanda): roda a máquina de estados até ela parar em um estado
+static void tarefaLogica(void) {
+    uint64_t agora = halTempoUs();
+    if (entradas.pausa) {
+        entradas.pausa = false;
+        alternarPausa(agora);
+    }
+    Estado anterior;
+    do {
+        anterior = jogo.estado;
+        avancarJogo(agora);
+    } while (jogo.estado != anterior);
+    entradas.cor = false; // Toques fora da vez de escolher a cor são descartados
+    economizarNaEspera(agora);
+    escalonadorAgendar(tarefa_logica, jogo.prazo_us); // Próximo prazo do jogo
 }
 
-// Desenha um número na matriz de LEDs
-void desenharNumero(int numero, int r, int g, int b) {
-    npClear(); // Apaga todos os LEDs
-    switch (numero) {
-        case 0: // Se o número for 0
-            npSetLED(getIndex(1, 0), r, g, b);
-            npSetLED(getIndex(2, 0), r, g, b);
-            npSetLED(getIndex(3, 0), r, g, b);
-            npSetLED(getIndex(0, 1), r, g, b);
-            npSetLED(getIndex(4, 1), r, g, b);
-            npSetLED(getIndex(0, 2), r, g, b);
-            npSetLED(getIndex(4, 2), r, g, b);
-            npSetLED(getIndex(0, 3), r, g, b);
-            npSetLED(getIndex(4, 3), r, g, b);
-            npSetLED(getIndex(1, 4), r, g, b);
-            npSetLED(getIndex(2, 4), r, g, b);
-            npSetLED(getIndex(3, 4), r, g, b);
+// Mostra o estado atual em camadas: barra de tempo no fundo, setas e algarismos por cima dela e o
+// sinal de pausa por cima de tudo. A barra de progresso e os esmaecimentos se redesenham sozinhos
+static void desenharEstado(void) {
+    static const npLED_t branco = { .G = COR_ENTRADA, .R = COR_ENTRADA, .B = COR_ENTRADA };
+    if (jogo.estado == ESTADO_PAUSADO) { // A cena do estado interrompido continua por baixo do sinal
+        spriteDesenhar(spritePausa, COR_PAUSA, COR_PAUSA, COR_PAUSA);
+        publicarCamada(CAMADA_HUD, spritePausa);
+        return;
+    }
+    apagarCamada(CAMADA_HUD);
+    switch (jogo.estado) {
+        case ESTADO_PAUSADO:
+        case ESTADO_RETOMANDO: // Mantém as camadas do estado interrompido
             break;
-        case 1: // Se o número for 1
-            npSetLED(getIndex(2, 0), r, g, b);
-            npSetLED(getIndex(1, 1), r, g, b);
-            npSetLED(getIndex(2, 1), r, g, b);
-            npSetLED(getIndex(2, 2), r, g, b);
-            npSetLED(getIndex(2, 3), r, g, b);
-            npSetLED(getIndex(2, 4), r, g, b);
+        case ESTADO_NIVEL:
+            apagarCamada(CAMADA_FUNDO);
+            desenharNumero(jogo.nivel, COR_NUMERO_R, COR_NUMERO_G, COR_NUMERO_B); // Exibe o número do nível (rolando, a partir do 10)
             break;
-        case 2: // Se o número for 2
-            npSetLED(getIndex(1, 0), r, g, b);
-            npSetLED(getIndex(2, 0), r, g, b);
-            npSetLED(getIndex(3, 0), r, g, b);
-            npSetLED(getIndex(4, 1), r, g, b);
-            npSetLED(getIndex(3, 2), r, g, b);
-            npSetLED(getIndex(2, 3), r, g, b);
-            npSetLED(getIndex(1, 4), r, g, b);
-            npSetLED(getIndex(0, 4), r, g, b);
-            npSetLED(getIndex(1, 4), r, g, b);
-            npSetLED(getIndex(2, 4), r, g, b);
-            npSetLED(getIndex(3, 4), r, g, b);
+        case ESTADO_SETA: {
+            static const npLED_t cor1 = { .G = COR_1_G, .R = COR_1_R, .B = COR_1_B };
+            static const npLED_t cor2 = { .G = COR_2_G, .R = COR_2_R, .B = COR_2_B };
+            uint64_t agora = halTempoUs();
+            uint64_t inicio_saida = jogo.prazo_us - ESMAECER_US;
+            apagarCamada(CAMADA_FUNDO);
+            int32_t entrada = animacaoValor(&esmaecer, agora - jogo.inicio_us);                       // Acendendo
+            int32_t saida = animacaoValor(&esmaecer, jogo.prazo_us > agora ? jogo.prazo_us - agora : 0); // Apagando
+            mapearDirecaoNaMatriz(sequenciaDirecao(&jogo.sequencia, jogo.passo),
+                                  sequenciaCor(&jogo.sequencia, jogo.passo) ? cor1 : cor2, // Cor 1 ou cor 2
+                                  (uint8_t)(entrada < saida ? entrada : saida));
+            // Quadros seguidos só durante os esmaecimentos; no meio, dorme até a saída começar
+            bool esmaecendo = agora < jogo.inicio_us + ESMAECER_US || agora >= inicio_saida;
+            escalonadorAgendar(tarefa_render, esmaecendo ? agora + QUADRO_ANIMACAO_US : inicio_saida);
             break;
-        case 3: // Se o número for 3
-            npSetLED(getIndex(1, 0), r, g, b);
-            npSetLED(getIndex(2, 0), r, g, b);
-            npSetLED(getIndex(3, 0), r, g, b);
-            npSetLED(getIndex(4, 1), r, g, b);
-            npSetLED(getIndex(2, 2), r, g, b);
-            npSetLED(getIndex(4, 3), r, g, b);
-            npSetLED(getIndex(1, 4), r, g, b);
-            npSetLED(getIndex(2, 4), r, g, b);
-            npSetLED(getIndex(3, 4), r, g, b);
+        }
+        case ESTADO_DIRECAO:
+        case ESTADO_COR: {
+            uint64_t agora = halTempoUs();
+            mostrarBarraProgresso(animacaoValor(&progresso, agora - jogo.inicio_us)); // Sem divisão nem float
+            if (jogo.estado == ESTADO_COR) // A direção escolhida fica à vista enquanto o tempo corre
+                mapearDirecaoNaMatriz(jogo.input_direcao, branco, 255);
+            else
+                apagarCamada(CAMADA_SPRITE);
+            escalonadorAgendar(tarefa_render, agora + QUADRO_PROGRESSO_US);
             break;
-        case 4: // Se o número for 4
-            npSetLED(getIndex(0, 0), r, g, b);
-            npSetLED(getIndex(4, 0), r, g, b);
-            npSetLED(getIndex(0, 1), r, g, b);
-            npSetLED(getIndex(4, 1), r, g, b);
-            npSetLED(getIndex(0, 2), r, g, b);
-            npSetLED(getIndex(1, 2), r, g, b);
-            npSetLED(getIndex(2, 2), r, g, b);
-            npSetLED(getIndex(3, 2), r, g, b);
-            npSetLED(getIndex(4, 2), r, g, b);
-            npSetLED(getIndex(4, 3), r, g, b);
-            npSetLED(getIndex(4, 4), r, g, b);
+        }
+        case ESTADO_ESPERA:
+            if (!jogo.acertou || venceu()) { // A partida acabou
+                mostrarPlacar();
+                break;
+            }
+            apagarCamada(CAMADA_FUNDO);
+            apagarCamada(CAMADA_SPRITE);
             break;
-        case 5: // Se o número for 5
-            npSetLED(getIndex(0, 0), r, g, b);
-            npSetLED(getIndex(1, 0), r, g, b);
-            npSetLED(getIndex(2, 0), r, g, b);
-            npSetLED(getIndex(3, 0), r, g, b);
-            npSetLED(getIndex(0, 1), r, g, b);
-            npSetLED(getIndex(0, 2), r, g, b);
-            npSetLED(getIndex(1, 2), r, g, b);
-            npSetLED(getIndex(2, 2), r, g, b);
-            npSetLED(getIndex(3, 3), r, g, b);
-            npSetLED(getIndex(4, 4), r, g, b);
-            npSetLED(getIndex(3, 4), r, g, b);
-            npSetLED(getIndex(2, 4), r, g, b);
+        case ESTADO_VITORIA:
+            apagarCamada(CAMADA_FUNDO);
+            desenharCheckmark(0, 32, 0); // Desenha o sinal de verificado verde
             break;
-        case 6: // Se o número for 6
-            npSetLED(getIndex(1, 0), r, g, b);
-            npSetLED(getIndex(2, 0), r, g, b);
-            npSetLED(getIndex(3, 0), r, g, b);
-            npSetLED(getIndex(0, 1), r, g, b);
-            npSetLED(getIndex(0, 2), r, g, b);
-            npSetLED(getIndex(1, 2), r, g, b);
-            npSetLED(getIndex(2, 2), r, g, b);
-             npSetLED(getIndex(0, 3), r, g, b);
-            npSetLED(getIndex(0, 4), r, g, b);
-            npSetLED(getIndex(1, 4), r, g, b);
-            npSetLED(getIndex(2, 4), r, g, b);
-            npSetLED(getIndex(3, 4), r, g, b);
+        default: // Apaga a matriz
+            apagarCamada(CAMADA_FUNDO);
+            apagarCamada(CAMADA_SPRITE);
             break;
-        case 7: // Se o número for 7
-            npSetLED(getIndex(0, 0), r, g, b);
-            npSetLED(getIndex(1, 0), r, g, b);
-            npSetLED(getIndex(2, 0), r, g, b);
-            npSetLED(getIndex(3, 0), r, g, b);
-            npSetLED(getIndex(4, 0), r, g, b);
-            npSetLED(getIndex(4, 1), r, g, b);
-            npSetLED(getIndex(3, 2), r, g, b);
-            npSetLED(getIndex(2, 3), r, g, b);
-            npSetLED(getIndex(1, 4), r, g, b);
+    }
+}
+
+// Tarefa de desenho (sob demanda), com o custo de cada quadro medido em ciclos
+static void tarefaRender(void) {
+    uint32_t inicio = halCiclos();
+    desenharEstado();
+    renderMedir((halCiclos() - inicio) & HAL_CICLOS_MASCARA);
+}
+
+// Envia uma mensagem pelo USB, inteira ou nada: metade de uma mensagem estragaria a seguinte.
+// FALSE se o computador não está lendo e a mensagem não coube (ela é descartada)
+static bool usbEnviar(uint8_t tipo, uint8_t seq, const void *payload, uint32_t n) {
+    uint8_t fio[PROTOCOLO_MAX_FIO(PROTOCOLO_MAX_PAYLOAD)];
+    uint32_t tamanho = protocoloCodificar(tipo, seq, payload, n, fio);
+    if (halUsbLivre() < tamanho)
+        return false;
+    halUsbEscrever(fio, tamanho);
+    return true;
+}
+
+// Saída do registro com o enlace ativo: o texto no console atrapalharia o protocolo
+static bool usbRegistro(const registro_t *registro) {
+    if (!usbEnviar(PROTO_REGISTRO, enlace.seq, registro, sizeof(*registro)))
+        return false; // Fica no anel para o próximo tempo ocioso
+    enlace.seq++;
+    return true;
+}
+
+// Quadros vão direto para um slot da fila de quadros remotos; o resto, para o buffer do enlace
+static uint8_t *usbDestino(uint8_t tipo, uint32_t *capacidade) {
+    if (tipo == PROTO_QUADRO) {
+        *capacidade = sizeof(npLED_t) * LED_COUNT;
+        return (uint8_t *)saidaRemotoReservar(); // NULL com a fila cheia: a mensagem é descartada
+    }
+    *capacidade = sizeof(enlace.payload);
+    return enlace.payload;
+}
+
+_Static_assert(PROTO_DIRECAO_LOCAL == JOYSTICK_LOCAL, "a direção do USB vai direto para o joystick");
+
+// Botões injetados: cada bit que passa de 0 para 1 é um toque, como uma borda no pino
+static void usbEntrada(const protocoloEntrada_t *entrada) {
+    uint8_t botoes = entrada->botoes & ((1u << NUM_BOTOES) - 1); // Bits sem botão são ignorados
+    uint8_t apertados = botoes & ~enlace.botoes;
+    uint8_t mudaram = botoes ^ enlace.botoes;
+    uint64_t agora = halTempoUs();
+    enlace.botoes = botoes;
+    joystickInjetar(entrada->direcao);
+    for (uint botao = 0; botao < NUM_BOTOES; ++botao)
+        if (mudaram & (1u << botao)) // No rastro, como as bordas de um pino
+            rastrear(agora, RASTRO_BOTAO, (uint8_t)botao, (apertados >> botao) & 1u, 0);
+    for (uint botao = 0; botao < NUM_BOTOES; ++botao)
+        if (apertados & (1u << botao))
+            registrarToque((Botao)botao, agora);
+    escalonadorAcordar(tarefa_entrada); // A direção nova vale já, sem esperar o tick
+    if (apertados)
+        escalonadorAcordar(tarefa_logica);
+}
+
+// Uma parte do rastro a partir do evento 'primeiro' (nenhum evento depois do fim)
+static void usbRastro(uint8_t seq, uint16_t primeiro) {
+    uint8_t parte[sizeof(protocoloRastro_t) + PROTOCOLO_RASTRO_EVENTOS * sizeof(rastroEvento_t)];
+    uint32_t total = rastroTamanho();
+    uint32_t n = primeiro < total ? total - primeiro : 0;
+    n = n < PROTOCOLO_RASTRO_EVENTOS ? n : PROTOCOLO_RASTRO_EVENTOS;
+    protocoloRastro_t cabecalho = { (uint16_t)total, primeiro, rastroPerdidos() };
+    memcpy(parte, &cabecalho, sizeof(cabecalho));
+    if (n)
+        memcpy(parte + sizeof(cabecalho), rastroEventos() + primeiro, n * sizeof(rastroEvento_t));
+    usbEnviar(PROTO_RASTRO_PARTE, seq, parte, sizeof(cabecalho) + n * sizeof(rastroEvento_t));
+}
+
+static void usbEstado(uint8_t seq) {
+    saidaEstatisticas_t saida = saidaEstatisticas();
+    protocoloEstado_t estado = {
+        .tempo_us = (uint32_t)halTempoUs(),
+        .remotos = saida.remotos,
+        .remotos_perdidos = saida.remotos_perdidos,
+        .quadros = saida.quadros,
+        .erros = usb.estatisticas.erros,
+        .registros_perdidos = registroPerdidos(),
+        .nivel = (uint16_t)jogo.nivel,
+        .passo = (uint16_t)jogo.passo,
+        .estado = (uint8_t)jogo.estado,
+        .pausado = jogo.estado == ESTADO_PAUSADO,
+        .sem_fim = jogo.sem_fim,
+        .remoto = saidaRemotoAtivo(),
+    };
+    usbEnviar(PROTO_ESTADO, seq, &estado, sizeof(estado));
+}
+
+static void usbMensagem(uint8_t tipo, uint8_t seq, uint8_t *payload, uint32_t tamanho) {
+    if (!enlace.ativo) { // Do primeiro contato em diante, nada de texto no USB
+        enlace.ativo = true;
+        registroDefinirSaida(usbRegistro);
+    }
+    switch (tipo) {
+        case PROTO_QUADRO: // Um quadro com outro tamanho deixa o slot reservado para o próximo
+            if (tamanho == 0 || tamanho == sizeof(npLED_t) * LED_COUNT)
+                saidaRemotoPublicar(tamanho != 0);
+            break;
+        case PROTO_ENTRADA:
+            if (tamanho == sizeof(protocoloEntrada_t))
+                usbEntrada((const protocoloEntrada_t *)payload);
             break;
-        case 8: // Se o número for 8
-            npSetLED(getIndex(1, 0), r, g, b);
-            npSetLED(getIndex(2, 0), r, g, b);
-            npSetLED(getIndex(3, 0), r, g, b);
-            npSetLED(getIndex(0, 1), r, g, b);
-             npSetLED(getIndex(4, 1), r, g, b);
-            npSetLED(getIndex(0, 2), r, g, b);
-            npSetLED(getIndex(1, 2), r, g, b);
-            npSetLED(getIndex(2, 2), r, g, b);
-            npSetLED(getIndex(3, 2), r, g, b);
-            npSetLED(getIndex(4, 2), r, g, b);
-            npSetLED(getIndex(0, 3), r, g, b);
-            npSetLED(getIndex(4, 3), r, g, b);
-            npSetLED(getIndex(1, 4), r, g, b);
-            npSetLED(getIndex(2, 4), r, g, b);
-            npSetLED(getIndex(3, 4), r, g, b);
+        case PROTO_CONSULTA:
+            usbEstado(seq);
             break;
-        case 9: // Se o número for 9
-             npSetLED(getIndex(1, 0), r, g, b);
-            npSetLED(getIndex(2, 0), r, g, b);
-            npSetLED(getIndex(3, 0), r, g, b);
-            npSetLED(getIndex(0, 1), r, g, b);
-             npSetLED(getIndex(4, 1), r, g, b);
-            npSetLED(getIndex(0, 2), r, g, b);
-            npSetLED(getIndex(1, 2), r, g, b);
-            npSetLED(getIndex(2, 2), r, g, b);
-            npSetLED(getIndex(3, 2), r, g, b);
-            npSetLED(getIndex(4, 2), r, g, b);
-            npSetLED(getIndex(4, 3), r, g, b);
-            npSetLED(getIndex(1, 4), r, g, b);
-            npSetLED(getIndex(2, 4), r, g, b);
-            npSetLED(getIndex(3, 4), r, g, b);
+        case PROTO_ECO:
+            usbEnviar(PROTO_ECO, seq, payload, tamanho);
             break;
-        default: // Se o número for inválido
-            npClear(); // Apaga todos os LEDs
+        case PROTO_RASTRO:
+            if (tamanho == 2)
+                usbRastro(seq, (uint16_t)(payload[0] | payload[1] << 8));
+            break;
+        case PROTO_MEDIDAS: // Cópia do histograma: ele pode mudar durante a codificação
+            if (tamanho == 1 && payload[0] < MEDIDAS_NUM) {
+                histograma_t h = *medida((medida_t)payload[0]);
+                usbEnviar(PROTO_MEDIDA, seq, &h, sizeof(h));
+            } else {
+                usbEnviar(PROTO_MEDIDA, seq, NULL, 0);
+            }
             break;
     }
-    npWrite(); // Envia os dados para os LEDs
 }
 
+// Tarefa do USB (sob demanda): decodifica o que chegou, um pedaço limitado por vez
+static void tarefaUsb(void) {
+    uint8_t bloco[USB_BLOCO];
+    for (uint i = 0; i < USB_BLOCOS; ++i) {
+        uint n = halUsbLer(bloco, sizeof(bloco));
+        if (n == 0)
+            return;
+        protocoloReceber(&usb, bloco, n);
+    }
+    escalonadorAcordar(tarefa_usb); // Ainda pode haver bytes: continua depois das outras tarefas liberadas
+}
+
+// Chegaram bytes no USB (contexto de interrupção)
+static void usbChegou(void) {
+    escalonadorAcordarIrq(tarefa_usb);
+}
+
+#ifndef MM_MULTINUCLEO
+// Tarefa de saída (só no modo de um núcleo): consome os comandos de quadro e som
+static void tarefaSaida(void) {
+    escalonadorAgendar(tarefa_saida, saidaPasso());
+}
+
+// Acorda a tarefa de saída quando o jogo publica um comando
+static void acordarSaida(void) {
+    escalonadorAcordar(tarefa_saida);
+}
+#endif
+
 int main() {
-    stdio_init_all(); // Inicializa a E/S padrão (stdio)
+    halInit(); // Inicializa a E/S padrão (stdio)
+    medidasInit(); // Antes dos LEDs: o fim de cada quadro já é medido
 
     // Inicializa os pinos do joystick
-    gpio_init(JOYSTICK_VRX);
-    gpio_init(JOYSTICK_VRY);
-    gpio_init(JOYSTICK_SW);
+    halGpioInit(JOYSTICK_VRX, HAL_ENTRADA);
+    halGpioInit(JOYSTICK_VRY, HAL_ENTRADA);
+    halGpioInit(JOYSTICK_SW, HAL_ENTRADA);
 
     // Inicializa os pinos dos botões de cor
-    gpio_init(BUTTON_COR_1);
-    gpio_init(BUTTON_COR_2);
-
-    // Inicializa os pinos dos buzzers e LEDs de feedback
-
-    gpio_init(BUZZER_ACERTO);
-    gpio_init(BUZZER_ERRO);
-    gpio_init(LED_ERRO);
-    gpio_init(LED_ACERTO);
-
-    // Define a direção dos pinos (ENTRADA ou SAÍDA)
-    gpio_set_dir(JOYSTICK_VRX, GPIO_IN);
-    gpio_set_dir(JOYSTICK_VRY, GPIO_IN);
-    gpio_set_dir(JOYSTICK_SW, GPIO_IN);
-    gpio_set_dir(BUTTON_COR_1, GPIO_IN);
-    gpio_set_dir(BUTTON_COR_2, GPIO_IN);
-    gpio_set_dir(BUZZER_ACERTO, GPIO_OUT);
-    gpio_set_dir(BUZZER_ERRO, GPIO_OUT);
-    gpio_set_dir(LED_ERRO, GPIO_OUT);
-    gpio_set_dir(LED_ACERTO, GPIO_OUT);
+    halGpioInit(BUTTON_COR_1, HAL_ENTRADA);
+    halGpioInit(BUTTON_COR_2, HAL_ENTRADA);
+
+    // Inicializa os pinos dos LEDs de feedback (os buzzers vão para o PWM em saidaInit)
+    halGpioInit(LED_ERRO, HAL_SAIDA);
+    halGpioInit(LED_ACERTO, HAL_SAIDA);
 
     // Ativa o resistor pull-up interno para o botão do joystick
-    gpio_pull_up(JOYSTICK_SW);
+    halGpioPullUp(JOYSTICK_SW);
 
     // Ativa o resistor pull-up interno para os botões de cor
-    gpio_pull_up(BUTTON_COR_1);
-    gpio_pull_up(BUTTON_COR_2);
+    halGpioPullUp(BUTTON_COR_1);
+    halGpioPullUp(BUTTON_COR_2);
+    jogo.sem_fim = !halGpioLer(BUTTON_COR_1); // Botão A segurado ao ligar: modo sem fim
 
-    // Inicializa o ADC (Analog-to-Digital Converter)
-    adc_init();
-    adc_gpio_init(JOYSTICK_VRY); // Inicializa o pino do joystick Y para leitura analógica
-    adc_gpio_init(JOYSTICK_VRX); // Inicializa o pino do joystick X para leitura analógica
-    adc_select_input(1);         // Seleciona o pino do joystick Y como entrada do ADC
-
-    // Inicializa os LEDs NeoPixel
-    npInit(LED_PIN);
-    npClear(); // Apaga todos os LEDs
-    npWrite(); // Envia os dados (apagados) para os LEDs
-
-    // Inicializa o gerador de números aleatórios com o tempo atual
-    srand(time(NULL));
-
-    // Variáveis do jogo
-    int nivel = 1;                 // Nível inicial do jogo
-    const int MAX_SEQUENCIA = 9;   // Nível máximo do jogo
-    bool paused = false;             // Indica se o jogo está pausado
-
-    // Loop principal do jogo
-    while (true) {
-        // Verifica se o botão do joystick foi pressionado
-        if (lerBotaoJoystick()) {
-            paused = !paused; // Inverte o estado da pausa
-            if (paused) {      // Se o jogo foi pausado
-                printf("Jogo pausado!\n"); // Imprime mensagem
-            } else {                      // Se o jogo foi retomado
-                printf("Jogo retomado!\n"); // Imprime mensagem
-                sleep_ms(1000);            // Aguarda 1 segundo
-            }
-            sleep_ms(200); // Pequena pausa para evitar leituras múltiplas do botão
-        }
+    // Habilita as interrupções dos botões
+    entradaInit();
 
-        // Se o jogo não está pausado
-        if (!paused) {
-            printf("Nível: %d\n", nivel);                                          // Imprime o nível atual
-            desenharNumero(nivel, COR_NUMERO_R, COR_NUMERO_G, COR_NUMERO_B); // Exibe o número do nível na matriz de LEDs
-            sleep_ms(2000);                                                       // Aguarda 2 segundos
-
-            // Cria a sequência de direções e cores
-            Direcao sequencia[MAX_SEQUENCIA];
-            bool cores[MAX_SEQUENCIA];
-            for (int i = 0; i < nivel; i++) {
-                sequencia[i] = (Direcao)(rand() % 4); // Gera uma direção aleatória
-                cores[i] = rand() % 2;                  // Gera uma cor aleatória (0 ou 1)
-            }
-
-            mostrarSequencia(sequencia, cores, nivel); // Exibe a sequência
-
-            printf("Sua vez!\n"); // Imprime mensagem
-            bool acertou = verificarSequencia(sequencia, cores, nivel); // Verifica se a sequência inserida está correta
-
-            // Se o jogador acertou
-            if (acertou) {
-                printf("Parabéns! Próximo nível.\n");        // Imprime mensagem
-                feedback(BUZZER_ACERTO, BUZZER_ERRO, LED_ACERTO, 200, true); // Fornece feedback de acerto
-                nivel++;                                         // Aumenta o nível
-                printf("Prepare-se\n");                            // Imprime mensagem
-                sleep_ms(2000);                                      // Aguarda 2 segundos
-
-                // Se o jogador venceu o jogo (atingiu o nível máximo)
-                if (nivel > MAX_SEQUENCIA) {
-                    printf("Você venceu o jogo!\n"); // Imprime mensagem de vitória
-                    desenharCheckmark(0, 32 , 0); // Desenha o sinal de verificado verde
-                    sleep_ms(5000); // Mostra por 5 segundos
-                    npClear(); // Apaga a matriz
-                    npWrite();
-                    nivel = 1;
-                }
-            } else { // Se o jogador errou
-                printf("Errou! Game Over.\n");                                 // Imprime mensagem de Game Over
-                feedback(BUZZER_ACERTO, BUZZER_ERRO, LED_ERRO, 500, false); // Fornece feedback de erro
-                sleep_ms(2000);                                               // Aguarda 2 segundos
-                nivel = 1;                                                    // Reinicia o nível
-            }
-        } else {          // Se o jogo está pausado
-            sleep_ms(100); // Aguarda 100ms
-        }
-    }
+    // Inicializa o ADC (Analog-to-Digital Converter)
+    halAdcInit();
+    halAdcGpioInit(JOYSTICK_VRY); // Inicializa o pino do joystick Y para leitura analógica
+    halAdcGpioInit(JOYSTICK_VRX); // Inicializa o pino do joystick X para leitura analógica
+    joystickInit();               // Amostragem contínua e calibração do centro (joystick solto)
+
+    renderInit(RENDER_BRILHO_PADRAO); // Tabela de gama x brilho
+
+    // Tarefas: a entrada roda a cada tick; as demais são acordadas por prazos ou entradas
+    escalonadorInit();
+    registroInit();
+    rastroInit();
+    escalonadorOcioso(registroDrenar); // As mensagens só vão para o USB quando não há tarefa liberada e cabem sem esperar
+    tarefa_entrada = escalonadorTarefa("entrada", tarefaEntrada, TICK_US, 0);
+    tarefa_logica = escalonadorTarefa("logica", tarefaLogica, 0, TICK_US);
+    tarefa_render = escalonadorTarefa("render", tarefaRender, 0, QUADRO_PROGRESSO_US);
+    energiaInit(acordarEntrada);
+
+    // Inicializa os LEDs NeoPixel (uma cadeia de painéis por pino) e os buzzers
+    static const uint pinos_leds[] = LED_PINOS;
+#ifdef MM_MULTINUCLEO
+    saidaInitNucleo1(pinos_leds, BUZZER_ACERTO, BUZZER_ERRO); // O núcleo 1 cuida do PIO, do DMA e dos buzzers
+#else
+    tarefa_saida = escalonadorTarefa("saida", tarefaSaida, 0, SAIDA_ESPERA_FIO_US);
+    saidaInit(pinos_leds, BUZZER_ACERTO, BUZZER_ERRO, acordarSaida);
+#endif
+    // Enlace USB: só muda algo quando um computador manda a primeira mensagem válida
+    enlace.ativo = false;
+    enlace.botoes = 0;
+    protocoloIniciar(&usb, usbDestino, usbMensagem);
+    tarefa_usb = escalonadorTarefa("usb", tarefaUsb, 0, USB_PRAZO_US);
+    halUsbEntrada(usbChegou);
+
+    camadas_ocupadas = 0;
+    npClear();                                       // Apaga todos os LEDs
+    publicarCamada(CAMADA_FUNDO, COMPOSITOR_TODOS);  // Envia o fundo (apagado) para os LEDs
+
+    // Inicializa o gerador de números aleatórios com a entropia do hardware; com a semente registrada,
+    // o simulador (-S) gera exatamente as mesmas partidas
+    uint32_t semente = halEntropia();
+    aleatorioSemear(&gerador, semente);
+    registrar(REG_SEMENTE, semente, semente);
+    rastrear(halTempoUs(), RASTRO_SEMENTE, jogo.sem_fim, 0, semente);
+
+    // Histórico das partidas anteriores (zerado na primeira vez)
+    armazemInit();
+    if (!armazemLer(CHAVE_HISTORICO, &historico, sizeof(historico)))
+        historico = (historico_t){ 0 };
+    registrar(REG_HISTORICO, historico.partidas, jogo.sem_fim ? historico.recorde_sem_fim : historico.recorde);
+
+    // Estado inicial do jogo
+    jogo.nivel = 1;            // Nível inicial do jogo
+    entradas.pausa = false;
+    entradas.cor = false;
+    entradas.direcao = CENTRO;
+
+    if (jogo.sem_fim)
+        registrar(REG_SEM_FIM, SEQUENCIA_MAX_PASSOS, 0);
+    iniciarNivel();
+    escalonadorAcordar(tarefa_logica); // A lógica agenda o próximo prazo
+    escalonadorExecutar(); // Dorme entre as tarefas; só retorna no simulador
 
     return 0; // Retorna 0 (fim do programa)
-}
\ No newline at end of file
+}
@@ -0,0 +1,80 @@
+#include <stddef.h>
+#include "hal.h"
+#include "sprites.h"
+#include "mosaico.h"
+
+static const mosaicoPainel_t *tabela = NULL; // NULL: mosaico preenchido linha a linha
+static uint8_t origem[MOSAICO_LEDS];         // Pixel lógico de cada LED físico
+static uint16_t amostra[LED_COUNT];          // Um LED físico de cada pixel lógico
+static bool direto;                          // Sem expansão: o quadro lógico vai direto para o fio
+
+void mosaicoDefinir(const mosaicoPainel_t *paineis) {
+    tabela = paineis;
+}
+
+// Painel da tabela padrão: as cadeias recebem blocos seguidos de painéis, na ordem de leitura
+static mosaicoPainel_t mosaicoPadrao(uint k) {
+    mosaicoPainel_t p = { (uint8_t)(k / MOSAICO_PAINEIS_POR_CADEIA), (uint8_t)(k % MOSAICO_PAINEIS_POR_CADEIA),
+                          (uint8_t)(k % MOSAICO_PAINEIS_X), (uint8_t)(k / MOSAICO_PAINEIS_X), PAINEL_SERPENTINA, 0 };
+    return p;
+}
+
+// Coordenadas, no painel já montado, do LED 'k' da fiação dele
+static void painelPosicao(const mosaicoPainel_t *p, uint k, uint *x, uint *y) {
+    uint px, py;
+    if (p->fiacao == PAINEL_LINHAS) {
+        px = k % PAINEL_LADO;
+        py = k / PAINEL_LADO;
+    } else { // Inverso de SPRITE_INDICE
+        uint r = PAINEL_LEDS - 1 - k;
+        py = r / PAINEL_LADO;
+        px = (py % 2 == 0) ? r % PAINEL_LADO : PAINEL_LADO - 1 - r % PAINEL_LADO;
+    }
+    for (uint i = 0; i < (p->rotacao & 3u); ++i) { // Um quarto de volta no sentido horário por vez
+        uint t = px;
+        px = PAINEL_LADO - 1 - py;
+        py = t;
+    }
+    *x = px;
+    *y = py;
+}
+
+void mosaicoInit() {
+    for (uint i = 0; i < MOSAICO_LEDS; ++i)
+        origem[i] = MOSAICO_APAGADO; // Cadeias mais curtas que as outras: sobra apagada
+    for (uint k = 0; k < MOSAICO_PAINEIS; ++k) {
+        mosaicoPainel_t p = tabela ? tabela[k] : mosaicoPadrao(k);
+        if (p.cadeia >= MOSAICO_CADEIAS || p.ordem >= MOSAICO_PAINEIS_POR_CADEIA)
+            continue; // Painel fora das cadeias: não é desenhado
+        uint base = p.cadeia * MOSAICO_LEDS_POR_CADEIA + p.ordem * PAINEL_LEDS;
+        for (uint led = 0; led < PAINEL_LEDS; ++led) {
+            uint x, y;
+            painelPosicao(&p, led, &x, &y);
+            uint gx = p.x * PAINEL_LADO + x, gy = p.y * PAINEL_LADO + y; // Coordenadas no mosaico
+            origem[base + led] = SPRITE_INDICE(gx / MOSAICO_PAINEIS_X, gy / MOSAICO_PAINEIS_Y); // Cada pixel lógico vira um bloco
+        }
+    }
+    direto = MOSAICO_LEDS == LED_COUNT;
+    for (uint i = MOSAICO_LEDS; i-- > 0;) {
+        if (origem[i] != MOSAICO_APAGADO)
+            amostra[origem[i]] = (uint16_t)i; // Fica o primeiro LED de cada pixel
+        direto = direto && origem[i] == i;
+    }
+}
+
+bool HAL_RAM(mosaicoDireto)() {
+    return direto;
+}
+
+void HAL_RAM(mosaicoExpandir)(const uint32_t *logico, uint32_t *fisico) {
+    for (uint i = 0; i < MOSAICO_LEDS; ++i)
+        fisico[i] = origem[i] == MOSAICO_APAGADO ? 0 : logico[origem[i]];
+}
+
+uint8_t mosaicoOrigem(uint fisico) {
+    return fisico < MOSAICO_LEDS ? origem[fisico] : MOSAICO_APAGADO;
+}
+
+uint mosaicoAmostra(uint logico) {
+    return amostra[logico];
+}
@@ -0,0 +1,60 @@
+#ifndef MOSAICO_H
+#define MOSAICO_H
+
+// Mosaico de painéis 5x5. O jogo desenha sempre uma cena lógica de 5x5 (índices no layout de getIndex);
+// o mosaico amplia essa cena para MOSAICO_PAINEIS_X x MOSAICO_PAINEIS_Y painéis, cada pixel lógico
+// virando um bloco. Os painéis são distribuídos em MOSAICO_CADEIAS cadeias, uma por pino, cada
+// uma com a sua máquina de estado do PIO: as cadeias transmitem em paralelo, então o tempo de um
+// quadro depende só dos painéis por cadeia. Onde cada painel está, em que cadeia e posição, com que
+// fiação e rotação, vem de uma tabela (a padrão preenche o mosaico linha a linha, de cima para baixo).
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "neopixel.h"
+
+#ifndef MOSAICO_PAINEIS_X
+#define MOSAICO_PAINEIS_X 1 // Painéis na horizontal
+#endif
+#ifndef MOSAICO_PAINEIS_Y
+#define MOSAICO_PAINEIS_Y 1 // Painéis na vertical
+#endif
+#ifndef MOSAICO_CADEIAS
+#define MOSAICO_CADEIAS 1   // Cadeias de painéis, uma por pino (até HAL_MAX_CADEIAS)
+#endif
+
+#define PAINEL_LADO 5                          // LEDs em cada lado de um painel
+#define PAINEL_LEDS (PAINEL_LADO * PAINEL_LADO) // LEDs em um painel
+#define MOSAICO_PAINEIS (MOSAICO_PAINEIS_X * MOSAICO_PAINEIS_Y)
+#define MOSAICO_PAINEIS_POR_CADEIA ((MOSAICO_PAINEIS + MOSAICO_CADEIAS - 1) / MOSAICO_CADEIAS)
+#define MOSAICO_LEDS_POR_CADEIA (MOSAICO_PAINEIS_POR_CADEIA * PAINEL_LEDS) // Palavras enviadas por cadeia em cada quadro
+#define MOSAICO_LEDS (MOSAICO_CADEIAS * MOSAICO_LEDS_POR_CADEIA)           // Palavras de todas as cadeias
+#define MOSAICO_APAGADO 0xFF                   // Posição de cadeia sem painel: recebe o LED apagado
+
+#if PAINEL_LEDS != LED_COUNT
+#error "A cena lógica tem o tamanho de um painel"
+#endif
+
+// Ordem dos LEDs dentro de um painel
+typedef enum {
+    PAINEL_SERPENTINA, // Zigue-zague a partir do canto inferior direito (matriz da BitDogLab, como getIndex)
+    PAINEL_LINHAS      // Linha a linha, da esquerda para a direita, a partir do canto superior esquerdo
+} painelFiacao_t;
+
+// Um painel do mosaico
+typedef struct {
+    uint8_t cadeia;  // Cadeia (pino) que o alimenta
+    uint8_t ordem;   // Posição na cadeia (0 = o primeiro depois do pino)
+    uint8_t x, y;    // Coluna e linha no mosaico, em painéis
+    uint8_t fiacao;  // painelFiacao_t
+    uint8_t rotacao; // Quartos de volta no sentido horário, como o painel foi montado
+} mosaicoPainel_t;
+
+// Troca a tabela de painéis (MOSAICO_PAINEIS entradas; NULL = padrão). Vale no próximo mosaicoInit
+void mosaicoDefinir(const mosaicoPainel_t *paineis);
+void mosaicoInit(void);                                       // Monta a tabela LED físico -> pixel lógico
+bool mosaicoDireto(void);                                     // TRUE se o quadro lógico já é o quadro do fio (um painel, sem rotação)
+void mosaicoExpandir(const uint32_t *logico, uint32_t *fisico); // Copia cada pixel lógico codificado para os LEDs que o mostram
+uint8_t mosaicoOrigem(uint fisico);                           // Pixel lógico de um LED físico (MOSAICO_APAGADO se não há painel)
+uint mosaicoAmostra(uint logico);                             // Um LED físico que mostra o pixel lógico
+
+#endif
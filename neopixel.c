@@ -0,0 +1,128 @@
+#include <stddef.h>
+#include "hal.h"
+#include "neopixel.h"
+#include "mosaico.h"
+#include "medidas.h"
+
+// Variáveis globais
+npLED_t leds[LED_COUNT]; // Array para armazenar o estado de cada LED
+
+static uint32_t npQuadros[2][LED_COUNT]; // Dois quadros codificados: um no fio e outro em preparação
+static uint npQuadroLivre = 0;           // Índice do quadro que pode ser sobrescrito
+static volatile bool npOcupado = false;  // TRUE enquanto há um quadro sendo transmitido
+static bool npQuadroValido = false;      // FALSE até o primeiro envio: o estado inicial dos LEDs é desconhecido
+static uint32_t npFisico[MOSAICO_LEDS];   // Quadro ampliado para as cadeias do mosaico (só fora do modo direto)
+static npStats_t npStats;                // Quadros submetidos e enviados
+static volatile npCallback_t npCallback = NULL; // Aviso opcional de quadro concluído
+static uint64_t npEnvioUs;               // Instante do disparo do quadro no fio
+
+// Chamado pela HAL quando o quadro foi travado pelos LEDs
+static void HAL_RAM(npQuadroConcluido)(void) {
+    medir(MEDIDA_FIO, (uint32_t)(halTempoUs() - npEnvioUs)); // Bits no fio mais o reset
+    npOcupado = false;     // Libera o fio para o próximo quadro
+    if (npCallback) {      // Se há um callback registrado
+        npCallback();      // Avisa que o quadro foi exibido
+    }
+}
+
+// Inicializa a saída dos LEDs e apaga o quadro
+void npInit(const uint *pins) {
+    npOcupado = false;
+    npQuadroLivre = 0;
+    npQuadroValido = false;
+    npResetStats();
+    mosaicoInit();                         // LED físico -> pixel lógico
+    halLedsInit(pins, MOSAICO_CADEIAS, npQuadroConcluido); // PIO + DMA no Pico, fio virtual no simulador
+    for (uint i = 0; i < LED_COUNT; ++i) { // Apaga todos os LEDs
+        leds[i].R = 0;
+        leds[i].G = 0;
+        leds[i].B = 0;
+    }
+}
+
+// Define a cor de um LED específico
+void npSetLED(const uint32_t index, const uint8_t r, const uint8_t g, const uint8_t b) {
+    leds[index].R = r; // Define o componente vermelho
+    leds[index].G = g; // Define o componente verde
+    leds[index].B = b; // Define o componente azul
+}
+
+// Apaga todos os LEDs
+void npClear() {
+    for (uint i = 0; i < LED_COUNT; ++i) // Itera sobre todos os LEDs
+        npSetLED(i, 0, 0, 0);               // Define a cor como preto (apagado)
+}
+
+// Envia os dados para os LEDs sem esperar a transmissão.
+void npWrite() {
+    npWriteFrame(leds);
+}
+
+// Envia um quadro qualquer, codificado por inteiro no quadro livre
+void HAL_RAM(npWriteFrame)(const npLED_t *origem) {
+    npEncodeFrame(origem, npFrameBegin(NULL), LED_COUNT); // Codifica enquanto o quadro anterior ainda pode estar saindo
+    npFrameSubmit();
+}
+
+// Quadro codificado que não está no fio, para quem escreve direto nele (ex.: o compositor)
+uint32_t *npFrameBegin(uint32_t *indice) {
+    if (indice)
+        *indice = npQuadroLivre;
+    return npQuadros[npQuadroLivre];
+}
+
+// Envia o quadro livre. O quadro anterior continua no outro buffer, então a comparação
+// é barata: se nada mudou, o fio não é usado.
+void HAL_RAM(npFrameSubmit)() {
+    uint32_t inicio = halCiclos();
+    const uint32_t *quadro = npQuadros[npQuadroLivre];       // Quadro preenchido
+    const uint32_t *anterior = npQuadros[npQuadroLivre ^ 1]; // Último quadro enviado
+    uint32_t diferenca = 0;                                  // Acumula os bits que mudaram
+    for (uint i = 0; i < LED_COUNT; ++i)
+        diferenca |= quadro[i] ^ anterior[i];
+    npStats.submitted++;
+    if (diferenca == 0 && npQuadroValido) { // Os LEDs já mostram este quadro
+        medir(MEDIDA_ENVIO, (halCiclos() - inicio) & HAL_CICLOS_MASCARA);
+        return;
+    }
+    npWait();                             // Só espera se o quadro anterior ainda não foi travado
+    if (!mosaicoDireto()) {               // Com o fio livre, npFisico pode ser reescrito
+        mosaicoExpandir(quadro, npFisico);
+        quadro = npFisico;
+    }
+    npOcupado = true;                     // Marca o fio como ocupado antes de disparar a transmissão
+    npEnvioUs = halTempoUs();
+    halLedsEnviar(quadro, MOSAICO_LEDS_POR_CADEIA); // Dispara a transmissão, todas as cadeias juntas
+    npQuadroLivre ^= 1;                   // O outro quadro passa a ser o livre
+    npQuadroValido = true;
+    npStats.sent++;
+    medir(MEDIDA_ENVIO, (halCiclos() - inicio) & HAL_CICLOS_MASCARA); // Inclui a espera pelo fio
+}
+
+// Indica se ainda há um quadro sendo transmitido
+bool npBusy() {
+    return npOcupado;
+}
+
+// Aguarda o último quadro enviado ser travado pelos LEDs
+void npWait() {
+    while (npOcupado) {
+        halOcioso(HAL_SEM_LIMITE); // Acorda com o alarme de fim de quadro
+    }
+}
+
+// Registra a função chamada (em contexto de interrupção) ao fim de cada quadro
+void npSetCallback(npCallback_t callback) {
+    npCallback = callback;
+}
+
+// Lê os contadores de quadros
+npStats_t npGetStats() {
+    return npStats;
+}
+
+// Zera os contadores de quadros
+void npResetStats() {
+    npStats.submitted = 0;
+    npStats.sent = 0;
+}
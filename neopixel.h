@@ -0,0 +1,53 @@
+#ifndef NEOPIXEL_H
+#define NEOPIXEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hal.h"
+
+#define LED_COUNT 25 // Número de LEDs na matriz
+
+// Definição da estrutura para representar um pixel (LED)
+struct pixel_t {
+    uint8_t G, R, B; // Componentes verde, vermelha e azul do pixel
+};
+typedef struct pixel_t pixel_t; // Cria um alias para a struct pixel_t
+typedef pixel_t npLED_t;       // Cria um alias para representar um LED NeoPixel
+
+typedef void (*npCallback_t)(void); // Função chamada quando um quadro termina de ser travado pelos LEDs
+
+// Contadores de quadros
+typedef struct {
+    uint32_t submitted; // Chamadas a npWrite
+    uint32_t sent;      // Quadros que realmente foram para o fio (os demais eram iguais ao anterior)
+} npStats_t;
+
+extern npLED_t leds[LED_COUNT]; // Quadro em desenho (não é o que está no fio)
+
+// Empacota um LED em uma palavra GRB de 24 bits.
+// O ws2818b desloca os bits para a direita (LSB primeiro), então o verde fica no byte
+// menos significativo: a sequência no fio é a mesma das três escritas de 8 bits (G, R, B).
+static inline uint32_t npEncode(npLED_t led) {
+    return (uint32_t)led.G | ((uint32_t)led.R << 8) | ((uint32_t)led.B << 16);
+}
+
+// Codifica um quadro inteiro, uma palavra por LED
+static inline void npEncodeFrame(const npLED_t *origem, uint32_t *destino, uint32_t n) {
+    for (uint32_t i = 0; i < n; ++i)     // Itera sobre todos os LEDs
+        destino[i] = npEncode(origem[i]); // Uma palavra de 24 bits por LED
+}
+
+void npInit(const uint *pins);                                                         // Inicializa os LEDs NeoPixel (um pino por cadeia do mosaico)
+void npSetLED(const uint32_t index, const uint8_t r, const uint8_t g, const uint8_t b); // Define a cor de um LED
+void npClear(void);                                                                   // Apaga todos os LEDs
+void npWrite(void);                                                                   // Envia o quadro de forma assíncrona (DMA)
+void npWriteFrame(const npLED_t *quadro);                                            // Envia um quadro de outro buffer (ex.: recebido de outro núcleo)
+uint32_t *npFrameBegin(uint32_t *indice);                                             // Quadro codificado livre para escrita direta ('indice': qual dos dois)
+void npFrameSubmit(void);                                                             // Envia o quadro livre (nada vai para o fio se for igual ao anterior)
+bool npBusy(void);                                                                    // Indica se ainda há um quadro no fio
+void npWait(void);                                                                    // Aguarda o último quadro ser travado
+void npSetCallback(npCallback_t callback);                                           // Registra o aviso de quadro concluído
+npStats_t npGetStats(void);                                                           // Lê os contadores de quadros
+void npResetStats(void);                                                              // Zera os contadores de quadros
+
+#endif
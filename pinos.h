@@ -0,0 +1,17 @@
+#ifndef PINOS_H
+#define PINOS_H
+
+// Definições de pinos
+#define LED_PIN 7          // Pino GPIO conectado aos LEDs
+#define LED_PINOS { LED_PIN, 8, 9, 12, 14, 15, 16, 17 } // Um pino por cadeia de painéis (só as MOSAICO_CADEIAS primeiras)
+#define JOYSTICK_VRX 27    // Pino GPIO conectado à saída VRx do joystick (eixo X)
+#define JOYSTICK_VRY 26    // Pino GPIO conectado à saída VRy do joystick (eixo Y)
+#define JOYSTICK_SW 22     // Pino GPIO conectado ao botão do joystick
+#define BUTTON_COR_1 5     // Pino GPIO conectado ao botão da cor 1
+#define BUTTON_COR_2 6     // Pino GPIO conectado ao botão da cor 2
+#define BUZZER_ACERTO 10   // Pino GPIO conectado ao buzzer de acerto
+#define BUZZER_ERRO 21     // Pino GPIO conectado ao buzzer de erro
+#define LED_ERRO 13        // Pino GPIO conectado ao LED de erro
+#define LED_ACERTO 11      // Pino GPIO conectado ao LED de acerto
+
+#endif
@@ -0,0 +1,144 @@
+#include <stddef.h>
+#include "protocolo.h"
+
+// CRC-16/CCITT-FALSE (polinômio 0x1021) meio byte por vez: 32 bytes de tabela em vez de 512
+static const uint16_t crc_nibble[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+};
+
+static inline uint16_t crcByte(uint16_t crc, uint8_t byte) {
+    crc = (uint16_t)(crc << 4) ^ crc_nibble[(crc >> 12) ^ (byte >> 4)];
+    crc = (uint16_t)(crc << 4) ^ crc_nibble[(crc >> 12) ^ (byte & 0x0F)];
+    return crc;
+}
+
+uint16_t protocoloCrc(uint16_t crc, const uint8_t *dados, uint32_t n) {
+    for (uint32_t i = 0; i < n; ++i)
+        crc = crcByte(crc, dados[i]);
+    return crc;
+}
+
+// Prepara para a próxima mensagem
+static void protocoloReiniciar(protocoloDecodificador_t *d) {
+    d->restantes = 0;
+    d->zero_pendente = false;
+    d->descartando = false;
+    d->n = 0;
+    d->crc = 0xFFFF;
+    d->payload = NULL;
+    d->capacidade = 0;
+}
+
+void protocoloIniciar(protocoloDecodificador_t *d, protocoloDestino_t destino, protocoloMensagem_t mensagem) {
+    d->destino = destino;
+    d->mensagem = mensagem;
+    d->estatisticas = (protocoloEstatisticas_t){ 0, 0, 0 };
+    protocoloReiniciar(d);
+}
+
+// Um byte que saiu do atraso: com certeza não é CRC, então é cabeçalho ou payload
+static void protocoloConteudo(protocoloDecodificador_t *d, uint8_t byte) {
+    d->crc = crcByte(d->crc, byte);
+    uint32_t i = d->n++ - PROTOCOLO_CRC; // Os dois primeiros bytes decodificados ficaram no atraso
+    if (i == 0) {
+        d->tipo = byte;
+    } else if (i == 1) {
+        d->seq = byte;
+        d->payload = d->destino ? d->destino(d->tipo, &d->capacidade) : NULL;
+        if (!d->payload) {
+            d->estatisticas.descartadas++;
+            d->descartando = true;
+        }
+    } else if (i - PROTOCOLO_CABECALHO < d->capacidade) {
+        d->payload[i - PROTOCOLO_CABECALHO] = byte; // Direto no buffer de quem recebe
+    } else {
+        d->estatisticas.erros++; // Não cabe no destino
+        d->descartando = true;
+    }
+}
+
+// Um byte decodificado do COBS: passa pelo atraso de dois bytes
+static void protocoloDecodificado(protocoloDecodificador_t *d, uint8_t byte) {
+    if (d->n >= PROTOCOLO_CRC)
+        protocoloConteudo(d, d->atraso[0]);
+    else
+        d->n++;
+    if (d->descartando)
+        return;
+    d->atraso[0] = d->atraso[1];
+    d->atraso[1] = byte;
+}
+
+// Delimitador: confere o CRC e entrega a mensagem
+static void protocoloFim(protocoloDecodificador_t *d) {
+    if (d->n == 0 && d->restantes == 0) // Zeros seguidos: só ressincronização
+        return;
+    if (d->descartando)
+        return;
+    if (d->restantes != 0 || d->n < PROTOCOLO_CABECALHO + PROTOCOLO_CRC) { // Bloco COBS incompleto ou mensagem curta
+        d->estatisticas.erros++;
+        return;
+    }
+    uint16_t recebido = (uint16_t)(d->atraso[0] | (d->atraso[1] << 8));
+    if (recebido != d->crc) {
+        d->estatisticas.erros++;
+        return;
+    }
+    d->estatisticas.mensagens++;
+    if (d->mensagem)
+        d->mensagem(d->tipo, d->seq, d->payload, d->n - PROTOCOLO_CABECALHO - PROTOCOLO_CRC);
+}
+
+void protocoloReceber(protocoloDecodificador_t *d, const uint8_t *dados, uint32_t n) {
+    for (uint32_t i = 0; i < n; ++i) {
+        uint8_t byte = dados[i];
+        if (byte == 0) { // Delimitador: fim da mensagem, válida ou não
+            protocoloFim(d);
+            protocoloReiniciar(d);
+        } else if (d->descartando) {
+            continue;
+        } else if (d->restantes == 0) { // Código COBS: tamanho do próximo bloco
+            if (d->zero_pendente)
+                protocoloDecodificado(d, 0);
+            d->restantes = byte - 1;
+            d->zero_pendente = byte != 0xFF; // Bloco cheio não termina em zero
+        } else {
+            protocoloDecodificado(d, byte);
+            d->restantes--;
+        }
+    }
+}
+
+// Codifica em COBS um byte por vez, guardando o lugar do código do bloco aberto
+typedef struct {
+    uint8_t *saida;
+    uint32_t n;      // Bytes escritos
+    uint32_t codigo; // Posição do código do bloco atual
+} cobs_t;
+
+static void cobsByte(cobs_t *c, uint8_t byte) {
+    if (byte != 0)
+        c->saida[c->n++] = byte;
+    if (byte == 0 || c->n - c->codigo == 0xFF) { // Fecha o bloco
+        c->saida[c->codigo] = (uint8_t)(c->n - c->codigo);
+        c->codigo = c->n++;
+    }
+}
+
+uint32_t protocoloCodificar(uint8_t tipo, uint8_t seq, const void *payload, uint32_t n, uint8_t *saida) {
+    const uint8_t *dados = payload;
+    cobs_t c = { saida, 1, 0 };
+    uint8_t cabecalho[PROTOCOLO_CABECALHO] = { tipo, seq };
+    uint16_t crc = protocoloCrc(0xFFFF, cabecalho, PROTOCOLO_CABECALHO);
+    crc = protocoloCrc(crc, dados, n);
+    cobsByte(&c, tipo);
+    cobsByte(&c, seq);
+    for (uint32_t i = 0; i < n; ++i)
+        cobsByte(&c, dados[i]);
+    cobsByte(&c, (uint8_t)crc);
+    cobsByte(&c, (uint8_t)(crc >> 8));
+    saida[c.codigo] = (uint8_t)(c.n - c.codigo); // Último bloco
+    saida[c.n++] = 0;                            // Delimitador
+    return c.n;
+}
@@ -0,0 +1,104 @@
+#ifndef PROTOCOLO_H
+#define PROTOCOLO_H
+
+// Protocolo binário do USB (CDC) entre um computador e o jogo. Cada mensagem é
+// [tipo, seq, payload..., crc16 (little-endian)] codificada em COBS e terminada por um byte 0x00:
+// o zero nunca aparece dentro da mensagem, então quem se perdeu no meio de uma (lixo, byte perdido)
+// se ressincroniza no próximo zero. O CRC é o CRC-16/CCITT-FALSE de tipo, seq e payload.
+// O decodificador trabalha byte a byte, sem remontar a mensagem: o payload é gravado direto no
+// buffer indicado por quem recebe (ex.: um slot da fila de quadros) e só é entregue se o CRC bater.
+// O mesmo código roda no firmware e nas ferramentas do host.
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define PROTOCOLO_MAX_PAYLOAD 160 // Maior payload aceito (um histograma de medidas.h)
+#define PROTOCOLO_CABECALHO 2    // tipo e seq
+#define PROTOCOLO_CRC 2          // CRC-16 no fim
+// Bytes no fio de uma mensagem com 'n' bytes de payload: um byte de COBS a cada 254, mais o delimitador
+#define PROTOCOLO_MAX_FIO(n) ((n) + PROTOCOLO_CABECALHO + PROTOCOLO_CRC + ((n) + 4) / 254 + 2)
+
+// Tipos de mensagem: até 0x7F do computador para o jogo, a partir de 0x80 do jogo para o computador
+enum {
+    PROTO_QUADRO = 0x01,   // 75 bytes: 25 LEDs G, R, B na ordem física; payload vazio devolve a matriz ao jogo
+    PROTO_ENTRADA = 0x02,  // protocoloEntrada_t: direção e botões no lugar do joystick
+    PROTO_CONSULTA = 0x03, // Sem payload: o jogo responde com PROTO_ESTADO
+    PROTO_ECO = 0x04,      // Payload qualquer, devolvido igual em PROTO_ECO (medida de latência)
+    PROTO_MEDIDAS = 0x05,  // 1 byte: medida_t; o jogo responde com PROTO_MEDIDA (sem payload se não existir)
+    PROTO_RASTRO = 0x06,   // 2 bytes: primeiro evento do rastro (uint16); o jogo responde com PROTO_RASTRO_PARTE
+    PROTO_ESTADO = 0x81,   // protocoloEstado_t
+    PROTO_REGISTRO = 0x82, // Um registro_t do jogo (substitui o texto no console enquanto o enlace está ativo)
+    PROTO_MEDIDA = 0x83,   // histograma_t da medida pedida
+    PROTO_RASTRO_PARTE = 0x84, // protocoloRastro_t e até PROTOCOLO_RASTRO_EVENTOS eventos (rastroEvento_t) a partir do pedido
+};
+
+#define PROTO_DIRECAO_LOCAL 0xFF // protocoloEntrada_t.direcao: devolve a direção ao joystick
+
+// Entrada injetada: vale até a próxima PROTO_ENTRADA
+typedef struct {
+    uint8_t direcao; // Direcao do joystick (CENTRO = solto) ou PROTO_DIRECAO_LOCAL
+    uint8_t botoes;  // Um bit por Botao (1 = apertado); cada 0 -> 1 é um aperto
+} protocoloEntrada_t;
+
+// Estado e contadores do jogo: 32 bytes little-endian (mesmo layout no Pico e no host)
+typedef struct {
+    uint32_t tempo_us;           // 32 bits baixos de halTempoUs
+    uint32_t remotos;            // Quadros do USB entregues aos LEDs
+    uint32_t remotos_perdidos;   // Quadros do USB descartados (fila cheia ou substituídos por um mais novo)
+    uint32_t quadros;            // Quadros compostos e entregues ao driver dos LEDs
+    uint32_t erros;              // Mensagens com CRC, COBS ou tamanho inválido
+    uint32_t registros_perdidos; // Registros perdidos por anel cheio
+    uint16_t nivel;              // Nível atual
+    uint16_t passo;              // Passo da sequência sendo mostrado ou lido
+    uint8_t estado;              // Estado da máquina do jogo
+    uint8_t pausado;             // Parado pelo botão de pausa
+    uint8_t sem_fim;             // Modo sem fim ligado
+    uint8_t remoto;              // A matriz mostra quadros do USB
+} protocoloEstado_t;
+
+_Static_assert(sizeof(protocoloEstado_t) == 32, "protocoloEstado_t vai cru para o fio");
+
+// Cabeçalho de PROTO_RASTRO_PARTE: 8 bytes little-endian
+typedef struct {
+    uint16_t total;    // Eventos gravados até agora
+    uint16_t primeiro; // Índice do primeiro evento da parte
+    uint32_t perdidos; // Eventos que não couberam no rastro
+} protocoloRastro_t;
+
+#define PROTOCOLO_RASTRO_EVENTOS 12 // Eventos de 12 bytes por parte: (PROTOCOLO_MAX_PAYLOAD - 8) / 12
+
+// Onde gravar o payload de uma mensagem de 'tipo' (capacidade em bytes); NULL descarta a mensagem
+typedef uint8_t *(*protocoloDestino_t)(uint8_t tipo, uint32_t *capacidade);
+// Mensagem completa e com CRC válido; 'payload' é o buffer devolvido pelo destino
+typedef void (*protocoloMensagem_t)(uint8_t tipo, uint8_t seq, uint8_t *payload, uint32_t tamanho);
+
+// Contadores do decodificador
+typedef struct {
+    uint32_t mensagens;   // Entregues
+    uint32_t erros;       // CRC errado, COBS inválido, curtas demais ou maiores que o destino
+    uint32_t descartadas; // Sem destino
+} protocoloEstatisticas_t;
+
+// Estado do decodificador (um por enlace)
+typedef struct {
+    protocoloDestino_t destino;
+    protocoloMensagem_t mensagem;
+    uint8_t restantes;     // Bytes até o próximo código COBS (0 = o próximo byte é um código)
+    bool zero_pendente;    // O bloco anterior termina com um zero implícito
+    bool descartando;      // Ignora tudo até o próximo delimitador
+    uint8_t atraso[PROTOCOLO_CRC]; // Os dois últimos bytes: o CRC, se a mensagem acabar aqui
+    uint32_t n;            // Bytes decodificados da mensagem atual
+    uint16_t crc;          // CRC dos bytes que já saíram do atraso
+    uint8_t tipo, seq;
+    uint8_t *payload;      // Buffer do destino
+    uint32_t capacidade;
+    protocoloEstatisticas_t estatisticas;
+} protocoloDecodificador_t;
+
+uint16_t protocoloCrc(uint16_t crc, const uint8_t *dados, uint32_t n); // Continua um CRC-16/CCITT-FALSE (comece com 0xFFFF)
+void protocoloIniciar(protocoloDecodificador_t *d, protocoloDestino_t destino, protocoloMensagem_t mensagem);
+void protocoloReceber(protocoloDecodificador_t *d, const uint8_t *dados, uint32_t n); // Bytes do fio, em pedaços de qualquer tamanho
+// Monta uma mensagem pronta para o fio em 'saida' (ao menos PROTOCOLO_MAX_FIO(n) bytes); devolve o tamanho
+uint32_t protocoloCodificar(uint8_t tipo, uint8_t seq, const void *payload, uint32_t n, uint8_t *saida);
+
+#endif
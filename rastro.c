@@ -0,0 +1,39 @@
+#include "rastro.h"
+
+#define RASTRO_TEXTO(nome, texto) texto,
+static const char *const nomes[RASTRO_NUM_TIPOS] = { RASTRO_TIPOS(RASTRO_TEXTO) };
+#undef RASTRO_TEXTO
+
+static rastroEvento_t eventos[RASTRO_EVENTOS];
+static uint32_t n;        // Eventos gravados
+static uint32_t perdidos;
+
+void rastroInit() {
+    n = 0;
+    perdidos = 0;
+}
+
+void rastrear(uint64_t tempo_us, rastroTipo_t tipo, uint8_t a, uint16_t b, uint32_t c) {
+    uint32_t limite = tipo == RASTRO_CAMADA ? RASTRO_EVENTOS - RASTRO_RESERVA : RASTRO_EVENTOS;
+    if (n >= limite) {
+        perdidos++;
+        return;
+    }
+    eventos[n++] = (rastroEvento_t){ (uint32_t)tempo_us, (uint8_t)tipo, a, b, c };
+}
+
+uint32_t rastroTamanho() {
+    return n;
+}
+
+const rastroEvento_t *rastroEventos() {
+    return eventos;
+}
+
+uint32_t rastroPerdidos() {
+    return perdidos;
+}
+
+const char *rastroNome(uint8_t tipo) {
+    return tipo < RASTRO_NUM_TIPOS ? nomes[tipo] : "?";
+}
@@ -0,0 +1,60 @@
+#ifndef RASTRO_H
+#define RASTRO_H
+
+// Rastro de uma sessão para reproduzir no simulador: a semente, cada borda de botão e cada
+// direção nova vista pela tarefa de entrada (as entradas), mais as camadas publicadas, as trocas
+// de estado e o veredito de cada rodada (as saídas). Os eventos vão em ordem para um vetor na RAM
+// desde o boot, sem formatar nada; o computador lê o vetor pelo USB (PROTO_RASTRO) e
+// o memoryMatrix2_host -R alimenta o jogo com as entradas e compara as saídas.
+// Com o vetor quase cheio, as camadas deixam de ser gravadas (RASTRO_RESERVA fica para as
+// entradas, estados e vereditos); cheio, nada mais é gravado e os eventos perdidos são contados.
+// Um único produtor: as tarefas do núcleo 0.
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define RASTRO_EVENTOS 2048 // Eventos gravados desde o boot (24 KiB: uma partida inteira de 9 níveis)
+#define RASTRO_RESERVA 256  // Últimos lugares, fechados para as camadas
+#define RASTRO_ASSINATURA "MMT1" // Início de um arquivo de rastro: 4 bytes, os perdidos (uint32) e os rastroEvento_t crus
+
+// Tipos de evento e o nome de cada um; os argumentos vão em a, b e c
+#define RASTRO_TIPOS(X)                                                                \
+    X(RASTRO_SEMENTE, "semente")   /* a = modo sem fim, c = semente do gerador */     \
+    X(RASTRO_BOTAO, "botao")       /* a = Botao, b = 1 apertado; tempo = a borda */   \
+    X(RASTRO_DIRECAO, "direcao")   /* a = Direcao nova; tempo = o tick que a viu */   \
+    X(RASTRO_CAMADA, "camada")     /* a = camada, b = CRC dos pixels, c = máscara */  \
+    X(RASTRO_ESTADO, "estado")     /* a = estado do jogo, b = nível, c = passo */     \
+    X(RASTRO_VEREDITO, "veredito") /* a = rastroVeredito_t, b = nível, c = passo */
+
+#define RASTRO_ENUM(nome, texto) nome,
+typedef enum { RASTRO_TIPOS(RASTRO_ENUM) RASTRO_NUM_TIPOS } rastroTipo_t;
+#undef RASTRO_ENUM
+
+// Resultado de uma rodada
+typedef enum {
+    RASTRO_CERTO,
+    RASTRO_DIRECAO_ERRADA,
+    RASTRO_COR_ERRADA,
+    RASTRO_TEMPO_DIRECAO, // Tempo esgotado esperando a direção
+    RASTRO_TEMPO_COR,     // Tempo esgotado esperando a cor
+} rastroVeredito_t;
+
+// Um evento: 12 bytes, little-endian no Pico e no host (é o formato do arquivo)
+typedef struct {
+    uint32_t tempo_us; // 32 bits baixos de halTempoUs
+    uint8_t tipo;      // rastroTipo_t
+    uint8_t a;
+    uint16_t b;
+    uint32_t c;
+} rastroEvento_t;
+
+_Static_assert(sizeof(rastroEvento_t) == 12, "rastroEvento_t vai cru para o fio e para o arquivo");
+
+void rastroInit(void); // Esvazia o vetor
+void rastrear(uint64_t tempo_us, rastroTipo_t tipo, uint8_t a, uint16_t b, uint32_t c); // Grava um evento; nunca espera
+uint32_t rastroTamanho(void);                 // Eventos gravados
+const rastroEvento_t *rastroEventos(void);    // Os eventos, em ordem de gravação
+uint32_t rastroPerdidos(void);                // Eventos não gravados (camadas além da reserva e vetor cheio)
+const char *rastroNome(uint8_t tipo);         // Nome do tipo, para relatórios
+
+#endif
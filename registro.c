@@ -0,0 +1,112 @@
+#include <stdio.h>
+#include "fila.h"
+#include "hal.h"
+#include "registro.h"
+
+#define REGISTRO_TEXTO(nome, texto) texto,
+static const char *const textos[REG_NUM_EVENTOS] = { REGISTRO_EVENTOS(REGISTRO_TEXTO) };
+#undef REGISTRO_TEXTO
+
+static registro_t anel[REGISTRO_ANEL]; // Armazenamento da fila
+static fila_t fila;                    // Tarefas -> drenagem no tempo ocioso
+static uint32_t perdidos;              // Escrito só pelo produtor
+static uint32_t gravados;
+static uint32_t perdidos_avisados;     // Perdas já entregues como REG_PERDIDOS
+static uint32_t perda_gravados;        // Registros aceitos antes da primeira perda ainda não avisada
+static uint32_t perda_us;              // Instante dessa perda
+static uint32_t drenados;              // Registros entregues à saída
+static registroSaida_t saida = registroImprimir;
+
+void registroInit() {
+    filaInit(&fila, anel, REGISTRO_ANEL, sizeof(registro_t));
+    perdidos = 0;
+    gravados = 0;
+    perdidos_avisados = 0;
+    drenados = 0;
+}
+
+void registrar(registroEvento_t evento, int32_t a, int32_t b) {
+    registro_t r = { (uint32_t)halTempoUs(), evento, { a, b } };
+    if (filaPublicar(&fila, &r)) {
+        gravados++;
+        return;
+    }
+    if (perdidos == perdidos_avisados) { // Começo de um buraco: marca onde e quando
+        perda_gravados = gravados;
+        perda_us = r.tempo_us;
+    }
+    perdidos++;
+}
+
+// Com a saída cheia (computador que não lê o USB), nada é retirado do anel e a drenagem devolve
+// FALSE: o núcleo dorme em vez de esperar pelo USB, e tenta de novo no próximo tempo ocioso.
+// O aviso de perda sai no lugar do buraco, depois dos registros aceitos antes dele e com o
+// instante da primeira perda; perdas novas antes de o aviso sair entram no mesmo aviso
+bool registroDrenar() {
+    uint32_t perdidos_agora = perdidos;
+    if (perdidos_agora != perdidos_avisados && drenados == perda_gravados) {
+        registro_t r = { perda_us, REG_PERDIDOS, { (int32_t)(perdidos_agora - perdidos_avisados), 0 } };
+        if (!saida(&r))
+            return false;
+        perdidos_avisados = perdidos_agora;
+        return true;
+    }
+    const registro_t *r = filaEspiar(&fila);
+    if (!r || !saida(r))
+        return false;
+    filaLiberar(&fila);
+    drenados++;
+    return true;
+}
+
+void registroDefinirSaida(registroSaida_t nova) {
+    saida = nova ? nova : registroImprimir;
+}
+
+bool registroImprimir(const registro_t *registro) {
+    char texto[96];
+    size_t n = registroFormatar(registro, texto, sizeof(texto));
+    if (halConsoleLivre() < n + 2) // O fim de linha pode virar CR LF
+        return false;
+    printf("%s\n", texto);
+    return true;
+}
+
+uint32_t registroPerdidos() {
+    return perdidos;
+}
+
+uint32_t registroGravados() {
+    return gravados;
+}
+
+size_t registroFormatar(const registro_t *registro, char *texto, size_t tamanho) {
+    if (registro->evento >= REG_NUM_EVENTOS)
+        return snprintf(texto, tamanho, "Evento desconhecido %lu (%ld, %ld)", (unsigned long)registro->evento,
+                        (long)registro->args[0], (long)registro->args[1]);
+    size_t n = 0;
+    int arg = 0;
+    texto[0] = '\0';
+    for (const char *f = textos[registro->evento]; *f && n + 1 < tamanho; ++f) {
+        if (*f != '%' || f[1] == '\0') {
+            texto[n++] = *f;
+            texto[n] = '\0';
+            continue;
+        }
+        char conversao = *++f;
+        int32_t v = conversao != '%' && arg < 2 ? registro->args[arg++] : 0;
+        int escrito;
+        switch (conversao) {
+            case 'd': escrito = snprintf(texto + n, tamanho - n, "%ld", (long)v); break;
+            case 'u': escrito = snprintf(texto + n, tamanho - n, "%lu", (unsigned long)(uint32_t)v); break;
+            case 'x': escrito = snprintf(texto + n, tamanho - n, "0x%08lx", (unsigned long)(uint32_t)v); break;
+            case 'c': escrito = snprintf(texto + n, tamanho - n, "%s", v ? "Vermelho" : "Verde"); break;
+            case 'p': escrito = snprintf(texto + n, tamanho - n, "%ld.%02ld", (long)(v / 100), (long)(v % 100)); break;
+            default: escrito = snprintf(texto + n, tamanho - n, "%c", conversao); break;
+        }
+        n += escrito < 0 ? 0 : (size_t)escrito;
+        if (n >= tamanho)
+            n = tamanho - 1;
+    }
+    return n;
+}
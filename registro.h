@@ -0,0 +1,72 @@
+#ifndef REGISTRO_H
+#define REGISTRO_H
+
+// Registro de eventos em binário: registrar() só copia instante, evento e dois argumentos para um
+// anel na RAM, em tempo constante e sem formatar nada. O anel é esvaziado no tempo ocioso
+// (registroDrenar, chamado pelo escalonador sem tarefas liberadas), que entrega cada registro à
+// saída escolhida: texto no console por padrão, ou os bytes crus para o decodificador do host.
+// Com o anel cheio o registro é perdido e contado; a drenagem avisa as perdas com REG_PERDIDOS.
+// Um único produtor: as tarefas do núcleo 0 (nunca interrupções nem o núcleo 1).
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define REGISTRO_ANEL 64          // Registros pendentes (potência de 2)
+#define REGISTRO_ASSINATURA "MMR1" // Início de um arquivo de registros: 4 bytes, seguidos de registro_t crus
+
+// Eventos e o texto de cada um. Conversões: %d com sinal, %u sem sinal, %x hexadecimal,
+// %c cor (≠ 0 = Vermelho), %p centésimos (1234 -> 12.34) e %% literal; cada conversão consome o próximo argumento.
+#define REGISTRO_EVENTOS(X)                                                              \
+    X(REG_PERDIDOS, "%u registro(s) perdido(s)")                                        \
+    X(REG_NIVEL, "Nível: %d")                                                           \
+    X(REG_AGUARDA_DIRECAO, "Aguardando entrada do joystick para a direção %d...")       \
+    X(REG_DIRECAO, "Direção inserida: %d, Direção correta: %d")                         \
+    X(REG_AGUARDA_COR, "Aguardando entrada do botão para a cor %d...")                  \
+    X(REG_TEMPO_DIRECAO, "Tempo esgotado para a direção!")                              \
+    X(REG_REACAO, "Tempo de reação: %u us")                                             \
+    X(REG_TEMPO_COR, "Tempo esgotado para a cor!")                                      \
+    X(REG_COR, "Cor inserida: %c, Cor correta: %c")                                     \
+    X(REG_DIRECAO_INCORRETA, "Direcao incorreta! Esperado: %d, Recebido: %d")           \
+    X(REG_COR_INCORRETA, "Cor incorreta! Esperado: %c, Recebido: %c")                   \
+    X(REG_ACERTO, "Parabéns! Próximo nível.")                                           \
+    X(REG_ERRO, "Errou! Game Over.")                                                    \
+    X(REG_SUA_VEZ, "Sua vez!")                                                          \
+    X(REG_PREPARE, "Prepare-se!")                                                       \
+    X(REG_VITORIA, "Você venceu o jogo!")                                               \
+    X(REG_PAUSADO, "Jogo pausado!")                                                     \
+    X(REG_RETOMADO, "Jogo retomado!")                                                   \
+    X(REG_CARGA, "Núcleo 0 ocupado: %p%%, saída ocupada: %p%%")                         \
+    X(REG_DESCARTES, "Comandos descartados: %u, registros perdidos: %u")              \
+    X(REG_SEM_FIM, "Modo sem fim: até %u passos")                                      \
+    X(REG_SEMENTE, "Semente: %x (memoryMatrix2_host -S %x repete as partidas)")         \
+    X(REG_RENDER, "Desenho: %u ciclos por quadro em média, pior %u")                   \
+    X(REG_REACAO_PERCENTIS, "Reação à cor: mediana até %u us, 90%% até %u us")          \
+    X(REG_ATRASO_TICK, "Atraso do tick: 99%% até %u us, pior %u us")                   \
+    X(REG_HISTORICO, "Partidas jogadas: %u, recorde: nível %u")                      \
+    X(REG_ENERGIA, "Pausas: %u ms no total, %p%% com o relógio reduzido")
+
+#define REGISTRO_ENUM(nome, texto) nome,
+typedef enum { REGISTRO_EVENTOS(REGISTRO_ENUM) REG_NUM_EVENTOS } registroEvento_t;
+#undef REGISTRO_ENUM
+
+// Um registro: 16 bytes, little-endian no Pico e no host (é o formato do arquivo binário)
+typedef struct {
+    uint32_t tempo_us; // 32 bits baixos de halTempoUs (dá a volta a cada ~71 minutos)
+    uint32_t evento;   // registroEvento_t
+    int32_t args[2];   // Argumentos do texto, em ordem
+} registro_t;
+
+// Destino dos registros drenados; FALSE se não coube agora sem esperar (o registro fica no anel)
+typedef bool (*registroSaida_t)(const registro_t *registro);
+
+void registroInit(void);                                     // Esvazia o anel e zera os contadores (mantém a saída)
+void registrar(registroEvento_t evento, int32_t a, int32_t b); // Grava um registro; nunca espera
+bool registroDrenar(void);                                   // Entrega um registro à saída; FALSE se o anel estava vazio ou a saída, cheia
+void registroDefinirSaida(registroSaida_t saida);            // Troca a saída (NULL = texto no console)
+bool registroImprimir(const registro_t *registro);           // Saída padrão: uma linha de texto no stdout, se couber no console
+uint32_t registroPerdidos(void);                             // Registros perdidos por anel cheio desde registroInit
+uint32_t registroGravados(void);                             // Registros aceitos no anel desde registroInit
+size_t registroFormatar(const registro_t *registro, char *texto, size_t tamanho); // Texto do registro (sem o instante)
+
+#endif
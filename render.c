@@ -0,0 +1,77 @@
+#include "render.h"
+
+// round(256 * (i / 255)^2,2): passos iguais de intensidade parecem iguais ao olho
+const uint16_t renderGama[256] = {
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,
+      3,   3,   3,   3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   6,   6,   6,
+      6,   7,   7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  11,  11,  11,  12,
+     12,  13,  13,  14,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,
+     20,  21,  21,  22,  22,  23,  23,  24,  25,  25,  26,  27,  27,  28,  28,  29,
+     30,  31,  31,  32,  33,  33,  34,  35,  36,  36,  37,  38,  39,  39,  40,  41,
+     42,  43,  44,  44,  45,  46,  47,  48,  49,  50,  51,  51,  52,  53,  54,  55,
+     56,  57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  70,  71,  72,
+     73,  74,  75,  76,  77,  78,  80,  81,  82,  83,  84,  86,  87,  88,  89,  91,
+     92,  93,  94,  96,  97,  98, 100, 101, 102, 104, 105, 106, 108, 109, 110, 112,
+    113, 115, 116, 118, 119, 120, 122, 123, 125, 126, 128, 129, 131, 132, 134, 136,
+    137, 139, 140, 142, 143, 145, 147, 148, 150, 152, 153, 155, 157, 158, 160, 162,
+    164, 165, 167, 169, 171, 172, 174, 176, 178, 179, 181, 183, 185, 187, 189, 191,
+    192, 194, 196, 198, 200, 202, 204, 206, 208, 210, 212, 214, 216, 218, 220, 222,
+    224, 226, 228, 230, 232, 234, 237, 239, 241, 243, 245, 247, 249, 252, 254, 256,
+};
+
+static uint16_t escala[256]; // renderGama com o brilho global aplicado
+static renderEstatisticas_t estatisticas;
+
+void renderInit(uint8_t brilho) {
+    renderBrilho(brilho);
+    estatisticas = (renderEstatisticas_t){ 0 };
+}
+
+void renderBrilho(uint8_t brilho) {
+    for (int i = 0; i < 256; ++i)
+        escala[i] = renderGama[(i * brilho + 127) / 255];
+}
+
+uint16_t renderEscala(uint8_t intensidade) {
+    return escala[intensidade];
+}
+
+npLED_t renderAtenuar(npLED_t cor, uint8_t intensidade) {
+    uint32_t f = escala[intensidade];
+    npLED_t r = { .G = (uint8_t)((cor.G * f + 128) >> 8), .R = (uint8_t)((cor.R * f + 128) >> 8),
+                  .B = (uint8_t)((cor.B * f + 128) >> 8) };
+    return r;
+}
+
+void renderSprite(uint32_t mascara, npLED_t cor, uint8_t intensidade) {
+    const npLED_t aceso = renderAtenuar(cor, intensidade); // Uma atenuação por quadro, não por LED
+    const npLED_t apagado = { 0, 0, 0 };
+    for (uint32_t i = 0; i < LED_COUNT; ++i, mascara >>= 1) // Um bit por LED, na ordem física
+        leds[i] = (mascara & 1u) ? aceso : apagado;
+}
+
+uint32_t renderBarra(int32_t preenchido_q8, npLED_t cor) {
+    if (preenchido_q8 < 0)
+        preenchido_q8 = 0;
+    int32_t cheios = preenchido_q8 >> 8;      // LEDs inteiros
+    uint32_t fracao = preenchido_q8 & 0xFF;   // Quanto do LED da ponta já acendeu
+    npLED_t ponta = renderAtenuar(cor, (uint8_t)fracao);
+    npLED_t apagado = { 0, 0, 0 };
+    for (int32_t i = 0; i < LED_COUNT; ++i)
+        leds[i] = i < cheios ? cor : (i == cheios ? ponta : apagado);
+    if (cheios >= LED_COUNT)
+        return (1u << LED_COUNT) - 1;
+    return ((1u << cheios) - 1) | (fracao ? 1u << cheios : 0); // A ponta só cobre o fundo depois de começar a acender
+}
+
+void renderMedir(uint32_t ciclos) {
+    estatisticas.quadros++;
+    estatisticas.ciclos += ciclos;
+    if (ciclos > estatisticas.pior)
+        estatisticas.pior = ciclos;
+}
+
+renderEstatisticas_t renderEstatisticas() {
+    return estatisticas;
+}
@@ -0,0 +1,56 @@
+#ifndef RENDER_H
+#define RENDER_H
+
+// Desenho em ponto fixo (o Cortex-M0+ não tem FPU): intensidades perceptuais de 0 a 255 passam
+// por uma tabela de gama e brilho e viram um fator Q8 (256 = 1,0) aplicado a cada componente
+// com uma multiplicação e um deslocamento. As animações interpolam valores inteiros com um passo
+// Q16 calculado em tempo de compilação, então nenhum quadro divide nem usa float.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "neopixel.h"
+
+#define RENDER_Q8 256              // 1,0 em Q8
+#define RENDER_BRILHO_PADRAO 255   // Brilho global inicial (sem atenuação além da cor)
+#define ANIMACAO_TIQUE_BITS 10     // Animações contam o tempo em tiques de 1024 us (deslocamento, não divisão)
+
+// Interpolação linear de 'de' até 'para' (|para - de| <= 32767) em 'duracao_us'
+typedef struct {
+    int32_t de;
+    int32_t para;
+    int32_t tiques;    // Duração em tiques
+    int32_t passo_q16; // (para - de) / tiques, em Q16
+} animacao_t;
+
+// Animação constante, montada em tempo de compilação
+#define ANIMACAO(de, para, duracao_us)                                                      \
+    { (de), (para), (int32_t)((duracao_us) >> ANIMACAO_TIQUE_BITS),                         \
+      (int32_t)((((int64_t)(para) - (de)) * 65536) / ((duracao_us) >> ANIMACAO_TIQUE_BITS)) }
+
+// Valor da animação 'decorrido_us' depois do início (preso em 'para' no fim)
+static inline int32_t animacaoValor(const animacao_t *a, uint64_t decorrido_us) {
+    uint64_t t = decorrido_us >> ANIMACAO_TIQUE_BITS;
+    if (t >= (uint64_t)a->tiques)
+        return a->para;
+    return a->de + ((a->passo_q16 * (int32_t)t) >> 16);
+}
+
+// Contadores de custo do desenho (ciclos no Pico, nanossegundos no simulador)
+typedef struct {
+    uint32_t quadros;    // Quadros medidos
+    uint64_t ciclos;     // Soma
+    uint32_t pior;       // Quadro mais caro
+} renderEstatisticas_t;
+
+extern const uint16_t renderGama[256]; // Intensidade perceptual -> fator linear Q8 (gama 2,2)
+
+void renderInit(uint8_t brilho);        // Monta a tabela de escala e zera os contadores
+void renderBrilho(uint8_t brilho);      // Refaz a tabela de escala (gama x brilho); fora do caminho de cada quadro
+uint16_t renderEscala(uint8_t intensidade); // Fator Q8 de uma intensidade perceptual, já com o brilho
+npLED_t renderAtenuar(npLED_t cor, uint8_t intensidade); // Cor com a intensidade aplicada
+void renderSprite(uint32_t mascara, npLED_t cor, uint8_t intensidade); // Preenche leds[] com o sprite atenuado
+uint32_t renderBarra(int32_t preenchido_q8, npLED_t cor); // Barra em leds[]: LEDs inteiros acesos e o da ponta proporcional; devolve a máscara dos acesos
+void renderMedir(uint32_t ciclos);                    // Acumula o custo de um quadro
+renderEstatisticas_t renderEstatisticas(void);        // Lê os contadores
+
+#endif
@@ -0,0 +1,204 @@
+#include <string.h>
+#include "fila.h"
+#include "saida.h"
+
+enum { COMANDO_CAMADA, COMANDO_SOM };
+
+typedef struct {
+    uint8_t tipo;
+    union {
+        struct {                        // COMANDO_CAMADA
+            uint8_t camada;
+            uint32_t mascara;
+            npLED_t pixels[LED_COUNT];
+        };
+        const somNota_t *notas;         // COMANDO_SOM
+    };
+} comando_t;
+
+// Quadro cru do USB, preenchido no lugar pelo protocolo
+typedef struct {
+    npLED_t pixels[LED_COUNT];
+    bool ativo; // FALSE: devolve a matriz às camadas
+} remoto_t;
+
+static comando_t comandos[SAIDA_FILA]; // Armazenamento da fila
+static fila_t fila;                    // Jogo -> consumidor
+static remoto_t remotos[SAIDA_REMOTOS]; // Armazenamento da fila de quadros do USB
+static fila_t fila_remota;             // Protocolo -> consumidor
+static uint32_t remotos_cheia;         // Reservas recusadas (contadas pelo produtor)
+static halCallback_t acordar;          // Avisa o consumidor de um comando novo
+static const uint *pinos_leds;       // Um pino por cadeia do mosaico
+static volatile bool leds_prontos;     // npInit já rodou no núcleo consumidor
+static uint64_t inicio_us;             // Instante da inicialização
+
+// Estado do consumidor (as camadas ficam no compositor)
+static bool tem_pendente;              // Alguma camada mudou desde o último quadro enviado
+static volatile bool remoto_ativo;     // A matriz mostra quadros do USB, não as camadas
+static saidaEstatisticas_t estatisticas;
+
+static void saidaConfigurar(const uint *leds, uint a, uint b) {
+    filaInit(&fila, comandos, SAIDA_FILA, sizeof(comando_t));
+    filaInit(&fila_remota, remotos, SAIDA_REMOTOS, sizeof(remoto_t));
+    remotos_cheia = 0;
+    pinos_leds = leds;
+    tem_pendente = false;
+    remoto_ativo = false;
+    somInit(a, b); // Só o consumidor mexe no PWM depois daqui
+    memset(&estatisticas, 0, sizeof(estatisticas));
+    inicio_us = halTempoUs();
+}
+
+void saidaInit(const uint *leds, uint a, uint b, halCallback_t acordar_consumidor) {
+    saidaConfigurar(leds, a, b);
+    acordar = acordar_consumidor;
+    npInit(pinos_leds);
+    compositorInit();
+    leds_prontos = true;
+}
+
+// O PIO e o DMA são configurados pelo próprio núcleo 1, para as interrupções do DMA caírem nele
+void saidaInitNucleo1(const uint *leds, uint a, uint b) {
+    saidaConfigurar(leds, a, b);
+    acordar = halNucleo1Acordar;
+    leds_prontos = false;
+    halNucleo1Iniciar(saidaPasso);
+    while (!leds_prontos) { // Só na inicialização: npInit também apaga o quadro em desenho
+        halOcioso(HAL_SEM_LIMITE);
+    }
+}
+
+static bool saidaPublicar(const comando_t *comando) {
+    estatisticas.comandos++;
+    if (!filaPublicar(&fila, comando)) {
+        estatisticas.descartados++;
+        return false;
+    }
+    if (acordar)
+        acordar();
+    return true;
+}
+
+bool saidaCamada(camada_t camada, const npLED_t *pixels, uint32_t mascara) {
+    comando_t comando;
+    comando.tipo = COMANDO_CAMADA;
+    comando.camada = camada;
+    comando.mascara = mascara;
+    if (mascara)
+        memcpy(comando.pixels, pixels, sizeof(comando.pixels));
+    return saidaPublicar(&comando);
+}
+
+bool saidaQuadro(const npLED_t *quadro) {
+    return saidaCamada(CAMADA_FUNDO, quadro, COMPOSITOR_TODOS);
+}
+
+uint32_t saidaSom(const somNota_t *notas) {
+    comando_t comando;
+    comando.tipo = COMANDO_SOM;
+    comando.notas = notas;
+    saidaPublicar(&comando);
+    return somDuracao(notas);
+}
+
+npLED_t *saidaRemotoReservar() {
+    remoto_t *remoto = filaReservar(&fila_remota);
+    if (!remoto) {
+        remotos_cheia++;
+        return NULL;
+    }
+    return remoto->pixels;
+}
+
+bool saidaRemotoPublicar(bool ativo) {
+    remoto_t *remoto = filaReservar(&fila_remota);
+    if (!remoto) {
+        remotos_cheia++;
+        return false;
+    }
+    remoto->ativo = ativo;
+    filaConfirmar(&fila_remota);
+    if (acordar)
+        acordar();
+    return true;
+}
+
+bool saidaRemotoAtivo() {
+    return remoto_ativo;
+}
+
+// Quadros do USB: só o mais novo importa, os anteriores nem são codificados.
+// Devolve FALSE se o mais novo teve de ficar na fila porque o fio está ocupado.
+static bool saidaRemotos(void) {
+    remoto_t *remoto;
+    while ((remoto = filaEspiar(&fila_remota)) != NULL) {
+        if (!remoto->ativo) {           // A matriz volta para as camadas, recompostas por inteiro
+            remoto_ativo = false;
+            compositorSujar();
+            tem_pendente = true;
+        } else if (filaOcupacao(&fila_remota) > 1) {
+            estatisticas.remotos_perdidos++; // Já existe um mais novo
+        } else if (npBusy()) {
+            return false;               // Fica no slot até o fio liberar
+        } else {
+            remoto_ativo = true;
+            npWriteFrame(remoto->pixels); // Codifica direto do slot
+            estatisticas.remotos++;
+        }
+        filaLiberar(&fila_remota);
+    }
+    return true;
+}
+
+uint64_t saidaPasso() {
+    uint64_t inicio = halTempoUs();
+    if (!leds_prontos) { // Primeira execução no núcleo 1
+        npInit(pinos_leds);
+        compositorInit();
+        npSetCallback(halNucleo1Acordar); // Fim de quadro acorda o núcleo 1
+        leds_prontos = true;
+    }
+
+    comando_t comando;
+    while (filaConsumir(&fila, &comando)) {
+        if (comando.tipo == COMANDO_CAMADA) { // Várias trocas viram um único quadro
+            if (!compositorCamada(comando.camada, comando.pixels, comando.mascara))
+                continue; // Nada visível mudou
+            if (tem_pendente)
+                estatisticas.substituidos++;
+            tem_pendente = true;
+        } else {
+            somTocar(comando.notas); // Começa no próximo somPasso ou ao fim do som atual
+        }
+    }
+
+    uint64_t proximo = HAL_SEM_LIMITE;
+    if (!saidaRemotos())
+        proximo = inicio + SAIDA_ESPERA_FIO_US;
+    if (tem_pendente && !remoto_ativo) {
+        if (npBusy()) { // O quadro anterior ainda está no fio
+            proximo = inicio + SAIDA_ESPERA_FIO_US;
+        } else {
+            uint32_t indice;
+            uint32_t *quadro = npFrameBegin(&indice); // Compõe direto no quadro codificado livre
+            compositorCompor(quadro, indice);
+            npFrameSubmit();
+            tem_pendente = false;
+            estatisticas.quadros++;
+        }
+    }
+
+    uint64_t proximo_som = somPasso(inicio); // Notas e degraus de envelope vencidos
+    if (proximo_som < proximo)
+        proximo = proximo_som;
+
+    estatisticas.ocupado_us += halTempoUs() - inicio;
+    return proximo;
+}
+
+saidaEstatisticas_t saidaEstatisticas() {
+    saidaEstatisticas_t e = estatisticas;
+    e.remotos_perdidos += remotos_cheia;
+    e.total_us = halTempoUs() - inicio_us;
+    return e;
+}
@@ -0,0 +1,47 @@
+#ifndef SAIDA_H
+#define SAIDA_H
+
+// Saídas do jogo: camadas da matriz de LEDs e sons para os buzzers, pedidos por comandos em uma fila SPSC.
+// Quem publica (o jogo) nunca espera: com a fila cheia o comando é descartado e contado.
+// Quem consome roda saidaPasso: no modo multinúcleo é o núcleo 1, dono do PIO/DMA dos LEDs e
+// dos buzzers; no modo de um núcleo é uma tarefa do escalonador.
+// Quadros crus vindos do USB têm uma segunda fila: o protocolo grava o payload direto no slot
+// reservado, e o consumidor codifica do slot para o fio. Só o mais novo vai para o fio; enquanto
+// houver quadros remotos as camadas continuam sendo atualizadas, mas só voltam a aparecer quando
+// o computador devolve a matriz.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hal.h"
+#include "neopixel.h"
+#include "som.h"
+#include "compositor.h"
+
+#define SAIDA_FILA 8             // Comandos pendentes (potência de 2)
+#define SAIDA_REMOTOS 4          // Quadros do USB pendentes (potência de 2)
+#define SAIDA_ESPERA_FIO_US 200  // Nova tentativa enquanto o quadro anterior ainda está no fio
+
+// Contadores das saídas
+typedef struct {
+    uint32_t comandos;     // Comandos publicados
+    uint32_t descartados;  // Comandos perdidos por fila cheia
+    uint32_t quadros;      // Quadros compostos e entregues ao driver dos LEDs
+    uint32_t substituidos; // Trocas de camada agrupadas com outras no mesmo quadro
+    uint32_t remotos;      // Quadros do USB entregues ao driver dos LEDs
+    uint32_t remotos_perdidos; // Quadros do USB descartados: fila cheia ou superados por um mais novo
+    uint64_t ocupado_us;   // Tempo dentro de saidaPasso (no modo multinúcleo, o núcleo 1 ocupado)
+    uint64_t total_us;     // Tempo desde a inicialização
+} saidaEstatisticas_t;
+
+void saidaInit(const uint *pinos_leds, uint buzzer_a, uint buzzer_b, halCallback_t acordar); // Consumidor no mesmo núcleo; 'acordar' avisa que há comandos
+void saidaInitNucleo1(const uint *pinos_leds, uint buzzer_a, uint buzzer_b);                 // Consumidor no núcleo 1 (espera ele ficar pronto)
+bool saidaCamada(camada_t camada, const npLED_t *pixels, uint32_t mascara); // Publica uma cópia dos pixels cobertos por uma camada
+bool saidaQuadro(const npLED_t *quadro);      // Publica um quadro inteiro na camada de fundo (as de cima continuam por cima)
+uint32_t saidaSom(const somNota_t *notas);    // Publica um som (toca depois dos já enfileirados); devolve a duração em ms
+npLED_t *saidaRemotoReservar(void);           // Slot para um quadro do USB (NULL com a fila cheia); o mesmo até publicar
+bool saidaRemotoPublicar(bool ativo);         // Publica o slot reservado (FALSE com a fila cheia); 'ativo' FALSE devolve a matriz às camadas
+bool saidaRemotoAtivo(void);                  // A matriz mostra quadros do USB (visão do consumidor)
+uint64_t saidaPasso(void);                    // Consome os comandos e avança o sequenciador; devolve quando precisa rodar de novo
+saidaEstatisticas_t saidaEstatisticas(void);  // Lê os contadores
+
+#endif
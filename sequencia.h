@@ -0,0 +1,91 @@
+#ifndef SEQUENCIA_H
+#define SEQUENCIA_H
+
+// Sequência da partida compactada: cada passo ocupa 4 bits (2 da direção, 1 da cor e 1 reservado
+// para um quinto símbolo), dois passos por byte. Acesso a qualquer passo em O(1) e um passo
+// acrescentado por nível, sem regerar os anteriores. Com SEQUENCIA_MAX_PASSOS = 4096 a
+// sequência inteira cabe em 2 KiB.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "joystick.h" // Direcao
+#include "aleatorio.h"
+
+#define SEQUENCIA_MAX_PASSOS 4096 // Passos no modo sem fim (par)
+#define SEQUENCIA_BITS_DIRECAO 0x3 // Bits 0-1: Direcao (CIMA a DIREITA)
+#define SEQUENCIA_BIT_COR 0x4      // Bit 2: TRUE = cor 1
+
+// Resultado de conferir uma entrada contra um passo
+typedef enum {
+    SEQUENCIA_CERTO,
+    SEQUENCIA_DIRECAO_ERRADA, // A direção é conferida primeiro
+    SEQUENCIA_COR_ERRADA,
+} sequenciaResultado_t;
+
+typedef struct {
+    uint8_t passos[SEQUENCIA_MAX_PASSOS / 2]; // Passo par no nibble baixo, ímpar no alto
+    uint16_t tamanho;                         // Passos em uso
+} sequencia_t;
+
+// Esvazia a sequência
+static inline void sequenciaLimpar(sequencia_t *s) {
+    s->tamanho = 0;
+}
+
+// Acrescenta um passo no fim; FALSE se a sequência estiver cheia
+static inline bool sequenciaAcrescentar(sequencia_t *s, Direcao direcao, bool cor1) {
+    if (s->tamanho >= SEQUENCIA_MAX_PASSOS)
+        return false;
+    uint8_t passo = (direcao & SEQUENCIA_BITS_DIRECAO) | (cor1 ? SEQUENCIA_BIT_COR : 0);
+    uint8_t *byte = &s->passos[s->tamanho >> 1];
+    if (s->tamanho & 1)
+        *byte = (*byte & 0x0F) | (passo << 4);
+    else
+        *byte = passo; // Também limpa o nibble alto, que ainda não está em uso
+    s->tamanho++;
+    return true;
+}
+
+// Os 4 bits do passo 'i' (deve ser menor que o tamanho)
+static inline uint8_t sequenciaPasso(const sequencia_t *s, uint32_t i) {
+    return (s->passos[i >> 1] >> ((i & 1) * 4)) & 0x0F;
+}
+
+static inline Direcao sequenciaDirecao(const sequencia_t *s, uint32_t i) {
+    return (Direcao)(sequenciaPasso(s, i) & SEQUENCIA_BITS_DIRECAO);
+}
+
+static inline bool sequenciaCor(const sequencia_t *s, uint32_t i) {
+    return sequenciaPasso(s, i) & SEQUENCIA_BIT_COR;
+}
+
+// Acrescenta 'n' passos aleatórios (até a capacidade); cada palavra do gerador rende 10 passos de 3 bits
+static inline void sequenciaGerar(sequencia_t *s, aleatorio_t *g, uint32_t n) {
+    uint32_t bits = 0;
+    int restantes = 0;
+    for (; n > 0 && s->tamanho < SEQUENCIA_MAX_PASSOS; --n) {
+        if (restantes == 0) {
+            bits = aleatorioProximo(g);
+            restantes = 10;
+        }
+        sequenciaAcrescentar(s, (Direcao)(bits & SEQUENCIA_BITS_DIRECAO), bits & SEQUENCIA_BIT_COR);
+        bits >>= 3;
+        restantes--;
+    }
+}
+
+// Confere a direção e a cor inseridas contra o passo 'i' (deve ser menor que o tamanho)
+static inline sequenciaResultado_t sequenciaConferir(const sequencia_t *s, uint32_t i, Direcao direcao, bool cor1) {
+    uint8_t passo = sequenciaPasso(s, i);
+    if ((passo & SEQUENCIA_BITS_DIRECAO) != (uint8_t)direcao)
+        return SEQUENCIA_DIRECAO_ERRADA;
+    if (((passo & SEQUENCIA_BIT_COR) != 0) != cor1)
+        return SEQUENCIA_COR_ERRADA;
+    return SEQUENCIA_CERTO;
+}
+
+static inline uint32_t sequenciaTamanho(const sequencia_t *s) {
+    return s->tamanho;
+}
+
+#endif
@@ -0,0 +1,107 @@
+#include <string.h>
+#include "fila.h"
+#include "som.h"
+
+static const somNota_t *padroes[SOM_FILA]; // Armazenamento da fila
+static fila_t fila;                        // Sons à espera do atual terminar
+static uint pinos[2];                      // Buzzer A e B
+static const somNota_t *nota;              // Nota em andamento (NULL = parado)
+static uint64_t inicio_nota_us;            // Início da nota em andamento
+static uint16_t freq_aplicada[2];          // Último tom de cada buzzer, para não reescrever o PWM à toa
+static uint8_t volume_aplicado[2];
+static somEstatisticas_t estatisticas;
+
+// Muda o tom de um buzzer só se ele for diferente do atual
+static void somAplicar(int buzzer, uint16_t freq_hz, uint8_t volume) {
+    if (freq_hz == 0 || volume == 0) { // Silêncio tem uma única representação
+        freq_hz = 0;
+        volume = 0;
+    }
+    if (freq_aplicada[buzzer] == freq_hz && volume_aplicado[buzzer] == volume)
+        return;
+    freq_aplicada[buzzer] = freq_hz;
+    volume_aplicado[buzzer] = volume;
+    halPwmTom(pinos[buzzer], freq_hz, volume);
+    estatisticas.atualizacoes++;
+}
+
+void somInit(uint buzzer_a, uint buzzer_b) {
+    filaInit(&fila, padroes, SOM_FILA, sizeof(padroes[0]));
+    pinos[0] = buzzer_a;
+    pinos[1] = buzzer_b;
+    nota = NULL;
+    memset(&estatisticas, 0, sizeof(estatisticas));
+    for (int i = 0; i < 2; ++i) {
+        halPwmInit(pinos[i]);
+        freq_aplicada[i] = 0;
+        volume_aplicado[i] = 0;
+    }
+}
+
+bool somTocar(const somNota_t *padrao) {
+    if (!filaPublicar(&fila, &padrao)) {
+        estatisticas.descartados++;
+        return false;
+    }
+    return true;
+}
+
+uint32_t somDuracao(const somNota_t *padrao) {
+    uint32_t duracao = 0;
+    for (const somNota_t *n = padrao; n->duracao_ms; ++n)
+        duracao += n->duracao_ms;
+    return duracao;
+}
+
+bool somTocando() {
+    return nota || filaOcupacao(&fila);
+}
+
+uint64_t somPasso(uint64_t agora) {
+    if (!nota) { // Parado: um som novo começa agora
+        if (!filaConsumir(&fila, &nota))
+            return HAL_SEM_LIMITE;
+        inicio_nota_us = agora;
+        estatisticas.tocados++;
+    }
+
+    // Avança pelas notas vencidas; cada uma começa no fim da anterior, sem deriva, e o som
+    // seguinte da fila emenda no fim do atual
+    uint64_t fim;
+    bool mudou = false;
+    while (agora >= (fim = inicio_nota_us + nota->duracao_ms * 1000ULL)) {
+        if (nota->duracao_ms == 0) {
+            if (!filaConsumir(&fila, &nota)) {
+                nota = NULL;
+                somAplicar(0, 0, 0);
+                somAplicar(1, 0, 0);
+                return HAL_SEM_LIMITE;
+            }
+            estatisticas.tocados++;
+        } else {
+            inicio_nota_us = fim;
+            nota++;
+        }
+        mudou = true;
+    }
+    if (mudou && agora - inicio_nota_us > estatisticas.atraso_max_us)
+        estatisticas.atraso_max_us = agora - inicio_nota_us;
+
+    // Envelope linear entre o volume inicial e o final, atualizado em degraus de SOM_ENVELOPE_US
+    uint32_t decorrido = agora - inicio_nota_us;
+    uint32_t duracao = nota->duracao_ms * 1000U;
+    int volume = nota->volume + (int)(((int64_t)nota->volume_final - nota->volume) * decorrido / duracao);
+    for (int i = 0; i < 2; ++i)
+        somAplicar(i, (nota->buzzers & (1 << i)) ? nota->freq_hz : 0, volume);
+
+    if (nota->freq_hz && nota->volume != nota->volume_final) {
+        uint64_t degrau = inicio_nota_us + (decorrido / SOM_ENVELOPE_US + 1) * (uint64_t)SOM_ENVELOPE_US;
+        if (degrau < fim)
+            return degrau;
+    }
+    return fim;
+}
+
+somEstatisticas_t somEstatisticas() {
+    return estatisticas;
+}
@@ -0,0 +1,42 @@
+#ifndef SOM_H
+#define SOM_H
+
+// Sequenciador de sons dos buzzers: cada buzzer toca por PWM (onda quadrada com frequência e
+// volume), e um som é uma lista de notas com envelope de volume linear. somTocar só enfileira;
+// quem roda somPasso (o consumidor das saídas) aplica as notas nos prazos, sem esperar.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hal.h"
+
+#define SOM_FILA 4              // Sons aguardando o atual terminar (potência de 2)
+#define SOM_ENVELOPE_US 10000   // Passo de atualização do volume durante um envelope
+
+#define SOM_BUZZER_A 1 // Buzzer A (acerto)
+#define SOM_BUZZER_B 2 // Buzzer B (erro)
+
+// Uma nota: frequência, duração e volume no início e no fim (variação linear entre os dois)
+typedef struct {
+    uint16_t freq_hz;      // 0 = pausa
+    uint16_t duracao_ms;   // 0 = fim do som
+    uint8_t volume;        // Volume inicial (0-255)
+    uint8_t volume_final;  // Volume ao fim da nota
+    uint8_t buzzers;       // SOM_BUZZER_A | SOM_BUZZER_B
+} somNota_t;
+
+// Contadores do sequenciador
+typedef struct {
+    uint32_t tocados;       // Sons iniciados
+    uint32_t descartados;   // Sons perdidos por fila cheia
+    uint32_t atualizacoes;  // Mudanças aplicadas ao PWM
+    uint32_t atraso_max_us; // Maior atraso entre o início previsto de uma nota e a sua aplicação
+} somEstatisticas_t;
+
+void somInit(uint buzzer_a, uint buzzer_b);      // Prepara o PWM dos dois buzzers, em silêncio
+bool somTocar(const somNota_t *padrao);          // Enfileira um som (toca depois dos anteriores); FALSE se a fila estiver cheia
+uint32_t somDuracao(const somNota_t *padrao);    // Duração total de um som em ms
+bool somTocando(void);                           // TRUE enquanto há som tocando ou enfileirado
+uint64_t somPasso(uint64_t agora_us);            // Aplica as notas vencidas; devolve o próximo prazo (HAL_SEM_LIMITE se parado)
+somEstatisticas_t somEstatisticas(void);         // Lê os contadores
+
+#endif
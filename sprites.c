@@ -0,0 +1,44 @@
+#include "neopixel.h"
+#include "sprites.h"
+
+// Índice do pixel (x, y) na cena lógica 5x5 (zigue-zague de um painel); os LEDs físicos de cada
+// pixel, em um ou vários painéis, saem da tabela do mosaico
+int getIndex(int x, int y) {
+    return SPRITE_INDICE(x, y);
+}
+
+// Algarismos de 0 a 9
+const uint32_t spritesDigitos[10] = {
+    SPRITE(0b01110, 0b10001, 0b10001, 0b10001, 0b01110), // 0
+    SPRITE(0b00100, 0b01100, 0b00100, 0b00100, 0b00100), // 1
+    SPRITE(0b01110, 0b00001, 0b00010, 0b00100, 0b11110), // 2
+    SPRITE(0b01110, 0b00001, 0b00110, 0b00001, 0b01110), // 3
+    SPRITE(0b10001, 0b10001, 0b11111, 0b00001, 0b00001), // 4
+    SPRITE(0b11110, 0b10000, 0b11110, 0b00001, 0b11110), // 5
+    SPRITE(0b01110, 0b10000, 0b11110, 0b10001, 0b01110), // 6
+    SPRITE(0b11111, 0b00001, 0b00010, 0b00100, 0b01000), // 7
+    SPRITE(0b01110, 0b10001, 0b11111, 0b10001, 0b01110), // 8
+    SPRITE(0b01110, 0b10001, 0b11111, 0b00001, 0b01110), // 9
+};
+
+// Setas de direção
+const uint32_t spritesSetas[4] = {
+    SPRITE(0b00100, 0b01110, 0b00100, 0b00100, 0b00100), // CIMA
+    SPRITE(0b00100, 0b00100, 0b00100, 0b01110, 0b00100), // BAIXO
+    SPRITE(0b00000, 0b01000, 0b11111, 0b01000, 0b00000), // ESQUERDA
+    SPRITE(0b00000, 0b00010, 0b11111, 0b00010, 0b00000), // DIREITA
+};
+
+// Sinal de verificado
+const uint32_t spriteCheckmark = SPRITE(0b00000, 0b00001, 0b10001, 0b01010, 0b00100);
+
+// Sinal de pausa (duas barras), desenhado por cima da cena congelada
+const uint32_t spritePausa = SPRITE(0b00000, 0b01010, 0b01010, 0b01010, 0b00000);
+
+// Desenha o sprite com a cor dada e apaga os demais LEDs, percorrendo a máscara na ordem física
+void spriteDesenhar(uint32_t mascara, uint8_t r, uint8_t g, uint8_t b) {
+    const npLED_t aceso = { .G = g, .R = r, .B = b };
+    const npLED_t apagado = { 0, 0, 0 };
+    for (uint32_t i = 0; i < LED_COUNT; ++i, mascara >>= 1) // Um bit por LED
+        leds[i] = (mascara & 1u) ? aceso : apagado;
+}
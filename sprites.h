@@ -0,0 +1,29 @@
+#ifndef SPRITES_H
+#define SPRITES_H
+
+#include <stdint.h>
+
+// Índice físico do pixel (x, y), no mesmo layout em zigue-zague de getIndex
+#define SPRITE_INDICE(x, y) (((y) % 2 == 0) ? 24 - ((y) * 5 + (x)) : 24 - ((y) * 5 + (4 - (x))))
+
+// Converte uma linha desenhada como 5 bits (bit 4 = x 0, à esquerda) para os bits físicos dos LEDs
+#define SPRITE_LINHA(y, bits)                               \
+    (((((uint32_t)(bits) >> 4) & 1u) << SPRITE_INDICE(0, y)) | \
+     ((((uint32_t)(bits) >> 3) & 1u) << SPRITE_INDICE(1, y)) | \
+     ((((uint32_t)(bits) >> 2) & 1u) << SPRITE_INDICE(2, y)) | \
+     ((((uint32_t)(bits) >> 1) & 1u) << SPRITE_INDICE(3, y)) | \
+     ((((uint32_t)(bits) >> 0) & 1u) << SPRITE_INDICE(4, y)))
+
+// Sprite 5x5 descrito linha a linha, de cima para baixo; vira uma máscara de 25 bits em tempo de compilação
+#define SPRITE(l0, l1, l2, l3, l4) \
+    (SPRITE_LINHA(0, l0) | SPRITE_LINHA(1, l1) | SPRITE_LINHA(2, l2) | SPRITE_LINHA(3, l3) | SPRITE_LINHA(4, l4))
+
+extern const uint32_t spritesDigitos[10]; // Algarismos de 0 a 9
+extern const uint32_t spritesSetas[4];    // Setas na ordem do enum Direcao (CIMA, BAIXO, ESQUERDA, DIREITA)
+extern const uint32_t spriteCheckmark;    // Sinal de verificado
+extern const uint32_t spritePausa;        // Sinal de pausa
+
+void spriteDesenhar(uint32_t mascara, uint8_t r, uint8_t g, uint8_t b); // Preenche leds[] com o sprite em uma passada
+int getIndex(int x, int y);                                            // Índice do pixel (x, y) na cena lógica 5x5
+
+#endif
@@ -0,0 +1,87 @@
+#include <stdio.h>
+#include <string.h>
+#include "aleatorio.h"
+#include "sequencia.h"
+
+#define AMOSTRAS 80000
+
+static int falhas = 0; // Número de verificações que falharam
+
+static void verificar(const char *nome, bool condicao) {
+    if (!condicao) {
+        printf("FALHA: %s\n", nome);
+        falhas++;
+    }
+}
+
+// Qui-quadrado das contagens contra a distribuição uniforme
+static double quiQuadrado(const uint32_t *contagens, int categorias, uint32_t total) {
+    double esperado = (double)total / categorias, x2 = 0;
+    for (int i = 0; i < categorias; ++i)
+        x2 += (contagens[i] - esperado) * (contagens[i] - esperado) / esperado;
+    return x2;
+}
+
+int main() {
+    aleatorio_t a, b;
+
+    // Mesma semente, mesma sequência; sementes vizinhas, sequências diferentes
+    aleatorioSemear(&a, 42);
+    aleatorioSemear(&b, 42);
+    uint32_t pa[64], pb[64];
+    aleatorioPreencher(&a, pa, 64);
+    for (int i = 0; i < 64; ++i)
+        pb[i] = aleatorioProximo(&b);
+    verificar("determinístico", memcmp(pa, pb, sizeof(pa)) == 0);
+    aleatorioSemear(&b, 43);
+    int iguais = 0;
+    for (int i = 0; i < 64; ++i)
+        iguais += aleatorioProximo(&b) == pa[i];
+    verificar("sementes vizinhas divergem", iguais == 0);
+    aleatorioSemear(&b, 0);
+    verificar("semente zero", (b.s[0] | b.s[1] | b.s[2] | b.s[3]) != 0);
+
+    // Passos de sequência: as 8 combinações de direção e cor são igualmente prováveis
+    // (7 graus de liberdade; 24.32 é o valor crítico para p = 0.001)
+    static sequencia_t s;
+    uint32_t passos[8] = { 0 };
+    aleatorioSemear(&a, 2024);
+    for (int k = 0; k < AMOSTRAS / SEQUENCIA_MAX_PASSOS; ++k) {
+        sequenciaLimpar(&s);
+        sequenciaGerar(&s, &a, SEQUENCIA_MAX_PASSOS);
+        for (uint32_t i = 0; i < sequenciaTamanho(&s); ++i)
+            passos[sequenciaPasso(&s, i)]++;
+    }
+    uint32_t total = (AMOSTRAS / SEQUENCIA_MAX_PASSOS) * SEQUENCIA_MAX_PASSOS;
+    verificar("passos uniformes", quiQuadrado(passos, 8, total) < 24.32);
+
+    // Faixa que não é potência de 2 (4 graus de liberdade; 18.47 para p = 0.001)
+    uint32_t faixa[5] = { 0 };
+    bool dentro = true;
+    for (int i = 0; i < AMOSTRAS; ++i) {
+        uint32_t v = aleatorioFaixa(&a, 5);
+        dentro = dentro && v < 5;
+        faixa[v < 5 ? v : 0]++;
+    }
+    verificar("faixa dentro do limite", dentro && aleatorioFaixa(&a, 1) == 0);
+    verificar("faixa uniforme", quiQuadrado(faixa, 5, AMOSTRAS) < 18.47);
+
+    // Cada bit da palavra vale 1 em metade das vezes (desvio de no máximo 2%)
+    uint32_t uns[32] = { 0 };
+    for (int i = 0; i < AMOSTRAS; ++i) {
+        uint32_t v = aleatorioProximo(&a);
+        for (int k = 0; k < 32; ++k)
+            uns[k] += (v >> k) & 1;
+    }
+    bool equilibrados = true;
+    for (int k = 0; k < 32; ++k)
+        equilibrados = equilibrados && uns[k] > AMOSTRAS * 0.49 && uns[k] < AMOSTRAS * 0.51;
+    verificar("bits equilibrados", equilibrados);
+
+    if (falhas) {
+        printf("%d falha(s)\n", falhas);
+        return 1;
+    }
+    printf("OK: aleatorio\n");
+    return 0;
+}
@@ -0,0 +1,143 @@
+#include <stdio.h>
+#include <string.h>
+#include "hal_host.h"
+#include "armazem.h"
+
+#define CHAVES 4 // Chaves usadas pelo teste de cortes
+
+static int falhas = 0; // Número de verificações que falharam
+
+static void verificar(const char *nome, bool condicao) {
+    if (!condicao) {
+        printf("FALHA: %s\n", nome);
+        falhas++;
+    }
+}
+
+// Valor da chave 'k' na rodada 'r': tamanhos diferentes por chave, conteúdo diferente por rodada
+static const uint32_t tamanhos[CHAVES] = { ARMAZEM_MAX_VALOR, 12, 1, 33 };
+
+static void valor(uint8_t k, uint32_t r, uint8_t *v) {
+    for (uint32_t i = 0; i < tamanhos[k]; ++i)
+        v[i] = (uint8_t)(k * 71 + r * 13 + i);
+}
+
+static bool temValor(uint8_t k, uint32_t r) {
+    uint8_t esperado[ARMAZEM_MAX_VALOR], lido[ARMAZEM_MAX_VALOR];
+    valor(k, r, esperado);
+    return armazemLer(k, lido, tamanhos[k]) && memcmp(lido, esperado, tamanhos[k]) == 0;
+}
+
+// Rodada 'r': a chave 3 fica com o valor da rodada 0, as outras mudam
+static void gravarRodada(uint32_t r) {
+    uint8_t v[ARMAZEM_MAX_VALOR];
+    for (uint8_t k = 0; k < CHAVES; ++k) {
+        if (k == 3 && r > 0)
+            continue;
+        valor(k, r, v);
+        armazemGravar(k, v, tamanhos[k]);
+    }
+    armazemDescarregar();
+}
+
+static bool rodadaIntacta(uint32_t r) {
+    return temValor(0, r) && temValor(1, r) && temValor(2, r) && temValor(3, 0);
+}
+
+// Corta a energia depois de 'corte' bytes na descarga da rodada r + 1, com 'r' rodadas já gravadas.
+// Depois do boot, cada chave tem o valor antigo ou o novo, e o armazém continua funcionando.
+static bool sobreviveCorte(uint32_t r, uint32_t corte) {
+    hostFlashFormatar();
+    armazemInit();
+    for (uint32_t i = 0; i <= r; ++i)
+        gravarRodada(i);
+    hostFlashCortar(corte);
+    gravarRodada(r + 1);
+    hostFlashReligar();
+
+    armazemInit(); // Boot
+    for (uint8_t k = 0; k < 3; ++k)
+        if (!temValor(k, r) && !temValor(k, r + 1))
+            return false;
+    if (!temValor(3, 0))
+        return false;
+    for (uint32_t i = r + 2; i < r + 240; ++i) { // Mais de uma volta do anel depois do corte
+        gravarRodada(i);
+        if (i % 16 == 0 && (armazemInit(), !rodadaIntacta(i)))
+            return false;
+    }
+    armazemInit();
+    return rodadaIntacta(r + 239);
+}
+
+int main() {
+    // Flash nova: nada para ler
+    hostFlashFormatar();
+    armazemInit();
+    uint8_t v[ARMAZEM_MAX_VALOR];
+    verificar("vazio", !armazemLer(0, v, 1) && !armazemPendente());
+    verificar("chave ou tamanho inválidos", !armazemGravar(ARMAZEM_CHAVES, v, 1) &&
+                                           !armazemGravar(0, v, ARMAZEM_MAX_VALOR + 1));
+
+    // Gravar só muda a RAM; a flash é tocada na descarga
+    valor(0, 1, v);
+    armazemGravar(0, v, tamanhos[0]);
+    verificar("gravação adiada", armazemPendente() && hostFlashEstatisticas()->paginas == 0 && temValor(0, 1));
+    verificar("tamanho errado", !armazemLer(0, v, 5));
+    armazemDescarregar();
+    verificar("descarga", !armazemPendente() && hostFlashEstatisticas()->paginas == 1);
+
+    // O valor sobrevive ao boot
+    armazemInit();
+    verificar("depois do boot", temValor(0, 1) && armazemEstatisticas().invalidos == 0);
+
+    // Várias gravações da mesma chave entre descargas viram um registro; o mesmo valor, nenhum
+    for (uint32_t r = 2; r < 12; ++r) {
+        valor(0, r, v);
+        armazemGravar(0, v, tamanhos[0]);
+    }
+    armazemDescarregar();
+    verificar("gravações agrupadas", armazemEstatisticas().registros == 1 && temValor(0, 11));
+    armazemGravar(0, v, tamanhos[0]);
+    verificar("valor igual", !armazemPendente());
+
+    // Desgaste: muitas descargas espalham os apagamentos por todos os setores
+    hostFlashFormatar();
+    armazemInit();
+    for (uint32_t r = 0; r < 1000; ++r)
+        gravarRodada(r);
+    const hostFlashEstatisticas_t *flash = hostFlashEstatisticas();
+    uint32_t menor = UINT32_MAX, maior = 0;
+    for (uint s = 0; s < HAL_FLASH_SETORES; ++s) {
+        menor = flash->apagamentos[s] < menor ? flash->apagamentos[s] : menor;
+        maior = flash->apagamentos[s] > maior ? flash->apagamentos[s] : maior;
+    }
+    verificar("compactações", armazemEstatisticas().compactacoes > 0);
+    verificar("desgaste nivelado", menor > 0 && maior - menor <= 1);
+    verificar("contagem de páginas", flash->paginas == armazemEstatisticas().paginas &&
+                                     flash->paginas < 2 * 1000 + 2 * armazemEstatisticas().compactacoes);
+    armazemInit();
+    verificar("depois das compactações", rodadaIntacta(999));
+
+    // Cortes de energia em todo ponto da descarga que abre um setor e compacta o mais antigo
+    hostFlashFormatar();
+    armazemInit();
+    uint32_t compacta = 0;
+    while (armazemEstatisticas().compactacoes == 0)
+        gravarRodada(compacta++);
+    bool consistente = true, cortou = false;
+    for (uint32_t r = compacta - 3; r <= compacta && consistente; ++r) {
+        for (uint32_t corte = 0; corte < HAL_FLASH_SETOR + 4 * HAL_FLASH_PAGINA && consistente; corte += 17) {
+            consistente = sobreviveCorte(r, corte);
+            cortou |= hostFlashEstatisticas()->cortes > 0;
+        }
+    }
+    verificar("cortes de energia", consistente && cortou);
+
+    if (falhas) {
+        printf("%d falha(s)\n", falhas);
+        return 1;
+    }
+    printf("OK: armazem\n");
+    return 0;
+}
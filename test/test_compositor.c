@@ -0,0 +1,73 @@
+#include <stdio.h>
+#include <string.h>
+#include "compositor.h"
+
+static int falhas = 0; // Número de verificações que falharam
+
+static void verificar(const char *nome, bool condicao) {
+    if (!condicao) {
+        printf("FALHA: %s\n", nome);
+        falhas++;
+    }
+}
+
+// Camada com todos os pixels da mesma cor (só os da máscara contam)
+static void preencher(npLED_t *pixels, uint8_t r, uint8_t g, uint8_t b) {
+    for (int i = 0; i < LED_COUNT; ++i)
+        pixels[i] = (npLED_t){ .G = g, .R = r, .B = b };
+}
+
+int main() {
+    npLED_t fundo[LED_COUNT], sprite[LED_COUNT], hud[LED_COUNT];
+    uint32_t quadros[2][LED_COUNT];
+    memset(quadros, 0xAA, sizeof(quadros)); // Conteúdo inicial desconhecido
+    preencher(fundo, 0, 0, 32);
+    preencher(sprite, 32, 0, 0);
+    preencher(hud, 16, 16, 16);
+
+    // Início: os dois quadros são compostos inteiros, apagados
+    compositorInit();
+    compositorCompor(quadros[0], 0);
+    bool apagado = true;
+    for (int i = 0; i < LED_COUNT; ++i)
+        apagado = apagado && quadros[0][i] == 0;
+    verificar("início apagado", apagado && compositorEstatisticas().pixels == LED_COUNT);
+
+    // Sobreposição: vale a camada mais alta que cobre o pixel
+    verificar("fundo visível", compositorCamada(CAMADA_FUNDO, fundo, 0x0000F));  // LEDs 0-3: barra
+    verificar("sprite visível", compositorCamada(CAMADA_SPRITE, sprite, 0x00006)); // LEDs 1-2: seta
+    verificar("hud visível", compositorCamada(CAMADA_HUD, hud, 0x00004));          // LED 2: sinal
+    compositorCompor(quadros[1], 1); // O quadro 1 nunca foi composto: sai inteiro
+    verificar("camadas combinadas", quadros[1][0] == npEncode(fundo[0]) && quadros[1][1] == npEncode(sprite[1]) &&
+                                    quadros[1][2] == npEncode(hud[2]) && quadros[1][3] == npEncode(fundo[3]) &&
+                                    quadros[1][4] == 0);
+
+    // Só os pixels que mudaram são recompostos, e em cada um dos dois quadros
+    compositorEstatisticas_t antes = compositorEstatisticas();
+    compositorCompor(quadros[0], 0); // Estava em dia até o início: recebe os 4 pixels alterados
+    verificar("pixels sujos do outro quadro", compositorEstatisticas().pixels - antes.pixels == 4 &&
+                                              memcmp(quadros[0], quadros[1], sizeof(quadros[0])) == 0);
+    antes = compositorEstatisticas();
+    compositorCompor(quadros[1], 1);
+    verificar("nada sujo", compositorEstatisticas().pixels == antes.pixels);
+
+    // Troca escondida por uma camada de cima não suja nada; a mesma camada de novo também não
+    verificar("camada repetida", !compositorCamada(CAMADA_SPRITE, sprite, 0x00006));
+    verificar("pixel escondido sai", !compositorCamada(CAMADA_FUNDO, fundo, 0x0000B)); // LED 2, sob o sinal
+    fundo[1].B = 8;
+    verificar("cor escondida", !compositorCamada(CAMADA_FUNDO, fundo, 0x0000B));       // LED 1, sob a seta
+
+    // Esvaziar uma camada mostra a de baixo, e só esse pixel é recomposto
+    verificar("camada esvaziada", compositorCamada(CAMADA_HUD, NULL, 0));
+    antes = compositorEstatisticas();
+    compositorCompor(quadros[0], 0);
+    verificar("camada de baixo reaparece", quadros[0][2] == npEncode(sprite[2]) && quadros[0][0] == npEncode(fundo[0]) &&
+                                           compositorEstatisticas().pixels - antes.pixels == 1);
+
+    if (falhas) {
+        printf("%d falha(s)\n", falhas);
+        return 1;
+    }
+    printf("OK: compositor\n");
+    return 0;
+}
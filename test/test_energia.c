@@ -0,0 +1,118 @@
+#include <stdio.h>
+#include "hal_host.h"
+#include "pinos.h"
+#include "entrada.h"
+#include "joystick.h"
+#include "escalonador.h"
+#include "medidas.h"
+#include "energia.h"
+
+static int falhas = 0; // Número de verificações que falharam
+
+static void verificar(const char *nome, bool condicao) {
+    if (!condicao) {
+        printf("FALHA: %s\n", nome);
+        falhas++;
+    }
+}
+
+static int acordado; // Chamadas do aviso de borda
+
+static void acordar(void) {
+    acordado++;
+}
+
+// Eventos do mundo virtual executados em 'us' (interrupções do temporizador do joystick, botões)
+static uint64_t eventosEm(uint32_t us) {
+    uint64_t antes = hostEstatisticas()->eventos;
+    halEsperaUs(us);
+    return hostEstatisticas()->eventos - antes;
+}
+
+int main() {
+    hostReiniciar(NULL);
+    halGpioPullUp(BUTTON_COR_1);
+    halGpioPullUp(BUTTON_COR_2);
+    halGpioPullUp(JOYSTICK_SW);
+    medidasInit();
+    entradaInit();
+    joystickInit();
+    escalonadorInit();
+    energiaInit(acordar);
+    entradaEvento_t evento;
+
+    // Fora da pausa: relógio cheio, joystick amostrando e nenhum aviso dos botões
+    verificar("relogio cheio no boot", hostRelogio() == 0 && !energiaPausado());
+    verificar("joystick periodico", eventosEm(100000) >= 100000 / JOYSTICK_PERIODO_US);
+    energiaDormir();
+    energiaAcordar();
+    verificar("fora da pausa nada muda", hostRelogio() == 0 && energiaEstatisticas().reducoes == 0);
+
+    // Pausa: o joystick para; o relógio só cai em energiaDormir
+    energiaPausar();
+    verificar("pausado", energiaPausado() && hostRelogio() == 0);
+    verificar("joystick parado", eventosEm(1000000) == 0);
+    hostDefinirAdc(0, 4095); // Joystick movido na pausa: nada é lido
+    halEsperaUs(50000);
+    verificar("direcao congelada", joystickDirecao() == CENTRO);
+    energiaDormir();
+    verificar("relogio reduzido", hostRelogio() == ENERGIA_RELOGIO_KHZ);
+
+    // Uma borda de botão acorda (aviso em interrupção); a tarefa volta o relógio e dorme de novo
+    hostDefinirPino(BUTTON_COR_1, false);
+    halEsperaUs(ENTRADA_DEBOUNCE_US);
+    verificar("aviso da borda", acordado == 1 && entradaProximo(&evento) && evento.pressionado);
+    verificar("relogio ainda reduzido", hostRelogio() == ENERGIA_RELOGIO_KHZ);
+    energiaAcordar();
+    verificar("acordado com relogio cheio", hostRelogio() == 0 && energiaEstatisticas().despertares == 1 &&
+                                            medida(MEDIDA_DESPERTAR)->amostras == 1);
+    energiaDormir();
+    verificar("dorme de novo", hostRelogio() == ENERGIA_RELOGIO_KHZ && energiaEstatisticas().reducoes == 2);
+    halEsperaUs(100000);
+
+    // Fim da pausa: relógio cheio, joystick de volta (com a posição nova) e botões sem aviso
+    energiaRetomar();
+    energiaEstatisticas_t e = energiaEstatisticas();
+    verificar("retomado", !energiaPausado() && hostRelogio() == 0);
+    verificar("tempos da pausa", e.pausas == 1 && e.pausa_us == 1000000 + 50000 + ENTRADA_DEBOUNCE_US + 100000 &&
+                                 e.reduzido_us == ENTRADA_DEBOUNCE_US + 100000);
+    verificar("joystick de volta", eventosEm(100000) >= 100000 / JOYSTICK_PERIODO_US && joystickDirecao() == CIMA);
+    hostDefinirPino(BUTTON_COR_1, true);
+    halEsperaUs(ENTRADA_DEBOUNCE_US);
+    verificar("sem aviso fora da pausa", acordado == 1 && entradaProximo(&evento) && !evento.pressionado);
+
+    // Espera da cor: a mesma economia, contada à parte, e acordada pelo botão da resposta
+    energiaEsperar();
+    verificar("esperando", energiaEconomizando() && !energiaPausado() && eventosEm(100000) == 0);
+    energiaDormir();
+    halEsperaUs(200000);
+    hostDefinirPino(BUTTON_COR_2, false);
+    halEsperaUs(ENTRADA_DEBOUNCE_US);
+    verificar("aviso na espera", acordado == 2 && entradaProximo(&evento) && evento.pressionado);
+    energiaAcordar();
+    verificar("resposta com relogio cheio", hostRelogio() == 0 && medida(MEDIDA_DESPERTAR)->amostras == 2 &&
+                                            energiaEstatisticas().despertares == 1);
+    energiaRetomar();
+    e = energiaEstatisticas();
+    verificar("fim da espera", !energiaEconomizando() && e.esperas == 1 && e.pausas == 1 &&
+                               e.espera_us == 100000 + 200000 + ENTRADA_DEBOUNCE_US &&
+                               e.espera_reduzido_us == 200000 + ENTRADA_DEBOUNCE_US);
+    verificar("joystick depois da espera", eventosEm(100000) >= 100000 / JOYSTICK_PERIODO_US);
+
+    // Pausa no meio da espera: a espera fecha e a pausa segue com o joystick parado
+    energiaEsperar();
+    halEsperaUs(50000);
+    energiaPausar();
+    verificar("espera vira pausa", energiaPausado() && eventosEm(100000) == 0);
+    energiaRetomar();
+    e = energiaEstatisticas();
+    verificar("contas separadas", e.esperas == 2 && e.espera_us == 100000 + 200000 + ENTRADA_DEBOUNCE_US + 50000 &&
+                                  e.pausas == 2 && !energiaEconomizando());
+
+    if (falhas) {
+        printf("%d falha(s)\n", falhas);
+        return 1;
+    }
+    printf("OK: energia\n");
+    return 0;
+}
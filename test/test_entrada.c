@@ -0,0 +1,96 @@
+#include <stdio.h>
+#include "hal_host.h"
+#include "pinos.h"
+#include "entrada.h"
+
+static int falhas = 0; // Número de verificações que falharam
+
+static void verificar(const char *nome, bool condicao) {
+    if (!condicao) {
+        printf("FALHA: %s\n", nome);
+        falhas++;
+    }
+}
+
+// Prepara os pinos como o main() do jogo e liga as interrupções
+static void preparar(void) {
+    hostReiniciar(NULL);
+    halGpioPullUp(BUTTON_COR_1);
+    halGpioPullUp(BUTTON_COR_2);
+    halGpioPullUp(JOYSTICK_SW);
+    entradaInit();
+}
+
+int main() {
+    entradaEvento_t evento;
+
+    // Toque com repique: um único evento, uma janela depois da última mudança do pino (o filtro do
+    // PIO), com o carimbo dessa mudança
+    preparar();
+    verificar("debounce no PIO", entradaPio());
+    halEsperaUs(1000);
+    hostDefinirPino(BUTTON_COR_1, false); // Pressiona em t = 1000 us
+    halEsperaUs(300);
+    hostDefinirPino(BUTTON_COR_1, true);  // Repique
+    halEsperaUs(300);
+    hostDefinirPino(BUTTON_COR_1, false); // Estável a partir de t = 1600 us
+    halEsperaUs(ENTRADA_DEBOUNCE_US - 1);
+    verificar("nada antes da janela", !entradaProximo(&evento) && !entradaPressionado(BOTAO_COR_1));
+    halEsperaUs(1);
+    verificar("um evento no toque", entradaProximo(&evento) && !entradaProximo(&evento));
+    verificar("carimbo da borda estável", evento.tempo_us == 1600 && evento.botao == BOTAO_COR_1 && evento.pressionado);
+    verificar("estado filtrado pressionado", entradaPressionado(BOTAO_COR_1));
+
+    halEsperaUs(50000);
+    hostDefinirPino(BUTTON_COR_1, true); // Solta
+    halEsperaUs(ENTRADA_DEBOUNCE_US);
+    verificar("evento ao soltar", entradaProximo(&evento) && !evento.pressionado && evento.tempo_us == 56600);
+
+    // Pulso mais curto que a janela (ruído) não vira evento
+    hostDefinirPino(BUTTON_COR_1, false);
+    halEsperaUs(ENTRADA_DEBOUNCE_US / 2);
+    hostDefinirPino(BUTTON_COR_1, true);
+    halEsperaUs(2 * ENTRADA_DEBOUNCE_US);
+    verificar("pulso curto ignorado", !entradaProximo(&evento) && !entradaPressionado(BOTAO_COR_1));
+
+    // Toque curto (10 ms) entre duas leituras do laço antigo de 50 ms não se perde
+    halEsperaUs(20000);
+    hostDefinirPino(BUTTON_COR_2, false);
+    halEsperaUs(10000);
+    hostDefinirPino(BUTTON_COR_2, true);
+    halEsperaUs(ENTRADA_DEBOUNCE_US);
+    verificar("toque curto: pressionado", entradaProximo(&evento) && evento.botao == BOTAO_COR_2 && evento.pressionado);
+    verificar("toque curto: solto", entradaProximo(&evento) && evento.botao == BOTAO_COR_2 && !evento.pressionado);
+
+    // Botão já apertado no boot (modo sem fim): o estado inicial vem do pino, sem evento
+    hostReiniciar(NULL);
+    hostDefinirPino(BUTTON_COR_1, false);
+    halGpioPullUp(BUTTON_COR_2);
+    halGpioPullUp(JOYSTICK_SW);
+    entradaInit();
+    halEsperaUs(2 * ENTRADA_DEBOUNCE_US);
+    verificar("apertado no boot", entradaPressionado(BOTAO_COR_1) && !entradaProximo(&evento));
+
+    // entradaAguardar acorda no instante do evento, não no fim do prazo
+    preparar();
+    verificar("aguardar sem evento expira", !entradaAguardar(&evento, 5) && halTempoUs() == 5000);
+
+    // Fila cheia: excedentes são contados, os primeiros são preservados em ordem
+    preparar();
+    for (int i = 0; i < ENTRADA_FILA + 4; ++i) {
+        hostDefinirPino(JOYSTICK_SW, i % 2 != 0);
+        halEsperaUs(ENTRADA_DEBOUNCE_US);
+    }
+    verificar("descartados contados", entradaDescartados() == 4);
+    bool ordem = true;
+    for (int i = 0; i < ENTRADA_FILA; ++i)
+        ordem = ordem && entradaProximo(&evento) && evento.pressionado == (i % 2 == 0);
+    verificar("ordem preservada", ordem && !entradaProximo(&evento));
+
+    if (falhas) {
+        printf("%d falha(s)\n", falhas);
+        return 1;
+    }
+    printf("OK: entrada\n");
+    return 0;
+}
@@ -0,0 +1,141 @@
+#include <stdio.h>
+#include <string.h>
+#include "hal_host.h"
+#include "escalonador.h"
+
+static int falhas = 0; // Número de verificações que falharam
+
+static void verificar(const char *nome, bool condicao) {
+    if (!condicao) {
+        printf("FALHA: %s\n", nome);
+        falhas++;
+    }
+}
+
+static int periodica, sob_demanda, lenta, urgente;
+static uint64_t tempos[32];
+static int n_tempos;
+static char ordem[8];
+static int n_ordem;
+
+static void encerrar(void *contexto) {
+    hostEncerrar();
+}
+
+// Roda o escalonador por 'duracao_us' de tempo virtual
+static void rodar(uint64_t duracao_us) {
+    hostAgendar(halTempoUs() + duracao_us, encerrar, NULL);
+    escalonadorExecutar();
+}
+
+static void tarefaPeriodica(void) {
+    if (n_tempos < 32)
+        tempos[n_tempos++] = halTempoUs();
+    if (n_tempos == 3)
+        escalonadorAcordar(sob_demanda); // Roda logo em seguida, no mesmo instante
+}
+
+static void tarefaSobDemanda(void) {
+    tempos[n_tempos++] = halTempoUs() | (1ULL << 63); // Marca a execução sob demanda
+}
+
+static void interrupcao(void *contexto) {
+    escalonadorAcordarIrq(sob_demanda);
+}
+
+static void tarefaLenta(void) {
+    ordem[n_ordem++] = 'L';
+    halEsperaUs(3000); // Passa do prazo de 1 ms
+}
+
+static void tarefaUrgente(void) {
+    ordem[n_ordem++] = 'U';
+}
+
+static int pendentes; // Trabalho de fundo restante
+
+static void tarefaMarca(void) {
+    if (n_ordem < 8)
+        ordem[n_ordem++] = 'P';
+}
+
+static bool trabalhoDeFundo(void) {
+    if (!pendentes)
+        return false;
+    pendentes--;
+    ordem[n_ordem++] = 'O';
+    halEsperaUs(100);
+    return true;
+}
+
+int main() {
+    // Periódica a cada 1 ms, sem deriva; o núcleo dorme entre as liberações
+    hostReiniciar(NULL);
+    escalonadorInit();
+    periodica = escalonadorTarefa("periodica", tarefaPeriodica, 1000, 0);
+    sob_demanda = escalonadorTarefa("sob_demanda", tarefaSobDemanda, 0, 0);
+    rodar(9500);
+    bool regular = true;
+    for (int i = 0, k = 0; i < n_tempos; ++i) {
+        if (tempos[i] >> 63)
+            continue;
+        regular = regular && tempos[i] == (uint64_t)k++ * 1000;
+    }
+    verificar("período sem deriva", regular && escalonadorTarefaEstatisticas(periodica)->execucoes == 10);
+    verificar("sob demanda roda uma vez, no instante em que foi acordada",
+              escalonadorTarefaEstatisticas(sob_demanda)->execucoes == 1 && tempos[3] == ((1ULL << 63) | 2000));
+    escalonadorEstatisticas_t e = escalonadorEstatisticas();
+    verificar("tempo todo ocioso", e.total_us == 9500 && e.ocioso_us == 9500 && e.despertares >= 10);
+
+    // Agendada para o futuro: roda só no instante pedido
+    hostReiniciar(NULL);
+    escalonadorInit();
+    n_tempos = 0;
+    sob_demanda = escalonadorTarefa("sob_demanda", tarefaSobDemanda, 0, 0);
+    escalonadorAgendar(sob_demanda, 4321);
+    rodar(10000);
+    verificar("agendada", n_tempos == 1 && tempos[0] == ((1ULL << 63) | 4321));
+
+    // Acordada por uma interrupção: roda assim que o núcleo volta de halOcioso
+    hostReiniciar(NULL);
+    escalonadorInit();
+    n_tempos = 0;
+    sob_demanda = escalonadorTarefa("sob_demanda", tarefaSobDemanda, 0, 0);
+    hostAgendar(2500, interrupcao, NULL);
+    rodar(10000);
+    verificar("acordada em interrupção", n_tempos == 1 && tempos[0] == ((1ULL << 63) | 2500));
+
+    // Prazo mais próximo primeiro; a execução longa conta como perda de prazo e como tempo ocupado
+    hostReiniciar(NULL);
+    escalonadorInit();
+    lenta = escalonadorTarefa("lenta", tarefaLenta, 0, 1000);
+    urgente = escalonadorTarefa("urgente", tarefaUrgente, 0, 500);
+    escalonadorAgendar(lenta, 1000);
+    escalonadorAgendar(urgente, 1000);
+    rodar(10000);
+    verificar("prazo mais próximo primeiro", n_ordem == 2 && ordem[0] == 'U' && ordem[1] == 'L');
+    const tarefaEstatisticas_t *t = escalonadorTarefaEstatisticas(lenta);
+    verificar("perda de prazo", t->perdas == 1 && t->pior_us == 3000 && t->ocupado_us == 3000);
+    verificar("urgente no prazo", escalonadorTarefaEstatisticas(urgente)->perdas == 0);
+    e = escalonadorEstatisticas();
+    verificar("ocioso desconta o tempo ocupado", e.ocioso_us == 10000 - 3000);
+
+    // Trabalho ocioso: só roda sem tarefa liberada, um pedaço por vez, e não conta como ocioso
+    hostReiniciar(NULL);
+    escalonadorInit();
+    n_ordem = 0;
+    pendentes = 3;
+    escalonadorTarefa("marca", tarefaMarca, 1000, 0);
+    escalonadorOcioso(trabalhoDeFundo);
+    rodar(1500);
+    verificar("trabalho de fundo depois da tarefa", n_ordem == 5 && memcmp(ordem, "POOOP", 5) == 0);
+    e = escalonadorEstatisticas();
+    verificar("trabalho de fundo não é ocioso", e.ocioso_us == 1500 - 300);
+
+    if (falhas) {
+        printf("%d falha(s)\n", falhas);
+        return 1;
+    }
+    printf("OK: escalonador\n");
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include <stdio.h>
+#include "hal_host.h"
+#include "joystick.h"
+
+static int falhas = 0; // Número de verificações que falharam
+
+static void verificar(const char *nome, bool condicao) {
+    if (!condicao) {
+        printf("FALHA: %s\n", nome);
+        falhas++;
+    }
+}
+
+// Inicia a amostragem com o joystick solto em (x, y)
+static void preparar(uint16_t x, uint16_t y, uint16_t ruido) {
+    hostReiniciar(NULL);
+    hostDefinirAdc(1, x);
+    hostDefinirAdc(0, y);
+    hostDefinirRuidoAdc(ruido);
+    joystickInit();
+}
+
+// Move o joystick e espera a média se renovar
+static void mover(uint16_t x, uint16_t y) {
+    hostDefinirAdc(1, x);
+    hostDefinirAdc(0, y);
+    halEsperaMs(20);
+}
+
+int main() {
+    int16_t x, y;
+
+    // Calibração: o centro é o ponto de repouso, não 2048
+    preparar(2300, 1800, 0);
+    joystickCentro(&x, &y);
+    verificar("centro calibrado", x == 2300 && y == 1800);
+    halEsperaMs(20);
+    verificar("solto no centro", joystickDirecao() == CENTRO);
+
+    // Os limiares contam a partir do centro medido
+    mover(2300 + 500, 1800);
+    verificar("abaixo do limiar de entrada", joystickDirecao() == CENTRO);
+    mover(2300 + 700, 1800);
+    verificar("direita", joystickDirecao() == DIREITA);
+    joystickEixos(&x, &y);
+    verificar("desvio filtrado", x == 700 && y == 0);
+
+    // Histerese: voltar para entre os limiares mantém a direção; abaixo do de saída, solta
+    mover(2300 + 400, 1800);
+    verificar("histerese mantém", joystickDirecao() == DIREITA);
+    mover(2300 + 200, 1800);
+    verificar("abaixo do limiar de saída", joystickDirecao() == CENTRO);
+
+    mover(2300, 0);
+    verificar("baixo", joystickDirecao() == BAIXO);
+    mover(0, 4095);
+    verificar("x tem prioridade", joystickDirecao() == ESQUERDA);
+
+    // Direção injetada vale no lugar da medida até ser desfeita
+    joystickInjetar(CIMA);
+    verificar("injetada", joystickDirecao() == CIMA);
+    joystickInjetar(JOYSTICK_LOCAL);
+    verificar("de volta à medida", joystickDirecao() == ESQUERDA);
+
+    // Ruído perto do limiar: sem histerese a direção oscilaria a cada atualização
+    preparar(2048, 2048, 150);
+    mover(2048, 2048 + 600);
+    Direcao anterior = joystickDirecao();
+    int trocas = 0;
+    for (int i = 0; i < 200; ++i) {
+        halEsperaUs(JOYSTICK_PERIODO_US);
+        if (joystickDirecao() != anterior)
+            trocas++;
+        anterior = joystickDirecao();
+    }
+    verificar("ruído não causa oscilação", trocas <= 1);
+
+    if (falhas) {
+        printf("%d falha(s)\n", falhas);
+        return 1;
+    }
+    printf("OK: joystick\n");
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include <stdio.h>
+#include <string.h>
+#include "medidas.h"
+
+static int falhas = 0; // Número de verificações que falharam
+
+static void verificar(const char *nome, bool condicao) {
+    if (!condicao) {
+        printf("FALHA: %s\n", nome);
+        falhas++;
+    }
+}
+
+int main() {
+    // Baldes: número de bits significativos
+    verificar("baldes", histogramaBalde(0) == 0 && histogramaBalde(1) == 1 && histogramaBalde(2) == 2 &&
+                        histogramaBalde(3) == 2 && histogramaBalde(1024) == 11 && histogramaBalde(2047) == 11 &&
+                        histogramaBalde(UINT32_MAX) == HISTOGRAMA_BALDES - 1);
+
+    // Contagem, soma, mínimo e máximo
+    histograma_t h;
+    histogramaLimpar(&h);
+    verificar("vazio", h.amostras == 0 && histogramaPercentil(&h, 50) == 0 && h.minimo == UINT32_MAX);
+    for (uint32_t v = 1; v <= 100; ++v) // 1..100 us
+        histogramaAdicionar(&h, v);
+    verificar("contadores", h.amostras == 100 && h.soma == 5050 && h.minimo == 1 && h.maximo == 100);
+    verificar("balde de 64 a 100", h.baldes[7] == 37 && h.baldes[6] == 32);
+
+    // Percentis com a resolução dos baldes: o limite superior do balde, nunca acima do máximo
+    verificar("mediana", histogramaPercentil(&h, 50) == 63);  // A 50ª amostra está em [32, 64)
+    verificar("p90", histogramaPercentil(&h, 90) == 100);     // [64, 128), limitado ao máximo
+    verificar("p1", histogramaPercentil(&h, 1) == 1);
+
+    // Soma de histogramas (o simulador junta as sessões)
+    histograma_t total;
+    histogramaLimpar(&total);
+    histogramaSomar(&total, &h);
+    histogramaSomar(&total, &h);
+    verificar("soma", total.amostras == 200 && total.soma == 10100 && total.minimo == 1 && total.maximo == 100 &&
+                      total.baldes[7] == 74);
+
+    // Medidas do jogo: cada uma no seu histograma, com nome e unidade
+    medidasInit();
+    medir(MEDIDA_REACAO_COR, 250000);
+    medir(MEDIDA_REACAO_COR, 300000);
+    medir(MEDIDA_FIO, 850);
+    verificar("medidas separadas", medida(MEDIDA_REACAO_COR)->amostras == 2 && medida(MEDIDA_FIO)->amostras == 1 &&
+                                   medida(MEDIDA_REACAO_DIRECAO)->amostras == 0);
+    verificar("nomes", strcmp(medidaNome(MEDIDA_REACAO_COR), "reacao_cor") == 0 &&
+                       strcmp(medidaUnidade(MEDIDA_ENVIO), "ciclos") == 0);
+    medidasInit();
+    verificar("zeradas", medida(MEDIDA_REACAO_COR)->amostras == 0);
+
+    if (falhas) {
+        printf("%d falha(s)\n", falhas);
+        return 1;
+    }
+    printf("OK: medidas\n");
+    return 0;
+}
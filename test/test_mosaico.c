@@ -0,0 +1,78 @@
+// Compilado com o próprio mosaico: 3x1 painéis em 2 cadeias (a segunda cadeia tem um painel a menos)
+#include <stdio.h>
+#include "sprites.h"
+#include "mosaico.h"
+
+static int falhas = 0; // Número de verificações que falharam
+
+static void verificar(const char *nome, bool condicao) {
+    if (!condicao) {
+        printf("FALHA: %s\n", nome);
+        falhas++;
+    }
+}
+
+// Índice físico do LED 'led' do painel na posição 'ordem' da cadeia 'cadeia'
+static uint fisico(uint cadeia, uint ordem, uint led) {
+    return cadeia * MOSAICO_LEDS_POR_CADEIA + ordem * PAINEL_LEDS + led;
+}
+
+int main() {
+    // Tabela padrão: painéis da esquerda para a direita, dois na cadeia 0 e um na cadeia 1
+    mosaicoInit();
+    verificar("tamanhos", MOSAICO_LEDS_POR_CADEIA == 2 * PAINEL_LEDS && MOSAICO_LEDS == 4 * PAINEL_LEDS);
+    verificar("não é direto", !mosaicoDireto());
+    // O LED 0 de um painel em serpentina fica no canto inferior direito; cada pixel lógico vira 3x1 LEDs
+    verificar("primeiro painel", mosaicoOrigem(fisico(0, 0, 0)) == SPRITE_INDICE(1, 4) &&
+                                 mosaicoOrigem(fisico(0, 0, 24)) == SPRITE_INDICE(0, 0));
+    verificar("segundo painel", mosaicoOrigem(fisico(0, 1, 0)) == SPRITE_INDICE(3, 4));
+    verificar("terceiro painel na outra cadeia", mosaicoOrigem(fisico(1, 0, 0)) == SPRITE_INDICE(4, 4));
+    bool sobra = true;
+    for (uint led = 0; led < PAINEL_LEDS; ++led)
+        sobra = sobra && mosaicoOrigem(fisico(1, 1, led)) == MOSAICO_APAGADO;
+    verificar("posição sem painel apagada", sobra);
+
+    // Cada pixel lógico acende exatamente um bloco de 3 LEDs, e a amostra volta ao mesmo pixel
+    int contagem[LED_COUNT] = { 0 };
+    for (uint i = 0; i < MOSAICO_LEDS; ++i)
+        if (mosaicoOrigem(i) != MOSAICO_APAGADO)
+            contagem[mosaicoOrigem(i)]++;
+    bool blocos = true, ida_e_volta = true;
+    for (uint i = 0; i < LED_COUNT; ++i) {
+        blocos = blocos && contagem[i] == MOSAICO_PAINEIS_X * MOSAICO_PAINEIS_Y;
+        ida_e_volta = ida_e_volta && mosaicoOrigem(mosaicoAmostra(i)) == i;
+    }
+    verificar("blocos 3x1", blocos);
+    verificar("amostra", ida_e_volta);
+
+    // Expansão: cada LED recebe a palavra do seu pixel lógico, a sobra recebe zero
+    uint32_t logico[LED_COUNT], saida[MOSAICO_LEDS];
+    for (uint i = 0; i < LED_COUNT; ++i)
+        logico[i] = 0x010203 * (i + 1);
+    mosaicoExpandir(logico, saida);
+    bool expandido = true;
+    for (uint i = 0; i < MOSAICO_LEDS; ++i)
+        expandido = expandido && saida[i] == (mosaicoOrigem(i) == MOSAICO_APAGADO ? 0 : logico[mosaicoOrigem(i)]);
+    verificar("expansão", expandido);
+
+    // Tabela própria: fiações e rotações diferentes, cadeias em outra ordem
+    static const mosaicoPainel_t tabela[MOSAICO_PAINEIS] = {
+        { 1, 0, 0, 0, PAINEL_LINHAS, 2 },     // Linha a linha, de ponta-cabeça
+        { 0, 0, 1, 0, PAINEL_SERPENTINA, 0 },
+        { 0, 1, 2, 0, PAINEL_SERPENTINA, 1 }, // Um quarto de volta no sentido horário
+    };
+    mosaicoDefinir(tabela);
+    mosaicoInit();
+    verificar("linhas de ponta-cabeça", mosaicoOrigem(fisico(1, 0, 0)) == SPRITE_INDICE(1, 4) &&
+                                        mosaicoOrigem(fisico(1, 0, 24)) == SPRITE_INDICE(0, 0));
+    verificar("painel girado", mosaicoOrigem(fisico(0, 1, 0)) == SPRITE_INDICE(3, 4) &&
+                               mosaicoOrigem(fisico(0, 1, 4)) == SPRITE_INDICE(3, 0));
+    verificar("sobra na outra cadeia", mosaicoOrigem(fisico(1, 1, 0)) == MOSAICO_APAGADO);
+
+    if (falhas) {
+        printf("%d falha(s)\n", falhas);
+        return 1;
+    }
+    printf("OK: mosaico\n");
+    return 0;
+}
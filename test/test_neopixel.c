@@ -0,0 +1,116 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "neopixel.h"
+#include "hal_host.h"
+#include "pinos.h"
+
+#define BITS_POR_QUADRO (LED_COUNT * 24) // 24 bits por LED no fio
+
+static int falhas = 0; // Número de verificações que falharam
+
+// Modelo do ws2818b: autopull a cada 'bits' bits, deslocando para a direita (LSB primeiro)
+static int serializar(const uint32_t *palavras, int n, int bits, uint8_t *saida) {
+    int total = 0;
+    for (int i = 0; i < n; ++i)
+        for (int b = 0; b < bits; ++b)
+            saida[total++] = (palavras[i] >> b) & 1;
+    return total;
+}
+
+// Sequência de bits gerada pelo npWrite original: três palavras de 8 bits por LED (G, R, B)
+static int serializarLegado(const npLED_t *quadro, uint8_t *saida) {
+    uint32_t palavras[LED_COUNT * 3];
+    for (int i = 0; i < LED_COUNT; ++i) {
+        palavras[i * 3 + 0] = quadro[i].G;
+        palavras[i * 3 + 1] = quadro[i].R;
+        palavras[i * 3 + 2] = quadro[i].B;
+    }
+    return serializar(palavras, LED_COUNT * 3, 8, saida);
+}
+
+// Compara o fio do caminho antigo com o da palavra GRB empacotada
+static void verificarQuadro(const char *nome, const npLED_t *quadro) {
+    uint8_t legado[BITS_POR_QUADRO], novo[BITS_POR_QUADRO];
+    uint32_t palavras[LED_COUNT];
+    npEncodeFrame(quadro, palavras, LED_COUNT);
+    int n_legado = serializarLegado(quadro, legado);
+    int n_novo = serializar(palavras, LED_COUNT, 24, novo);
+    if (n_legado != n_novo || memcmp(legado, novo, BITS_POR_QUADRO) != 0) {
+        printf("FALHA: %s\n", nome);
+        falhas++;
+    }
+    for (int i = 0; i < LED_COUNT; ++i) {
+        if (palavras[i] >> 24) { // Os 8 bits superiores nunca chegam ao fio
+            printf("FALHA: %s (bits acima de 24 no LED %d)\n", nome, i);
+            falhas++;
+        }
+    }
+}
+
+// Quadros iguais ao anterior não vão para o fio
+static void verificarQuadrosRepetidos(void) {
+    hostReiniciar(NULL);
+    npInit((const uint[])LED_PINOS);
+    npWrite();             // Primeiro quadro sempre vai: o estado inicial dos LEDs é desconhecido
+    npWrite();             // Igual ao anterior
+    npSetLED(3, 0, 0, 32);
+    npWrite();             // Mudou
+    npWrite();             // Igual
+    npWrite();             // Igual
+    npSetLED(3, 0, 0, 32);
+    npWrite();             // Mesmo valor reescrito: igual
+    npStats_t stats = npGetStats();
+    if (stats.submitted != 6 || stats.sent != 2 || hostEstatisticas()->quadros != 2) {
+        printf("FALHA: quadros repetidos (submetidos=%u enviados=%u no fio=%llu)\n", (unsigned)stats.submitted,
+               (unsigned)stats.sent, (unsigned long long)hostEstatisticas()->quadros);
+        falhas++;
+    }
+    if (hostQuadro()[3].B != 32) {
+        printf("FALHA: quadro no fio não corresponde ao último enviado\n");
+        falhas++;
+    }
+}
+
+int main() {
+    npLED_t quadro[LED_COUNT];
+
+    verificarQuadrosRepetidos();
+
+    memset(quadro, 0, sizeof(quadro));
+    verificarQuadro("apagado", quadro);
+
+    memset(quadro, 0xFF, sizeof(quadro));
+    verificarQuadro("branco", quadro);
+
+    for (int i = 0; i < LED_COUNT; ++i) { // Cores usadas pelo jogo
+        quadro[i].R = (i % 3 == 0) ? 32 : 0;
+        quadro[i].G = (i % 3 == 1) ? 32 : 0;
+        quadro[i].B = (i % 3 == 2) ? 32 : 0;
+    }
+    verificarQuadro("cores do jogo", quadro);
+
+    for (int i = 0; i < LED_COUNT; ++i) { // Um único bit aceso por componente
+        quadro[i].G = (uint8_t)(1u << (i % 8));
+        quadro[i].R = (uint8_t)(0x80u >> (i % 8));
+        quadro[i].B = (uint8_t)(1u << ((i + 3) % 8));
+    }
+    verificarQuadro("bits isolados", quadro);
+
+    srand(1234);
+    for (int k = 0; k < 1000; ++k) { // Quadros aleatórios
+        for (int i = 0; i < LED_COUNT; ++i) {
+            quadro[i].G = (uint8_t)rand();
+            quadro[i].R = (uint8_t)rand();
+            quadro[i].B = (uint8_t)rand();
+        }
+        verificarQuadro("aleatorio", quadro);
+    }
+
+    if (falhas) {
+        printf("%d falha(s)\n", falhas);
+        return 1;
+    }
+    printf("OK: quadro codificado identico ao npWrite original\n");
+    return 0;
+}
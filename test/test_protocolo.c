@@ -0,0 +1,120 @@
+#include <stdio.h>
+#include <string.h>
+#include "protocolo.h"
+
+static int falhas = 0; // Número de verificações que falharam
+
+static void verificar(const char *nome, bool condicao) {
+    if (!condicao) {
+        printf("FALHA: %s\n", nome);
+        falhas++;
+    }
+}
+
+// Lado que recebe: um buffer de payload e a última mensagem entregue
+static uint8_t buffer[PROTOCOLO_MAX_PAYLOAD];
+static uint32_t capacidade = sizeof(buffer);
+static int entregues;
+static uint8_t ultimo_tipo, ultimo_seq;
+static uint32_t ultimo_tamanho;
+
+static uint8_t *destino(uint8_t tipo, uint32_t *cap) {
+    if (tipo == 0x7F) // Tipo que o teste recusa
+        return NULL;
+    *cap = capacidade;
+    return buffer;
+}
+
+static void mensagem(uint8_t tipo, uint8_t seq, uint8_t *payload, uint32_t tamanho) {
+    entregues++;
+    ultimo_tipo = tipo;
+    ultimo_seq = seq;
+    ultimo_tamanho = tamanho;
+}
+
+int main() {
+    protocoloDecodificador_t d;
+    uint8_t fio[4 * PROTOCOLO_MAX_FIO(PROTOCOLO_MAX_PAYLOAD)];
+    uint8_t payload[PROTOCOLO_MAX_PAYLOAD];
+
+    // CRC-16/CCITT-FALSE de "123456789" é 0x29B1
+    verificar("crc", protocoloCrc(0xFFFF, (const uint8_t *)"123456789", 9) == 0x29B1);
+
+    // Ida e volta, com zeros no payload: nenhum zero no fio antes do delimitador
+    for (uint32_t i = 0; i < sizeof(payload); ++i)
+        payload[i] = (uint8_t)(i % 7 == 0 ? 0 : i * 37);
+    uint32_t n = protocoloCodificar(PROTO_QUADRO, 42, payload, 75, fio);
+    bool sem_zero = fio[n - 1] == 0 && n <= PROTOCOLO_MAX_FIO(75);
+    for (uint32_t i = 0; i < n - 1; ++i)
+        sem_zero = sem_zero && fio[i] != 0;
+    verificar("sem zeros no fio", sem_zero);
+    protocoloIniciar(&d, destino, mensagem);
+    protocoloReceber(&d, fio, n);
+    verificar("ida e volta", entregues == 1 && ultimo_tipo == PROTO_QUADRO && ultimo_seq == 42 &&
+                             ultimo_tamanho == 75 && memcmp(buffer, payload, 75) == 0);
+
+    // Um byte por vez dá o mesmo resultado
+    memset(buffer, 0, sizeof(buffer));
+    for (uint32_t i = 0; i < n; ++i)
+        protocoloReceber(&d, &fio[i], 1);
+    verificar("byte a byte", entregues == 2 && memcmp(buffer, payload, 75) == 0);
+
+    // Sem payload e com payload só de zeros
+    n = protocoloCodificar(PROTO_CONSULTA, 1, NULL, 0, fio);
+    protocoloReceber(&d, fio, n);
+    verificar("sem payload", entregues == 3 && ultimo_tipo == PROTO_CONSULTA && ultimo_tamanho == 0);
+    memset(payload, 0, sizeof(payload));
+    n = protocoloCodificar(PROTO_ECO, 2, payload, 10, fio);
+    protocoloReceber(&d, fio, n);
+    verificar("payload de zeros", entregues == 4 && ultimo_tamanho == 10 && buffer[0] == 0 && buffer[9] == 0);
+
+    // Bloco COBS cheio (254 bytes sem zero) exige o código 0xFF
+    for (uint32_t i = 0; i < sizeof(payload); ++i)
+        payload[i] = (uint8_t)(i + 1);
+    uint8_t longo[300];
+    for (uint32_t i = 0; i < sizeof(longo); ++i)
+        longo[i] = (uint8_t)(i % 255 + 1);
+    uint8_t fio_longo[PROTOCOLO_MAX_FIO(300)];
+    n = protocoloCodificar(PROTO_ECO, 3, longo, 300, fio_longo);
+    capacidade = 0; // Não cabe: erro, e o decodificador segue para a próxima
+    protocoloReceber(&d, fio_longo, n);
+    verificar("maior que o destino", entregues == 4 && d.estatisticas.erros == 1);
+    capacidade = sizeof(buffer);
+    n = protocoloCodificar(PROTO_ECO, 4, payload, PROTOCOLO_MAX_PAYLOAD, fio);
+    protocoloReceber(&d, fio, n);
+    verificar("payload máximo", entregues == 5 && ultimo_tamanho == PROTOCOLO_MAX_PAYLOAD &&
+                                memcmp(buffer, payload, PROTOCOLO_MAX_PAYLOAD) == 0);
+
+    // CRC corrompido: nada entregue, erro contado
+    n = protocoloCodificar(PROTO_ENTRADA, 5, payload, 2, fio);
+    fio[3] ^= 0x10;
+    protocoloReceber(&d, fio, n);
+    verificar("crc corrompido", entregues == 5 && d.estatisticas.erros == 2);
+
+    // Lixo e uma mensagem cortada no meio: a seguinte é recuperada no delimitador
+    const uint8_t lixo[] = { 0x13, 0x37, 0xFF, 0x42 };
+    protocoloReceber(&d, lixo, sizeof(lixo));
+    n = protocoloCodificar(PROTO_QUADRO, 6, payload, 75, fio);
+    protocoloReceber(&d, fio, n / 2);          // Metade da mensagem, emendada no lixo
+    uint32_t m = protocoloCodificar(PROTO_ENTRADA, 7, payload, 2, fio + n);
+    protocoloReceber(&d, fio + n, m);          // O zero dela fecha a mensagem quebrada
+    protocoloReceber(&d, fio + n, m);
+    verificar("ressincroniza", entregues == 6 && ultimo_seq == 7 && d.estatisticas.erros == 3);
+
+    // Tipo sem destino é descartado sem erro
+    n = protocoloCodificar(0x7F, 8, payload, 4, fio);
+    protocoloReceber(&d, fio, n);
+    verificar("sem destino", entregues == 6 && d.estatisticas.descartadas == 1 && d.estatisticas.erros == 3);
+
+    // Zeros soltos entre mensagens são ignorados
+    const uint8_t zeros[] = { 0, 0, 0 };
+    protocoloReceber(&d, zeros, sizeof(zeros));
+    verificar("zeros soltos", d.estatisticas.erros == 3 && d.estatisticas.mensagens == 6);
+
+    if (falhas) {
+        printf("%d falha(s)\n", falhas);
+        return 1;
+    }
+    printf("OK: protocolo\n");
+    return 0;
+}
@@ -0,0 +1,47 @@
+#include <stdio.h>
+#include <string.h>
+#include "rastro.h"
+
+static int falhas = 0; // Número de verificações que falharam
+
+static void verificar(const char *nome, bool condicao) {
+    if (!condicao) {
+        printf("FALHA: %s\n", nome);
+        falhas++;
+    }
+}
+
+int main() {
+    // Eventos ficam em ordem, com os 32 bits baixos do instante
+    rastroInit();
+    rastrear(0x100000005ull, RASTRO_SEMENTE, 1, 0, 0x9E3779B9u);
+    rastrear(10, RASTRO_BOTAO, 2, 1, 0);
+    const rastroEvento_t *e = rastroEventos();
+    verificar("dois eventos", rastroTamanho() == 2 && rastroPerdidos() == 0);
+    verificar("semente", e[0].tempo_us == 5 && e[0].tipo == RASTRO_SEMENTE && e[0].a == 1 && e[0].c == 0x9E3779B9u);
+    verificar("botao", e[1].tempo_us == 10 && e[1].tipo == RASTRO_BOTAO && e[1].a == 2 && e[1].b == 1);
+
+    // Camadas param na reserva; as entradas ainda cabem até o fim do vetor
+    rastroInit();
+    for (uint32_t i = 0; i < RASTRO_EVENTOS; ++i)
+        rastrear(i, RASTRO_CAMADA, 0, 0, 0);
+    verificar("camadas fora da reserva", rastroTamanho() == RASTRO_EVENTOS - RASTRO_RESERVA &&
+                                         rastroPerdidos() == RASTRO_RESERVA);
+    for (uint32_t i = 0; i < RASTRO_RESERVA + 3; ++i)
+        rastrear(i, RASTRO_DIRECAO, 1, 0, 0);
+    verificar("reserva para as entradas", rastroTamanho() == RASTRO_EVENTOS && rastroPerdidos() == RASTRO_RESERVA + 3);
+    verificar("ultimo evento", rastroEventos()[RASTRO_EVENTOS - 1].tipo == RASTRO_DIRECAO);
+
+    // Reinício esvazia o vetor e zera os perdidos
+    rastroInit();
+    verificar("vazio", rastroTamanho() == 0 && rastroPerdidos() == 0);
+
+    verificar("nomes", strcmp(rastroNome(RASTRO_VEREDITO), "veredito") == 0 && strcmp(rastroNome(RASTRO_NUM_TIPOS), "?") == 0);
+
+    if (falhas) {
+        printf("%d falha(s)\n", falhas);
+        return 1;
+    }
+    printf("OK: rastro\n");
+    return 0;
+}
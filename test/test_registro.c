@@ -0,0 +1,118 @@
+#include <stdio.h>
+#include <string.h>
+#include "hal_host.h"
+#include "registro.h"
+
+static int falhas = 0; // Número de verificações que falharam
+
+static void verificar(const char *nome, bool condicao) {
+    if (!condicao) {
+        printf("FALHA: %s\n", nome);
+        falhas++;
+    }
+}
+
+// Registros entregues pela drenagem
+static registro_t recebidos[REGISTRO_ANEL + 8];
+static int n_recebidos;
+static bool saida_cheia; // A saída recusa tudo, como um USB que ninguém lê
+
+static bool receber(const registro_t *registro) {
+    if (saida_cheia)
+        return false;
+    recebidos[n_recebidos++] = *registro;
+    return true;
+}
+
+static bool texto(registroEvento_t evento, int32_t a, int32_t b, const char *esperado) {
+    registro_t r = { 0, evento, { a, b } };
+    char t[96];
+    size_t n = registroFormatar(&r, t, sizeof(t));
+    if (strcmp(t, esperado) != 0 || n != strlen(esperado)) {
+        printf("  \"%s\" != \"%s\"\n", t, esperado);
+        return false;
+    }
+    return true;
+}
+
+int main() {
+    hostReiniciar(NULL);
+    registroDefinirSaida(receber);
+
+    // Registros saem em ordem, com o instante em que foram gravados
+    registroInit();
+    halEsperaUs(1234);
+    registrar(REG_NIVEL, 3, 0);
+    halEsperaUs(10);
+    registrar(REG_DIRECAO, 1, 2);
+    n_recebidos = 0;
+    while (registroDrenar())
+        ;
+    verificar("dois registros", n_recebidos == 2 && registroGravados() == 2);
+    verificar("instante e argumentos", recebidos[0].tempo_us == 1234 && recebidos[0].evento == REG_NIVEL &&
+                                       recebidos[0].args[0] == 3 && recebidos[1].tempo_us == 1244 &&
+                                       recebidos[1].args[1] == 2);
+    verificar("vazio", !registroDrenar());
+
+    // Anel cheio: o excedente é contado e o aviso sai no lugar do buraco, depois dos registros
+    // que já estavam no anel e antes dos que vieram depois, com o instante da primeira perda
+    registroInit();
+    halEsperaUs(100);
+    for (int i = 0; i < REGISTRO_ANEL; ++i)
+        registrar(REG_REACAO, i, 0);
+    uint32_t inicio_perda = (uint32_t)halTempoUs();
+    for (int i = 0; i < 5; ++i) {
+        registrar(REG_REACAO, REGISTRO_ANEL + i, 0);
+        halEsperaUs(10);
+    }
+    verificar("perdidos contados", registroPerdidos() == 5 && registroGravados() == REGISTRO_ANEL);
+    registroDrenar(); // Abre um lugar: o registro seguinte entra depois do buraco
+    registrar(REG_REACAO, 99, 0);
+    n_recebidos = 0;
+    while (registroDrenar())
+        ;
+    verificar("mais antigos primeiro", n_recebidos == REGISTRO_ANEL + 1 && recebidos[0].args[0] == 1 &&
+                                       recebidos[REGISTRO_ANEL - 2].args[0] == REGISTRO_ANEL - 1);
+    verificar("aviso no lugar do buraco", recebidos[REGISTRO_ANEL - 1].evento == REG_PERDIDOS &&
+                                          recebidos[REGISTRO_ANEL - 1].args[0] == 5 &&
+                                          recebidos[REGISTRO_ANEL - 1].tempo_us == inicio_perda);
+    verificar("depois do buraco", recebidos[REGISTRO_ANEL].args[0] == 99);
+    registrar(REG_REACAO, 100, 0);
+    n_recebidos = 0;
+    registroDrenar();
+    verificar("perda avisada uma vez", n_recebidos == 1 && recebidos[0].evento == REG_REACAO);
+
+    // Saída cheia: a drenagem não espera nem descarta; o registro (e o aviso de perda) fica para depois
+    registroInit();
+    for (int i = 0; i < REGISTRO_ANEL + 1; ++i)
+        registrar(REG_REACAO, i, 0);
+    saida_cheia = true;
+    n_recebidos = 0;
+    verificar("saida cheia segura", !registroDrenar() && !registroDrenar() && n_recebidos == 0);
+    saida_cheia = false;
+    while (registroDrenar())
+        ;
+    verificar("nada perdido na espera", n_recebidos == REGISTRO_ANEL + 1 && recebidos[0].args[0] == 0 &&
+                                        recebidos[REGISTRO_ANEL].evento == REG_PERDIDOS &&
+                                        recebidos[REGISTRO_ANEL].args[0] == 1);
+
+    // Texto de cada conversão
+    verificar("inteiro", texto(REG_NIVEL, 7, 0, "Nível: 7"));
+    verificar("sem sinal", texto(REG_REACAO, -1, 0, "Tempo de reação: 4294967295 us"));
+    verificar("cores", texto(REG_COR, 1, 0, "Cor inserida: Vermelho, Cor correta: Verde"));
+    verificar("centésimos", texto(REG_CARGA, 1234, 5, "Núcleo 0 ocupado: 12.34%, saída ocupada: 0.05%"));
+    verificar("sem argumentos", texto(REG_PAUSADO, 0, 0, "Jogo pausado!"));
+    char desconhecido[48];
+    snprintf(desconhecido, sizeof(desconhecido), "Evento desconhecido %d (1, 2)", REG_NUM_EVENTOS);
+    verificar("evento desconhecido", texto(REG_NUM_EVENTOS, 1, 2, desconhecido));
+    registro_t r = { 0, REG_DIRECAO_INCORRETA, { 1, 2 } };
+    char curto[8];
+    verificar("texto truncado", registroFormatar(&r, curto, sizeof(curto)) == 7 && strcmp(curto, "Direcao") == 0);
+
+    if (falhas) {
+        printf("%d falha(s)\n", falhas);
+        return 1;
+    }
+    printf("OK: registro\n");
+    return 0;
+}
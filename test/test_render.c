@@ -0,0 +1,76 @@
+#include <stdio.h>
+#include <string.h>
+#include "render.h"
+
+static int falhas = 0; // Número de verificações que falharam
+
+static void verificar(const char *nome, bool condicao) {
+    if (!condicao) {
+        printf("FALHA: %s\n", nome);
+        falhas++;
+    }
+}
+
+int main() {
+    const npLED_t azul = { .G = 0, .R = 0, .B = 32 };
+
+    // Gama: extremos exatos e crescente
+    bool crescente = true;
+    for (int i = 1; i < 256; ++i)
+        crescente = crescente && renderGama[i] >= renderGama[i - 1];
+    verificar("gama", renderGama[0] == 0 && renderGama[255] == RENDER_Q8 && crescente && renderGama[128] < 64);
+
+    // Brilho: o máximo preserva a cor, a metade perceptual corta a luz em mais da metade
+    renderInit(255);
+    verificar("intensidade máxima", renderAtenuar(azul, 255).B == 32 && renderAtenuar(azul, 0).B == 0);
+    verificar("meia intensidade", renderAtenuar(azul, 128).B == 7);
+    renderBrilho(128);
+    verificar("brilho global", renderEscala(255) == renderGama[128] && renderAtenuar(azul, 255).B == 7);
+    renderBrilho(255);
+
+    // Animação: começa em 'de', termina exatamente em 'para' e não passa do valor exato
+    static const animacao_t barra = ANIMACAO(0, LED_COUNT * RENDER_Q8, 5000000);
+    bool monotona = true, precisa = true;
+    int32_t anterior = -1;
+    for (uint64_t t = 0; t <= 5200000; t += 1000) {
+        int32_t v = animacaoValor(&barra, t);
+        monotona = monotona && v >= anterior;
+        anterior = v;
+        int64_t exato = t >= 5000000 ? LED_COUNT * RENDER_Q8 : (int64_t)(LED_COUNT * RENDER_Q8) * t / 5000000;
+        precisa = precisa && exato - v >= -4 && exato - v <= 4; // Erro de arredondamento abaixo de 2% de um LED
+    }
+    verificar("animação monótona", monotona && animacaoValor(&barra, 0) == 0);
+    verificar("animação precisa", precisa && animacaoValor(&barra, 6000000) == LED_COUNT * RENDER_Q8);
+    static const animacao_t descida = ANIMACAO(255, 0, 100000);
+    verificar("animação decrescente", animacaoValor(&descida, 0) == 255 && animacaoValor(&descida, 50000) > 120 &&
+                                      animacaoValor(&descida, 50000) < 135 && animacaoValor(&descida, 100000) == 0);
+
+    // Barra: LEDs inteiros acesos, o da ponta proporcional, o resto apagado
+    renderBarra(3 * RENDER_Q8 + 128, azul);
+    verificar("barra cheia até a ponta", leds[0].B == 32 && leds[2].B == 32);
+    verificar("ponta proporcional", leds[3].B == renderAtenuar(azul, 128).B && leds[3].B > 0 && leds[3].B < 32);
+    verificar("resto apagado", leds[4].B == 0 && leds[LED_COUNT - 1].B == 0);
+    renderBarra(LED_COUNT * RENDER_Q8, azul);
+    verificar("barra completa", leds[LED_COUNT - 1].B == 32);
+    renderBarra(-5, azul);
+    verificar("barra vazia", leds[0].B == 0);
+
+    // Sprite esmaecido: só os bits da máscara acendem, todos com a mesma cor atenuada
+    renderSprite(0x5, azul, 200);
+    uint8_t b = renderAtenuar(azul, 200).B;
+    verificar("sprite", leds[0].B == b && leds[1].B == 0 && leds[2].B == b && leds[3].B == 0);
+
+    // Contadores de custo
+    renderInit(255);
+    renderMedir(100);
+    renderMedir(300);
+    renderEstatisticas_t e = renderEstatisticas();
+    verificar("custo medido", e.quadros == 2 && e.ciclos == 400 && e.pior == 300);
+
+    if (falhas) {
+        printf("%d falha(s)\n", falhas);
+        return 1;
+    }
+    printf("OK: render\n");
+    return 0;
+}
@@ -0,0 +1,131 @@
+#include <stdio.h>
+#include <string.h>
+#include "hal_host.h"
+#include "pinos.h"
+#include "saida.h"
+
+static int falhas = 0; // Número de verificações que falharam
+
+static void verificar(const char *nome, bool condicao) {
+    if (!condicao) {
+        printf("FALHA: %s\n", nome);
+        falhas++;
+    }
+}
+
+// Mudanças de tom nos buzzers, com o instante
+static struct {
+    uint pino;
+    uint32_t freq_hz;
+    uint64_t tempo_us;
+} escritas[32];
+static int n_escritas;
+
+static void observarPwm(uint pino, uint32_t freq_hz, uint8_t volume) {
+    if (n_escritas < 32)
+        escritas[n_escritas++] = (typeof(escritas[0])){ pino, freq_hz, halTempoUs() };
+}
+
+static int acordados;
+static void acordar(void) {
+    acordados++;
+}
+
+// Quadro com um único LED aceso
+static void quadroCom(npLED_t *quadro, int indice, uint8_t r) {
+    memset(quadro, 0, sizeof(npLED_t) * LED_COUNT);
+    quadro[indice].R = r;
+}
+
+int main() {
+    hostObservadores_t observadores = { NULL, NULL, observarPwm };
+    npLED_t quadro[LED_COUNT];
+    static const uint pinos_leds[] = LED_PINOS;
+
+    // Núcleo 1: o quadro publicado chega aos LEDs sem o núcleo 0 esperar o fio
+    hostReiniciar(&observadores);
+    saidaInitNucleo1(pinos_leds, BUZZER_ACERTO, BUZZER_ERRO);
+    quadroCom(quadro, 3, 32);
+    verificar("publicado", saidaQuadro(quadro));
+    halEsperaUs(10);
+    verificar("quadro no fio", hostQuadro()[3].R == 32 && saidaEstatisticas().quadros == 1);
+
+    // Fila cheia: o excedente é descartado e só o quadro mais novo vai para o fio
+    for (int i = 0; i < SAIDA_FILA + 3; ++i) {
+        quadroCom(quadro, i % LED_COUNT, 10);
+        saidaQuadro(quadro);
+    }
+    halEsperaMs(5);
+    saidaEstatisticas_t e = saidaEstatisticas();
+    verificar("descartados contados", e.descartados == 3);
+    verificar("só o mais novo enviado", e.quadros == 2 && e.substituidos == SAIDA_FILA - 1 &&
+                                        hostQuadro()[SAIDA_FILA - 1].R == 10);
+
+    // Som: cada nota no instante certo, contado do início do som, sem o núcleo 0 esperar
+    static const somNota_t eco[] = {
+        {1000, 100, 200, 200, SOM_BUZZER_A}, {0, 50, 0, 0, 0}, {2000, 150, 200, 200, SOM_BUZZER_B}, {0}
+    };
+    n_escritas = 0;
+    uint64_t inicio = halTempoUs();
+    verificar("duração do som", saidaSom(eco) == 300);
+    verificar("publicar não espera", halTempoUs() == inicio);
+    halEsperaMs(400);
+    static const struct { uint pino; uint32_t freq_hz; uint32_t tempo_ms; } esperadas[] = {
+        {BUZZER_ACERTO, 1000, 0}, {BUZZER_ACERTO, 0, 100}, {BUZZER_ERRO, 2000, 150}, {BUZZER_ERRO, 0, 300}
+    };
+    bool pontual = n_escritas == 4;
+    for (int i = 0; pontual && i < 4; ++i)
+        pontual = escritas[i].pino == esperadas[i].pino && escritas[i].freq_hz == esperadas[i].freq_hz &&
+                  escritas[i].tempo_us - inicio == esperadas[i].tempo_ms * 1000;
+    verificar("notas pontuais", pontual);
+
+    // Um núcleo: publicar avisa o consumidor, que pede nova chance enquanto o fio está ocupado
+    hostReiniciar(NULL);
+    acordados = 0;
+    saidaInit(pinos_leds, BUZZER_ACERTO, BUZZER_ERRO, acordar);
+    verificar("ocioso sem comandos", saidaPasso() == HAL_SEM_LIMITE);
+    quadroCom(quadro, 0, 1);
+    saidaQuadro(quadro);
+    verificar("consumidor acordado", acordados == 1);
+    saidaPasso();
+    quadroCom(quadro, 0, 2);
+    saidaQuadro(quadro);
+    verificar("fio ocupado: tenta de novo", saidaPasso() == halTempoUs() + SAIDA_ESPERA_FIO_US);
+
+    // Quadros do USB: gravados direto no slot, escondem as camadas até a matriz ser devolvida
+    halEsperaMs(2);
+    saidaPasso(); // O quadro que esperava o fio
+    halEsperaMs(2);
+    npLED_t *slot = saidaRemotoReservar();
+    verificar("reserva estável", slot && saidaRemotoReservar() == slot);
+    quadroCom(slot, 4, 50);
+    verificar("remoto publicado", saidaRemotoPublicar(true));
+    saidaPasso();
+    halEsperaMs(2);
+    verificar("remoto no fio", hostQuadro()[4].R == 50 && saidaRemotoAtivo() && saidaEstatisticas().remotos == 1);
+    quadroCom(quadro, 0, 7);
+    saidaQuadro(quadro);
+    saidaPasso();
+    halEsperaMs(2);
+    verificar("camadas escondidas", hostQuadro()[4].R == 50 && hostQuadro()[0].R == 0);
+    for (int i = 0; i < 2; ++i) {
+        quadroCom(saidaRemotoReservar(), 10 + i, 60);
+        saidaRemotoPublicar(true);
+    }
+    saidaPasso();
+    halEsperaMs(2);
+    e = saidaEstatisticas();
+    verificar("só o remoto mais novo", hostQuadro()[11].R == 60 && e.remotos == 2 && e.remotos_perdidos == 1);
+    saidaRemotoReservar();
+    saidaRemotoPublicar(false);
+    saidaPasso();
+    halEsperaMs(2);
+    verificar("matriz devolvida", !saidaRemotoAtivo() && hostQuadro()[0].R == 7 && hostQuadro()[11].R == 0);
+
+    if (falhas) {
+        printf("%d falha(s)\n", falhas);
+        return 1;
+    }
+    printf("OK: saida\n");
+    return 0;
+}
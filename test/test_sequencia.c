@@ -0,0 +1,60 @@
+#include <stdio.h>
+#include "sequencia.h"
+
+static int falhas = 0; // Número de verificações que falharam
+
+static void verificar(const char *nome, bool condicao) {
+    if (!condicao) {
+        printf("FALHA: %s\n", nome);
+        falhas++;
+    }
+}
+
+// Passo 'i' de uma sequência de referência que usa as quatro direções e as duas cores
+static Direcao direcaoEsperada(uint32_t i) {
+    return (Direcao)((i * 7 + i / 5) % 4);
+}
+
+static bool corEsperada(uint32_t i) {
+    return (i * 13 + 1) % 3 == 0;
+}
+
+int main() {
+    static sequencia_t s;
+
+    verificar("4 bits por passo", sizeof(s.passos) == SEQUENCIA_MAX_PASSOS / 2);
+
+    sequenciaLimpar(&s);
+    verificar("vazia", sequenciaTamanho(&s) == 0);
+    bool aceitos = true;
+    for (uint32_t i = 0; i < SEQUENCIA_MAX_PASSOS; ++i)
+        aceitos = aceitos && sequenciaAcrescentar(&s, direcaoEsperada(i), corEsperada(i));
+    verificar("capacidade", aceitos && sequenciaTamanho(&s) == SEQUENCIA_MAX_PASSOS);
+    verificar("cheia", !sequenciaAcrescentar(&s, CIMA, true) && sequenciaTamanho(&s) == SEQUENCIA_MAX_PASSOS);
+
+    bool iguais = true;
+    for (uint32_t i = 0; i < SEQUENCIA_MAX_PASSOS; ++i)
+        iguais = iguais && sequenciaDirecao(&s, i) == direcaoEsperada(i) && sequenciaCor(&s, i) == corEsperada(i);
+    verificar("passos preservados", iguais);
+    verificar("bit reservado zerado", (sequenciaPasso(&s, 0) & 0x8) == 0 && (sequenciaPasso(&s, 1) & 0x8) == 0);
+
+    // Conferência: a direção errada tem prioridade sobre a cor
+    Direcao outra = (Direcao)((direcaoEsperada(5) + 1) % 4);
+    verificar("conferir certo", sequenciaConferir(&s, 5, direcaoEsperada(5), corEsperada(5)) == SEQUENCIA_CERTO);
+    verificar("conferir cor", sequenciaConferir(&s, 5, direcaoEsperada(5), !corEsperada(5)) == SEQUENCIA_COR_ERRADA);
+    verificar("conferir direcao", sequenciaConferir(&s, 5, outra, !corEsperada(5)) == SEQUENCIA_DIRECAO_ERRADA);
+
+    // Acrescentar depois de limpar não herda o nibble alto antigo
+    sequenciaLimpar(&s);
+    sequenciaAcrescentar(&s, ESQUERDA, false);
+    verificar("nibble alto limpo", s.passos[0] == ESQUERDA);
+    sequenciaAcrescentar(&s, DIREITA, true);
+    verificar("dois passos por byte", s.passos[0] == (ESQUERDA | ((DIREITA | SEQUENCIA_BIT_COR) << 4)));
+
+    if (falhas) {
+        printf("%d falha(s)\n", falhas);
+        return 1;
+    }
+    printf("OK: sequencia\n");
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include <stdio.h>
+#include <string.h>
+#include "hal_host.h"
+#include "som.h"
+
+#define PINO_A 10
+#define PINO_B 21
+
+static int falhas = 0; // Número de verificações que falharam
+
+static void verificar(const char *nome, bool condicao) {
+    if (!condicao) {
+        printf("FALHA: %s\n", nome);
+        falhas++;
+    }
+}
+
+// Tons aplicados ao PWM; o instante vem de 'agora', já que os testes chamam somPasso direto
+static struct {
+    uint pino;
+    uint32_t freq_hz;
+    uint8_t volume;
+    uint64_t tempo_us;
+} tons[64];
+static int n_tons;
+static uint64_t agora;
+
+static void observarPwm(uint pino, uint32_t freq_hz, uint8_t volume) {
+    if (n_tons < 64)
+        tons[n_tons++] = (typeof(tons[0])){ pino, freq_hz, volume, agora };
+}
+
+// Roda o sequenciador como o consumidor das saídas: só nos prazos que ele devolve
+static void rodarAte(uint64_t fim) {
+    uint64_t proximo = somPasso(agora);
+    while (proximo <= fim) {
+        agora = proximo;
+        proximo = somPasso(agora);
+    }
+    agora = fim;
+}
+
+static void reiniciar(void) {
+    static const hostObservadores_t observadores = { NULL, NULL, observarPwm };
+    hostReiniciar(&observadores);
+    somInit(PINO_A, PINO_B);
+    n_tons = 0;
+    agora = 0;
+}
+
+int main() {
+    static const somNota_t dois[] = {
+        {440, 100, 100, 100, SOM_BUZZER_A}, {880, 50, 100, 100, SOM_BUZZER_A | SOM_BUZZER_B}, {0}
+    };
+    static const somNota_t pausa[] = { {0, 30, 0, 0, 0}, {660, 20, 50, 50, SOM_BUZZER_B}, {0} };
+
+    // Parado: sem prazo e sem mexer no PWM
+    reiniciar();
+    verificar("ocioso", somPasso(0) == HAL_SEM_LIMITE && n_tons == 0 && !somTocando());
+    verificar("duração", somDuracao(dois) == 150 && somDuracao(pausa) == 50);
+
+    // Notas nos instantes certos e o próximo som emendado no fim do anterior
+    agora = 1000;
+    verificar("enfileirado", somTocar(dois) && somTocar(pausa) && somTocando());
+    rodarAte(1000000);
+    static const struct { uint pino; uint32_t freq_hz; uint64_t tempo_us; } esperados[] = {
+        {PINO_A, 440, 1000}, {PINO_A, 880, 101000}, {PINO_B, 880, 101000},   // Primeiro som
+        {PINO_A, 0, 151000}, {PINO_B, 0, 151000},                            // Pausa do segundo
+        {PINO_B, 660, 181000}, {PINO_B, 0, 201000},                          // Nota final e silêncio
+    };
+    bool pontual = n_tons == 7;
+    for (int i = 0; pontual && i < 7; ++i)
+        pontual = tons[i].pino == esperados[i].pino && tons[i].freq_hz == esperados[i].freq_hz &&
+                  tons[i].tempo_us == esperados[i].tempo_us;
+    verificar("sequência pontual", pontual);
+    verificar("parado no fim", !somTocando() && somEstatisticas().tocados == 2 && somEstatisticas().atraso_max_us == 0);
+
+    // Envelope: o volume cai em degraus de SOM_ENVELOPE_US até o volume final
+    static const somNota_t queda[] = { {1000, 100, 200, 0, SOM_BUZZER_A}, {0} };
+    reiniciar();
+    somTocar(queda);
+    rodarAte(200000);
+    bool descendo = n_tons == 11 && tons[0].volume == 200 && tons[10].freq_hz == 0;
+    for (int i = 1; descendo && i < 10; ++i)
+        descendo = tons[i].volume == 200 - 20 * i && tons[i].tempo_us == (uint64_t)i * SOM_ENVELOPE_US;
+    verificar("envelope linear", descendo);
+
+    // Consumidor atrasado: as notas seguintes não herdam o atraso
+    reiniciar();
+    somTocar(dois);
+    somPasso(0);
+    agora = 130000; // 30ms depois do início da segunda nota
+    verificar("prazo do fim", somPasso(agora) == 150000);
+    verificar("atraso medido", somEstatisticas().atraso_max_us == 30000);
+
+    // Fila cheia: o excedente é descartado e contado
+    reiniciar();
+    for (int i = 0; i < SOM_FILA + 2; ++i)
+        somTocar(pausa);
+    verificar("descartados", somEstatisticas().descartados == 2);
+
+    if (falhas) {
+        printf("%d falha(s)\n", falhas);
+        return 1;
+    }
+    printf("OK: som\n");
+    return 0;
+}
@@ -0,0 +1,96 @@
+#include <stdio.h>
+#include <string.h>
+#include "neopixel.h"
+#include "sprites.h"
+
+typedef struct { int x, y; } ponto_t;
+
+static int falhas = 0; // Número de verificações que falharam
+
+// Máscara a partir de uma lista de pixels, como o código antigo desenhava
+static uint32_t mascaraDosPontos(const ponto_t *pontos, int n) {
+    uint32_t mascara = 0;
+    for (int i = 0; i < n; ++i)
+        mascara |= 1u << getIndex(pontos[i].x, pontos[i].y);
+    return mascara;
+}
+
+static void verificar(const char *nome, uint32_t obtido, uint32_t esperado) {
+    if (obtido != esperado) {
+        printf("FALHA: %s (0x%07x, esperado 0x%07x)\n", nome, (unsigned)obtido, (unsigned)esperado);
+        falhas++;
+    }
+}
+
+int main() {
+    // O índice em tempo de compilação segue getIndex
+    for (int y = 0; y < 5; ++y)
+        for (int x = 0; x < 5; ++x)
+            verificar("SPRITE_INDICE", SPRITE_INDICE(x, y), getIndex(x, y));
+
+    // Setas: mesmos pixels das antigas chamadas a npSetLED
+    static const ponto_t cima[] = { {2, 0}, {1, 1}, {3, 1}, {2, 1}, {2, 2}, {2, 3}, {2, 4} };
+    static const ponto_t baixo[] = { {2, 4}, {1, 3}, {3, 3}, {2, 3}, {2, 2}, {2, 1}, {2, 0} };
+    static const ponto_t esquerda[] = { {0, 2}, {1, 1}, {1, 3}, {1, 2}, {2, 2}, {3, 2}, {4, 2} };
+    static const ponto_t direita[] = { {4, 2}, {3, 1}, {3, 3}, {3, 2}, {2, 2}, {1, 2}, {0, 2} };
+    verificar("seta CIMA", spritesSetas[0], mascaraDosPontos(cima, 7));
+    verificar("seta BAIXO", spritesSetas[1], mascaraDosPontos(baixo, 7));
+    verificar("seta ESQUERDA", spritesSetas[2], mascaraDosPontos(esquerda, 7));
+    verificar("seta DIREITA", spritesSetas[3], mascaraDosPontos(direita, 7));
+
+    // Algarismos que não foram corrigidos continuam iguais
+    static const ponto_t zero[] = { {1, 0}, {2, 0}, {3, 0}, {0, 1}, {4, 1}, {0, 2}, {4, 2}, {0, 3}, {4, 3}, {1, 4}, {2, 4}, {3, 4} };
+    static const ponto_t um[] = { {2, 0}, {1, 1}, {2, 1}, {2, 2}, {2, 3}, {2, 4} };
+    static const ponto_t sete[] = { {0, 0}, {1, 0}, {2, 0}, {3, 0}, {4, 0}, {4, 1}, {3, 2}, {2, 3}, {1, 4} };
+    verificar("digito 0", spritesDigitos[0], mascaraDosPontos(zero, 12));
+    verificar("digito 1", spritesDigitos[1], mascaraDosPontos(um, 6));
+    verificar("digito 7", spritesDigitos[7], mascaraDosPontos(sete, 9));
+
+    // O 2 antigo repetia (1, 4): a máscara tem cada pixel uma única vez
+    static const ponto_t dois[] = { {1, 0}, {2, 0}, {3, 0}, {4, 1}, {3, 2}, {2, 3}, {1, 4}, {0, 4}, {1, 4}, {2, 4}, {3, 4} };
+    verificar("digito 2", spritesDigitos[2], mascaraDosPontos(dois, 11));
+
+    static const ponto_t quatro[] = { {0, 0}, {4, 0}, {0, 1}, {4, 1}, {0, 2}, {1, 2}, {2, 2}, {3, 2}, {4, 2}, {4, 3}, {4, 4} };
+    static const ponto_t oito[] = { {1, 0}, {2, 0}, {3, 0}, {0, 1}, {4, 1}, {0, 2}, {1, 2}, {2, 2}, {3, 2}, {4, 2},
+                                    {0, 3}, {4, 3}, {1, 4}, {2, 4}, {3, 4} };
+    static const ponto_t nove[] = { {1, 0}, {2, 0}, {3, 0}, {0, 1}, {4, 1}, {0, 2}, {1, 2}, {2, 2}, {3, 2}, {4, 2},
+                                    {4, 3}, {1, 4}, {2, 4}, {3, 4} };
+    verificar("digito 4", spritesDigitos[4], mascaraDosPontos(quatro, 11));
+    verificar("digito 8", spritesDigitos[8], mascaraDosPontos(oito, 15));
+    verificar("digito 9", spritesDigitos[9], mascaraDosPontos(nove, 14));
+
+    // Corrigidos de propósito (os pixels fora do lugar das listas antigas): a máscara esperada é
+    // a do desenho novo. O verificado ganha (4, 2), que deixa a haste longa contínua
+    static const ponto_t tres[] = { {1, 0}, {2, 0}, {3, 0}, {4, 1}, {2, 2}, {3, 2}, {4, 3}, {1, 4}, {2, 4}, {3, 4} };
+    static const ponto_t cinco[] = { {0, 0}, {1, 0}, {2, 0}, {3, 0}, {0, 1}, {0, 2}, {1, 2}, {2, 2}, {3, 2}, {4, 3},
+                                     {0, 4}, {1, 4}, {2, 4}, {3, 4} };
+    static const ponto_t seis[] = { {1, 0}, {2, 0}, {3, 0}, {0, 1}, {0, 2}, {1, 2}, {2, 2}, {3, 2}, {0, 3}, {4, 3},
+                                    {1, 4}, {2, 4}, {3, 4} };
+    static const ponto_t verificado[] = { {4, 1}, {0, 2}, {4, 2}, {1, 3}, {3, 3}, {2, 4} };
+    verificar("digito 3", spritesDigitos[3], mascaraDosPontos(tres, 10));
+    verificar("digito 5", spritesDigitos[5], mascaraDosPontos(cinco, 14));
+    verificar("digito 6", spritesDigitos[6], mascaraDosPontos(seis, 13));
+    verificar("verificado", spriteCheckmark, mascaraDosPontos(verificado, 6));
+
+    // Nenhum sprite usa bits além dos 25 LEDs
+    for (int i = 0; i < 10; ++i)
+        verificar("digito dentro da matriz", spritesDigitos[i] >> LED_COUNT, 0);
+
+    // O blit acende os bits da máscara e apaga o resto
+    memset(leds, 0xAA, sizeof(leds));
+    spriteDesenhar(spritesSetas[0], 1, 2, 3);
+    for (int i = 0; i < LED_COUNT; ++i) {
+        bool deve = (spritesSetas[0] >> i) & 1u;
+        if (leds[i].R != (deve ? 1 : 0) || leds[i].G != (deve ? 2 : 0) || leds[i].B != (deve ? 3 : 0)) {
+            printf("FALHA: spriteDesenhar no LED %d\n", i);
+            falhas++;
+        }
+    }
+
+    if (falhas) {
+        printf("%d falha(s)\n", falhas);
+        return 1;
+    }
+    printf("OK: sprites\n");
+    return 0;
+}
@@ -0,0 +1,93 @@
+#include <stdio.h>
+#include <string.h>
+#include "sprites.h"
+#include "texto.h"
+
+static int falhas = 0; // Número de verificações que falharam
+
+static void verificar(const char *nome, bool condicao) {
+    if (!condicao) {
+        printf("FALHA: %s\n", nome);
+        falhas++;
+    }
+}
+
+// Modelo lógico: 5 colunas de 5 bits que andam para a esquerda, com o pixel (x, y) em getIndex
+static uint8_t colunas[5];
+
+static uint32_t mascaraDoModelo(void) {
+    uint32_t mascara = 0;
+    for (int x = 0; x < 5; ++x)
+        for (int y = 0; y < 5; ++y)
+            if ((colunas[x] >> y) & 1u)
+                mascara |= 1u << getIndex(x, y);
+    return mascara;
+}
+
+// Coluna 'k' do texto: 3 do glifo e uma vazia por caractere; depois do texto, vazias
+static uint8_t colunaDoTexto(const char *texto, uint32_t k) {
+    uint32_t c = k / 4;
+    if (c >= strlen(texto) || k % 4 == 3)
+        return 0;
+    return (uint8_t)((textoGlifo(texto[c]) >> (5 * (k % 4))) & 0x1Fu);
+}
+
+static void passoDoModelo(uint8_t nova) {
+    memmove(colunas, colunas + 1, 4);
+    colunas[4] = nova;
+}
+
+int main() {
+    // Fonte por colunas: o '1' tem o bico e a base na coluna 0, a haste na 1 e só a base na 2
+    verificar("glifo 1", textoGlifo('1') == (0x12u | (0x1Fu << 5) | (0x10u << 10)));
+    verificar("minusculas", textoGlifo('r') == textoGlifo('R') && textoGlifo('R') != 0);
+    verificar("sem desenho fica vazio", textoGlifo('~') == 0 && textoGlifo('@') == 0 && textoGlifo(' ') == 0);
+    for (char c = '0'; c <= '9'; ++c)
+        verificar("algarismos com pixels e 3 colunas", textoGlifo(c) != 0 && (textoGlifo(c) >> 15) == 0);
+    verificar("colunas de uma passada", textoColunas("1") == 8 && textoColunas("12 R9") == 24 && textoColunas("") == 0);
+    verificar("texto cortado", textoColunas("12345678901234567890") == TEXTO_MAX * 4 - 1 + 5);
+
+    // Sequência de quadros: cada passo igual ao modelo, duas passadas seguidas do placar
+    static const char placar[] = "12 R9";
+    texto_t t;
+    textoIniciar(&t, placar, 1000, true, 0);
+    memset(colunas, 0, sizeof(colunas));
+    bool iguais = true;
+    for (uint32_t k = 0; k < 2 * textoColunas(placar); ++k) {
+        textoAtualizar(&t, k * 1000);
+        passoDoModelo(colunaDoTexto(placar, k % textoColunas(placar)));
+        iguais = iguais && textoMascara(&t) == mascaraDoModelo();
+    }
+    verificar("quadros iguais ao modelo", iguais);
+    verificar("matriz vazia no fim da passada", textoMascara(&t) == 0);
+
+    // Ritmo: nenhum passo antes da hora, um passo na hora e os vencidos de uma vez quando atrasa
+    textoIniciar(&t, "1", 80000, false, 1000);
+    verificar("antes do primeiro passo", !textoAtualizar(&t, 999) && textoMascara(&t) == 0 && textoProximo(&t) == 1000);
+    uint32_t bico_e_base = (1u << getIndex(4, 1)) | (1u << getIndex(4, 4)); // Coluna 0 do '1' na direita
+    verificar("primeiro passo", textoAtualizar(&t, 1000) && textoMascara(&t) == bico_e_base && textoProximo(&t) == 81000);
+    verificar("entre dois passos", !textoAtualizar(&t, 80999));
+    memset(colunas, 0, sizeof(colunas));
+    for (uint32_t k = 0; k < 4; ++k)
+        passoDoModelo(colunaDoTexto("1", k));
+    verificar("passos atrasados", textoAtualizar(&t, 81000 + 2 * 80000) && textoMascara(&t) == mascaraDoModelo() &&
+                                  textoProximo(&t) == 1000 + 4 * 80000);
+    textoAtualizar(&t, 10000000);
+    verificar("sem repetir, termina vazio", textoMascara(&t) == 0 && textoProximo(&t) == TEXTO_SEM_QUADRO);
+    verificar("terminado fica parado", !textoAtualizar(&t, 20000000));
+
+    // Muito atrasado, repetindo: no máximo uma passada por chamada, e o ritmo recomeça de agora
+    textoIniciar(&t, placar, 1000, true, 0);
+    textoAtualizar(&t, 1000000);
+    verificar("atraso longo", textoProximo(&t) == 1000000 + 1000);
+
+    textoIniciar(&t, "", 1000, true, 0);
+    verificar("texto vazio", !textoAtualizar(&t, 5000) && textoProximo(&t) == TEXTO_SEM_QUADRO);
+
+    if (falhas) {
+        printf("%d falha(s)\n", falhas);
+        return 1;
+    }
+    printf("OK: texto\n");
+    return 0;
+}
@@ -0,0 +1,125 @@
+#include <string.h>
+#include "texto.h"
+
+#define TEXTO_ENTRADA 5 // Colunas vazias que levam o fim do texto para fora da matriz
+
+// Pixels das colunas 1 a 4 das linhas pares (andam um bit para cima) e das ímpares (para baixo)
+#define LINHAS_PARES SPRITE(0b01111, 0b00000, 0b01111, 0b00000, 0b01111)
+#define LINHAS_IMPARES SPRITE(0b00000, 0b01111, 0b00000, 0b01111, 0b00000)
+
+// Máscaras físicas das 32 colunas possíveis na direita da matriz (x = 4)
+#define DIREITA4(b) TEXTO_COLUNA(4, b), TEXTO_COLUNA(4, (b) + 1), TEXTO_COLUNA(4, (b) + 2), TEXTO_COLUNA(4, (b) + 3)
+static const uint32_t direita[32] = {
+    DIREITA4(0), DIREITA4(4), DIREITA4(8), DIREITA4(12), DIREITA4(16), DIREITA4(20), DIREITA4(24), DIREITA4(28),
+};
+
+// Fonte 3x5 do espaço ao '_' (ASCII 32 a 95); os caracteres sem desenho ficam vazios
+static const uint16_t fonte[64] = {
+    ['!' - ' '] = TEXTO_GLIFO(0b010, 0b010, 0b010, 0b000, 0b010),
+    ['%' - ' '] = TEXTO_GLIFO(0b101, 0b001, 0b010, 0b100, 0b101),
+    ['-' - ' '] = TEXTO_GLIFO(0b000, 0b000, 0b111, 0b000, 0b000),
+    ['.' - ' '] = TEXTO_GLIFO(0b000, 0b000, 0b000, 0b000, 0b010),
+    ['/' - ' '] = TEXTO_GLIFO(0b001, 0b001, 0b010, 0b100, 0b100),
+    ['0' - ' '] = TEXTO_GLIFO(0b111, 0b101, 0b101, 0b101, 0b111),
+    ['1' - ' '] = TEXTO_GLIFO(0b010, 0b110, 0b010, 0b010, 0b111),
+    ['2' - ' '] = TEXTO_GLIFO(0b111, 0b001, 0b111, 0b100, 0b111),
+    ['3' - ' '] = TEXTO_GLIFO(0b111, 0b001, 0b011, 0b001, 0b111),
+    ['4' - ' '] = TEXTO_GLIFO(0b101, 0b101, 0b111, 0b001, 0b001),
+    ['5' - ' '] = TEXTO_GLIFO(0b111, 0b100, 0b111, 0b001, 0b111),
+    ['6' - ' '] = TEXTO_GLIFO(0b111, 0b100, 0b111, 0b101, 0b111),
+    ['7' - ' '] = TEXTO_GLIFO(0b111, 0b001, 0b010, 0b010, 0b010),
+    ['8' - ' '] = TEXTO_GLIFO(0b111, 0b101, 0b111, 0b101, 0b111),
+    ['9' - ' '] = TEXTO_GLIFO(0b111, 0b101, 0b111, 0b001, 0b111),
+    [':' - ' '] = TEXTO_GLIFO(0b000, 0b010, 0b000, 0b010, 0b000),
+    ['?' - ' '] = TEXTO_GLIFO(0b110, 0b001, 0b010, 0b000, 0b010),
+    ['A' - ' '] = TEXTO_GLIFO(0b010, 0b101, 0b111, 0b101, 0b101),
+    ['B' - ' '] = TEXTO_GLIFO(0b110, 0b101, 0b110, 0b101, 0b110),
+    ['C' - ' '] = TEXTO_GLIFO(0b011, 0b100, 0b100, 0b100, 0b011),
+    ['D' - ' '] = TEXTO_GLIFO(0b110, 0b101, 0b101, 0b101, 0b110),
+    ['E' - ' '] = TEXTO_GLIFO(0b111, 0b100, 0b110, 0b100, 0b111),
+    ['F' - ' '] = TEXTO_GLIFO(0b111, 0b100, 0b110, 0b100, 0b100),
+    ['G' - ' '] = TEXTO_GLIFO(0b011, 0b100, 0b101, 0b101, 0b011),
+    ['H' - ' '] = TEXTO_GLIFO(0b101, 0b101, 0b111, 0b101, 0b101),
+    ['I' - ' '] = TEXTO_GLIFO(0b111, 0b010, 0b010, 0b010, 0b111),
+    ['J' - ' '] = TEXTO_GLIFO(0b001, 0b001, 0b001, 0b101, 0b010),
+    ['K' - ' '] = TEXTO_GLIFO(0b101, 0b101, 0b110, 0b101, 0b101),
+    ['L' - ' '] = TEXTO_GLIFO(0b100, 0b100, 0b100, 0b100, 0b111),
+    ['M' - ' '] = TEXTO_GLIFO(0b101, 0b111, 0b111, 0b101, 0b101),
+    ['N' - ' '] = TEXTO_GLIFO(0b110, 0b101, 0b101, 0b101, 0b101),
+    ['O' - ' '] = TEXTO_GLIFO(0b010, 0b101, 0b101, 0b101, 0b010),
+    ['P' - ' '] = TEXTO_GLIFO(0b110, 0b101, 0b110, 0b100, 0b100),
+    ['Q' - ' '] = TEXTO_GLIFO(0b010, 0b101, 0b101, 0b110, 0b011),
+    ['R' - ' '] = TEXTO_GLIFO(0b110, 0b101, 0b110, 0b101, 0b101),
+    ['S' - ' '] = TEXTO_GLIFO(0b011, 0b100, 0b010, 0b001, 0b110),
+    ['T' - ' '] = TEXTO_GLIFO(0b111, 0b010, 0b010, 0b010, 0b010),
+    ['U' - ' '] = TEXTO_GLIFO(0b101, 0b101, 0b101, 0b101, 0b111),
+    ['V' - ' '] = TEXTO_GLIFO(0b101, 0b101, 0b101, 0b101, 0b010),
+    ['W' - ' '] = TEXTO_GLIFO(0b101, 0b101, 0b111, 0b111, 0b101),
+    ['X' - ' '] = TEXTO_GLIFO(0b101, 0b101, 0b010, 0b101, 0b101),
+    ['Y' - ' '] = TEXTO_GLIFO(0b101, 0b101, 0b010, 0b010, 0b010),
+    ['Z' - ' '] = TEXTO_GLIFO(0b111, 0b001, 0b010, 0b100, 0b111),
+    ['_' - ' '] = TEXTO_GLIFO(0b000, 0b000, 0b000, 0b000, 0b111),
+};
+
+uint16_t textoGlifo(char c) {
+    if (c >= 'a' && c <= 'z')
+        c = (char)(c - 'a' + 'A');
+    return (c >= ' ' && c <= '_') ? fonte[c - ' '] : 0;
+}
+
+// Passos de uma passada com 'n' caracteres: a coluna vazia depois do último fica de fora
+static uint16_t colunasDe(uint32_t n) {
+    return n ? (uint16_t)(n * TEXTO_LARGURA - 1 + TEXTO_ENTRADA) : 0;
+}
+
+uint32_t textoColunas(const char *texto) {
+    size_t n = strlen(texto);
+    return colunasDe(n < TEXTO_MAX ? (uint32_t)n : TEXTO_MAX);
+}
+
+void textoIniciar(texto_t *t, const char *texto, uint32_t passo_us, bool repetir, uint64_t agora) {
+    t->n = 0;
+    for (; t->n < TEXTO_MAX && texto[t->n]; ++t->n) // A fonte é consultada uma vez, aqui
+        t->glifos[t->n] = textoGlifo(texto[t->n]);
+    t->coluna = 0;
+    t->colunas = colunasDe(t->n);
+    t->repetir = repetir;
+    t->passo_us = passo_us;
+    t->proximo_us = t->colunas ? agora : TEXTO_SEM_QUADRO;
+    t->mascara = 0;
+}
+
+// Um passo: a cena anda uma coluna para a esquerda e a coluna 'k' do texto entra pela direita
+static void passo(texto_t *t) {
+    uint32_t k = t->coluna, c = k / TEXTO_LARGURA, parte = k % TEXTO_LARGURA;
+    uint32_t bits = (c < t->n && parte < 3) ? (t->glifos[c] >> (5 * parte)) & 0x1Fu : 0;
+    t->mascara = ((t->mascara & LINHAS_PARES) << 1) | ((t->mascara & LINHAS_IMPARES) >> 1) | direita[bits];
+}
+
+bool textoAtualizar(texto_t *t, uint64_t agora) {
+    uint32_t antes = t->mascara;
+    for (uint32_t passos = 0; agora >= t->proximo_us; ++passos) {
+        if (passos == t->colunas) { // Atrasado mais de uma passada: retoma do ponto atual
+            t->proximo_us = agora + t->passo_us;
+            break;
+        }
+        passo(t);
+        if (++t->coluna < t->colunas) {
+            t->proximo_us += t->passo_us;
+        } else if (t->repetir) { // A matriz já está vazia: o texto volta a entrar
+            t->coluna = 0;
+            t->proximo_us += t->passo_us;
+        } else {
+            t->proximo_us = TEXTO_SEM_QUADRO;
+        }
+    }
+    return t->mascara != antes;
+}
+
+uint32_t textoMascara(const texto_t *t) {
+    return t->mascara;
+}
+
+uint64_t textoProximo(const texto_t *t) {
+    return t->proximo_us;
+}
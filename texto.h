@@ -0,0 +1,56 @@
+#ifndef TEXTO_H
+#define TEXTO_H
+
+// Letreiro: texto que rola da direita para a esquerda na matriz 5x5, para números de mais de um
+// algarismo (níveis do modo sem fim, placar e recorde). A fonte 3x5 é guardada por colunas (5 bits
+// cada, bit 0 = linha de cima), com uma coluna vazia entre os caracteres. A cena é a própria máscara
+// física de 25 bits: a cada passo as linhas pares andam um bit para cima e as ímpares um para baixo
+// (o zigue-zague de getIndex), e a coluna nova entra na direita por uma tabela de 32 máscaras.
+// Nenhum glifo é redesenhado por quadro. O letreiro não espera: quem desenha chama textoAtualizar
+// quando quiser e agenda o próximo quadro para textoProximo.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sprites.h"
+
+#define TEXTO_MAX 16         // Caracteres de um letreiro (o resto é cortado)
+#define TEXTO_LARGURA 4      // Colunas por caractere: 3 do glifo e 1 vazia
+#define TEXTO_SEM_QUADRO UINT64_MAX // textoProximo de um letreiro que já saiu da matriz
+
+// Uma coluna do glifo (0 a 2) a partir de uma linha desenhada como 3 bits (bit 2 = à esquerda)
+#define TEXTO_PONTO(coluna, y, bits) ((((uint32_t)(bits) >> (2 - (coluna))) & 1u) << (5 * (coluna) + (y)))
+#define TEXTO_LINHA(y, bits) (TEXTO_PONTO(0, y, bits) | TEXTO_PONTO(1, y, bits) | TEXTO_PONTO(2, y, bits))
+
+// Glifo 3x5 descrito linha a linha, de cima para baixo; vira 3 colunas de 5 bits em tempo de compilação
+#define TEXTO_GLIFO(l0, l1, l2, l3, l4) \
+    ((uint16_t)(TEXTO_LINHA(0, l0) | TEXTO_LINHA(1, l1) | TEXTO_LINHA(2, l2) | TEXTO_LINHA(3, l3) | TEXTO_LINHA(4, l4)))
+
+// Máscara física de uma coluna x da cena com os 5 bits 'bits' (bit 0 = y 0)
+#define TEXTO_COLUNA(x, bits)                                   \
+    (((((uint32_t)(bits) >> 0) & 1u) << SPRITE_INDICE(x, 0)) | \
+     ((((uint32_t)(bits) >> 1) & 1u) << SPRITE_INDICE(x, 1)) | \
+     ((((uint32_t)(bits) >> 2) & 1u) << SPRITE_INDICE(x, 2)) | \
+     ((((uint32_t)(bits) >> 3) & 1u) << SPRITE_INDICE(x, 3)) | \
+     ((((uint32_t)(bits) >> 4) & 1u) << SPRITE_INDICE(x, 4)))
+
+typedef struct {
+    uint16_t glifos[TEXTO_MAX]; // Colunas de cada caractere, já procuradas na fonte
+    uint8_t n;                  // Caracteres
+    uint16_t coluna;            // Próxima coluna a entrar pela direita
+    uint16_t colunas;           // Colunas de uma passada: o texto e a saída dele pela esquerda
+    bool repetir;               // No fim da passada, o texto volta a entrar pela direita
+    uint32_t passo_us;          // Intervalo entre dois passos (uma coluna por passo)
+    uint64_t proximo_us;        // Instante do próximo passo (TEXTO_SEM_QUADRO = terminou)
+    uint32_t mascara;           // Cena atual, nos bits físicos dos LEDs
+} texto_t;
+
+uint16_t textoGlifo(char c);           // Colunas do caractere; minúsculas viram maiúsculas e os que faltam, espaço
+uint32_t textoColunas(const char *texto); // Passos de uma passada (o texto entra, rola e sai)
+// Começa um letreiro com a matriz vazia; o primeiro passo é em 'agora' e os outros a cada 'passo_us'
+void textoIniciar(texto_t *t, const char *texto, uint32_t passo_us, bool repetir, uint64_t agora);
+// Dá os passos vencidos até 'agora' (vários, se o quadro atrasou); TRUE se a cena mudou
+bool textoAtualizar(texto_t *t, uint64_t agora);
+uint32_t textoMascara(const texto_t *t); // Cena atual, pronta para spriteDesenhar ou uma camada
+uint64_t textoProximo(const texto_t *t); // Instante do próximo passo, ou TEXTO_SEM_QUADRO
+
+#endif